@@ -17,7 +17,10 @@ ApplyPatchCliOperation::ApplyPatchCliOperation() :
 	m_nextResourcesBasePathsArgumentId( "--next-resources-base-path" ),
 	m_nextResourcesSourceTypeArgumentId( "--next-resources-source-type" ),
 	m_resourcesToPatchDestinationPathArgumentId( "--output-base-path" ),
-	m_resourcesToPatchDestinationTypeArgumentId( "--output-destination-type" )
+	m_resourcesToPatchDestinationTypeArgumentId( "--output-destination-type" ),
+	m_threadsArgumentId( "--threads" ),
+	m_applyDirectlyToDestinationArgumentId( "--direct-to-destination" ),
+	m_applyInPlaceArgumentId( "--in-place" )
 {
 	AddRequiredPositionalArgument( m_patchResourceGroupPathArgumentId, "The path to the PatchResourceGroup.yaml file." );
 
@@ -38,6 +41,12 @@ ApplyPatchCliOperation::ApplyPatchCliOperation() :
 	AddArgument( m_resourcesToPatchDestinationPathArgumentId, "The path in which to place the patched version of the files.", false, false, "ApplyPatchOut" );
 
 	AddArgument( m_resourcesToPatchDestinationTypeArgumentId, "The type of repository in which to place the patched version of the files.", false, false, DestinationTypeToString( defaultParams.resourcesToPatchDestinationSettings.destinationType ), ResourceDestinationTypeChoicesAsString() );
+
+	AddArgument( m_threadsArgumentId, "Number of threads used to patch resources, each thread patches a separate resource. 0 uses all available hardware threads.", false, false, std::to_string( defaultParams.threadCount ) );
+
+	AddArgumentFlag( m_applyDirectlyToDestinationArgumentId, "Write patched resources beside their destination and rename them into place, rather than copying them from a temporary file." );
+
+	AddArgumentFlag( m_applyInPlaceArgumentId, "Patch resources in place when their unchanged data keeps its offset, writing only changed ranges. A journal beside each resource rolls back a failed or interrupted apply." );
 }
 
 bool ApplyPatchCliOperation::Execute( std::string& returnErrorMessage ) const
@@ -127,6 +136,31 @@ bool ApplyPatchCliOperation::Execute( std::string& returnErrorMessage ) const
 
 	patchApplyParams.temporaryFilePath = "tempFile.resource";
 
+	try
+	{
+		unsigned long threadCount = std::stoul( m_argumentParser->get( m_threadsArgumentId ) );
+		if( threadCount > std::numeric_limits<unsigned int>::max() )
+		{
+			returnErrorMessage = "Invalid thread count";
+			return false;
+		}
+		patchApplyParams.threadCount = static_cast<unsigned int>( threadCount );
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid thread count";
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid thread count";
+		return false;
+	}
+
+	patchApplyParams.applyDirectlyToDestination = m_argumentParser->get<bool>( m_applyDirectlyToDestinationArgumentId );
+
+	patchApplyParams.applyInPlace = m_argumentParser->get<bool>( m_applyInPlaceArgumentId );
+
     if( ShowCliStatusUpdates() )
 	{
 		PrintStartBanner( importParamsPrevious, patchApplyParams );
@@ -152,6 +186,9 @@ void ApplyPatchCliOperation::PrintStartBanner( const CarbonResources::ResourceGr
 	std::cout << "Next Resources Source Type: " << SourceTypeToString( patchApplyParams.nextBuildResourcesSourceSettings.sourceType ) << std::endl;
 	std::cout << "Output Path Base Path: " << patchApplyParams.resourcesToPatchDestinationSettings.basePath << std::endl;
 	std::cout << "Output Path Destination Type: " << DestinationTypeToString( patchApplyParams.resourcesToPatchDestinationSettings.destinationType ) << std::endl;
+	std::cout << "Threads: " << patchApplyParams.threadCount << std::endl;
+	std::cout << "Apply Directly To Destination: " << ( patchApplyParams.applyDirectlyToDestination ? "Yes" : "No" ) << std::endl;
+	std::cout << "Apply In Place: " << ( patchApplyParams.applyInPlace ? "Yes" : "No" ) << std::endl;
 
 	std::cout << "----------------------------\n"
 			  << std::endl;
@@ -26,4 +26,7 @@ private:
 	std::string m_nextResourcesSourceTypeArgumentId;
 	std::string m_resourcesToPatchDestinationPathArgumentId;
 	std::string m_resourcesToPatchDestinationTypeArgumentId;
+	std::string m_threadsArgumentId;
+	std::string m_applyDirectlyToDestinationArgumentId;
+	std::string m_applyInPlaceArgumentId;
 };
@@ -271,6 +271,40 @@ bool CliOperation::StringToResourceDestinationType( const std::string& stringRep
 	return true;
 }
 
+bool CliOperation::StringToPreviousResourceGroupTrustPolicy( const std::string& stringRepresentation, CarbonResources::PreviousResourceGroupTrustPolicy& out ) const
+{
+	if( stringRepresentation == "SIZE_AND_MODIFICATION_TIME" )
+	{
+		out = CarbonResources::PreviousResourceGroupTrustPolicy::SIZE_AND_MODIFICATION_TIME;
+	}
+	else if( stringRepresentation == "SIZE" )
+	{
+		out = CarbonResources::PreviousResourceGroupTrustPolicy::SIZE;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+bool CliOperation::StringToPatchChunkingMode( const std::string& stringRepresentation, CarbonResources::PatchChunkingMode& out ) const
+{
+	if( stringRepresentation == "FIXED_SIZE" )
+	{
+		out = CarbonResources::PatchChunkingMode::FIXED_SIZE;
+	}
+	else if( stringRepresentation == "CONTENT_DEFINED" )
+	{
+		out = CarbonResources::PatchChunkingMode::CONTENT_DEFINED;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
 std::string CliOperation::PathListToString( std::vector<std::filesystem::path>& paths ) const
 {
 	std::stringstream ss;
@@ -343,6 +377,21 @@ std::string CliOperation::ResourceDestinationTypeChoicesAsString() const
 	return "LOCAL_RELATIVE, LOCAL_CDN, REMOTE_CDN";
 }
 
+std::string CliOperation::PreviousResourceGroupTrustPolicyChoicesAsString() const
+{
+	return "SIZE_AND_MODIFICATION_TIME, SIZE";
+}
+
+std::string CliOperation::ChecksumAlgorithmChoicesAsString() const
+{
+	return "MD5, BLAKE2B_128, XXH3_128";
+}
+
+std::string CliOperation::PatchChunkingModeChoicesAsString() const
+{
+	return "FIXED_SIZE, CONTENT_DEFINED";
+}
+
 std::string CliOperation::DestinationTypeToString( CarbonResources::ResourceDestinationType type ) const
 {
 	switch( type )
@@ -361,6 +410,36 @@ std::string CliOperation::DestinationTypeToString( CarbonResources::ResourceDest
 	}
 }
 
+std::string CliOperation::PreviousResourceGroupTrustPolicyToString( CarbonResources::PreviousResourceGroupTrustPolicy policy ) const
+{
+	switch( policy )
+	{
+	case CarbonResources::PreviousResourceGroupTrustPolicy::SIZE_AND_MODIFICATION_TIME:
+		return "SIZE_AND_MODIFICATION_TIME";
+
+	case CarbonResources::PreviousResourceGroupTrustPolicy::SIZE:
+		return "SIZE";
+
+	default:
+		return "Unrecognised trust policy";
+	}
+}
+
+std::string CliOperation::PatchChunkingModeToString( CarbonResources::PatchChunkingMode mode ) const
+{
+	switch( mode )
+	{
+	case CarbonResources::PatchChunkingMode::FIXED_SIZE:
+		return "FIXED_SIZE";
+
+	case CarbonResources::PatchChunkingMode::CONTENT_DEFINED:
+		return "CONTENT_DEFINED";
+
+	default:
+		return "Unrecognised chunking mode";
+	}
+}
+
 std::string PathsToString( const std::vector<std::filesystem::path>& v )
 {
 	std::string result;
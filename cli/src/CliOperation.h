@@ -15,6 +15,8 @@ namespace CarbonResources
 {
 enum class ResourceSourceType;
 enum class ResourceDestinationType;
+enum class PreviousResourceGroupTrustPolicy;
+enum class PatchChunkingMode;
 }
 
 namespace argparse
@@ -60,12 +62,20 @@ protected:
 
 	bool StringToResourceDestinationType( const std::string& stringRepresentation, CarbonResources::ResourceDestinationType& out ) const;
 
+	bool StringToPreviousResourceGroupTrustPolicy( const std::string& stringRepresentation, CarbonResources::PreviousResourceGroupTrustPolicy& out ) const;
+
+	bool StringToPatchChunkingMode( const std::string& stringRepresentation, CarbonResources::PatchChunkingMode& out ) const;
+
 	std::string PathListToString( std::vector<std::filesystem::path>& paths ) const;
 
 	std::string SourceTypeToString( CarbonResources::ResourceSourceType type ) const;
 
 	std::string DestinationTypeToString( CarbonResources::ResourceDestinationType type ) const;
 
+	std::string PreviousResourceGroupTrustPolicyToString( CarbonResources::PreviousResourceGroupTrustPolicy policy ) const;
+
+	std::string PatchChunkingModeToString( CarbonResources::PatchChunkingMode mode ) const;
+
 	std::string SizeToString( uintmax_t size ) const;
 
 	std::string SecondsToString( std::chrono::seconds seconds ) const;
@@ -76,6 +86,12 @@ protected:
 
 	std::string ResourceDestinationTypeChoicesAsString() const;
 
+	std::string PreviousResourceGroupTrustPolicyChoicesAsString() const;
+
+	std::string ChecksumAlgorithmChoicesAsString() const;
+
+	std::string PatchChunkingModeChoicesAsString() const;
+
 	bool ParseDocumentVersion( const std::string& version, CarbonResources::Version& documentVersion ) const;
 
     bool ShowCliStatusUpdates() const;
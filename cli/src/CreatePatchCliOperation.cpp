@@ -24,6 +24,17 @@ CreatePatchCliOperation::CreatePatchCliOperation() :
 	m_maxInputChunkSizeArgumentId( "--chunk-size" ),
 	m_downloadRetrySecondsArgumentId( "--download-retry" ),
 	m_indexFolderArgumentId( "--index-folder" ),
+	m_indexMemoryBudgetArgumentId( "--index-memory-budget" ),
+	m_indexThreadsArgumentId( "--index-threads" ),
+	m_indexCacheSizeArgumentId( "--index-cache-size" ),
+	m_indexFilterFalsePositiveRateArgumentId( "--index-filter-false-positive-rate" ),
+	m_chunkingModeArgumentId( "--chunking-mode" ),
+	m_contentDefinedChunkMinimumSizeArgumentId( "--content-defined-chunk-min-size" ),
+	m_contentDefinedChunkAverageSizeArgumentId( "--content-defined-chunk-avg-size" ),
+	m_contentDefinedChunkMaximumSizeArgumentId( "--content-defined-chunk-max-size" ),
+	m_threadsArgumentId( "--threads" ),
+	m_pendingPatchMemoryBudgetArgumentId( "--pending-patch-memory-budget" ),
+	m_diffThreadsArgumentId( "--diff-threads" ),
 	m_skipCompressionCalculation( "--skip-compression" )
 {
 
@@ -64,6 +75,28 @@ CreatePatchCliOperation::CreatePatchCliOperation() :
 
 	AddArgument( m_indexFolderArgumentId, "The folder in which to place indexes generated for patch files.", false, false, defaultParams.indexFolder.string() );
 
+	AddArgument( m_indexMemoryBudgetArgumentId, "Maximum memory in bytes used to hold a patch file index in memory. Larger indexes are written to the index folder, 0 always writes to the index folder.", false, false, SizeToString( defaultParams.chunkIndexMemoryBudget ) );
+
+	AddArgument( m_indexThreadsArgumentId, "Number of threads used to generate the index of each previous file. 0 uses all available hardware threads.", false, false, std::to_string( defaultParams.chunkIndexThreadCount ) );
+
+	AddArgument( m_indexCacheSizeArgumentId, "Maximum size in bytes of the persistent index cache in the index folder, indexes of previous files are reused across runs. 0 disables the cache.", false, false, SizeToString( defaultParams.chunkIndexCacheSize ) );
+
+	AddArgument( m_indexFilterFalsePositiveRateArgumentId, "Rate at which the index filter lets through windows of a previous file that match no chunk of the next file. Lower rates use more memory for the filter.", false, false, std::to_string( defaultParams.chunkIndexFilterFalsePositiveRate ) );
+
+	AddArgument( m_chunkingModeArgumentId, "How files are divided into chunks when searching previous files for matching data. FIXED_SIZE searches for chunks of --chunk-size at every offset using an index, CONTENT_DEFINED divides both files at content defined boundaries and matches chunks by checksum.", false, false, PatchChunkingModeToString( defaultParams.chunkingMode ), PatchChunkingModeChoicesAsString() );
+
+	AddArgument( m_contentDefinedChunkMinimumSizeArgumentId, "Minimum chunk size in bytes when using CONTENT_DEFINED chunking.", false, false, SizeToString( defaultParams.contentDefinedChunkMinimumSize ) );
+
+	AddArgument( m_contentDefinedChunkAverageSizeArgumentId, "Expected chunk size in bytes when using CONTENT_DEFINED chunking, rounded down to a power of two.", false, false, SizeToString( defaultParams.contentDefinedChunkAverageSize ) );
+
+	AddArgument( m_contentDefinedChunkMaximumSizeArgumentId, "Maximum chunk size in bytes when using CONTENT_DEFINED chunking.", false, false, SizeToString( defaultParams.contentDefinedChunkMaximumSize ) );
+
+	AddArgument( m_threadsArgumentId, "Number of threads used to create patches, each thread creates the patches of a separate resource. 0 uses all available hardware threads.", false, false, std::to_string( defaultParams.threadCount ) );
+
+	AddArgument( m_pendingPatchMemoryBudgetArgumentId, "Maximum memory in bytes used to hold patches created by threads ahead of the resource being written when using more than one thread. Threads wait once it is exceeded.", false, false, SizeToString( defaultParams.pendingPatchDataMemoryBudget ) );
+
+	AddArgument( m_diffThreadsArgumentId, "Number of threads used to create the diffs of each resource, diffs are created while later chunks of the resource are matched. 0 uses all available hardware threads.", false, false, std::to_string( defaultParams.diffThreadCount ) );
+
     AddArgumentFlag( m_skipCompressionCalculation, "Set skip compression calculations on patches." );
 }
 
@@ -180,6 +213,177 @@ bool CreatePatchCliOperation::Execute( std::string& returnErrorMessage ) const
 
 	createPatchParams.indexFolder = m_argumentParser->get( m_indexFolderArgumentId );
 
+	try
+	{
+		createPatchParams.chunkIndexMemoryBudget = std::stoull( m_argumentParser->get( m_indexMemoryBudgetArgumentId ) );
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid index memory budget";
+
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid index memory budget";
+
+		return false;
+	}
+
+	try
+	{
+		unsigned long threadCount = std::stoul( m_argumentParser->get( m_indexThreadsArgumentId ) );
+		if( threadCount > std::numeric_limits<unsigned int>::max() )
+		{
+			returnErrorMessage = "Invalid index thread count";
+			return false;
+		}
+		createPatchParams.chunkIndexThreadCount = static_cast<unsigned int>( threadCount );
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid index thread count";
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid index thread count";
+		return false;
+	}
+
+	try
+	{
+		createPatchParams.chunkIndexCacheSize = std::stoull( m_argumentParser->get( m_indexCacheSizeArgumentId ) );
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid index cache size";
+
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid index cache size";
+
+		return false;
+	}
+
+	try
+	{
+		double falsePositiveRate = std::stod( m_argumentParser->get( m_indexFilterFalsePositiveRateArgumentId ) );
+		if( !( falsePositiveRate > 0.0 && falsePositiveRate < 1.0 ) )
+		{
+			returnErrorMessage = "Invalid index filter false positive rate";
+			return false;
+		}
+		createPatchParams.chunkIndexFilterFalsePositiveRate = falsePositiveRate;
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid index filter false positive rate";
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid index filter false positive rate";
+		return false;
+	}
+
+	try
+	{
+		unsigned long threadCount = std::stoul( m_argumentParser->get( m_threadsArgumentId ) );
+		if( threadCount > std::numeric_limits<unsigned int>::max() )
+		{
+			returnErrorMessage = "Invalid thread count";
+			return false;
+		}
+		createPatchParams.threadCount = static_cast<unsigned int>( threadCount );
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid thread count";
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid thread count";
+		return false;
+	}
+
+	try
+	{
+		createPatchParams.pendingPatchDataMemoryBudget = std::stoull( m_argumentParser->get( m_pendingPatchMemoryBudgetArgumentId ) );
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid pending patch memory budget";
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid pending patch memory budget";
+		return false;
+	}
+
+	try
+	{
+		unsigned long diffThreadCount = std::stoul( m_argumentParser->get( m_diffThreadsArgumentId ) );
+		if( diffThreadCount > std::numeric_limits<unsigned int>::max() )
+		{
+			returnErrorMessage = "Invalid diff thread count";
+			return false;
+		}
+		createPatchParams.diffThreadCount = static_cast<unsigned int>( diffThreadCount );
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid diff thread count";
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid diff thread count";
+		return false;
+	}
+
+	std::string chunkingMode = m_argumentParser->get( m_chunkingModeArgumentId );
+	if( !StringToPatchChunkingMode( chunkingMode, createPatchParams.chunkingMode ) )
+	{
+		returnErrorMessage = "Invalid chunking mode";
+		return false;
+	}
+
+	auto parseContentDefinedChunkSize = [this, &returnErrorMessage]( const std::string& argumentId, uint32_t& size ) {
+		try
+		{
+			unsigned long in = std::stoul( m_argumentParser->get( argumentId ) );
+			if( in > std::numeric_limits<uint32_t>::max() )
+			{
+				returnErrorMessage = "Invalid content defined chunk size";
+				return false;
+			}
+			size = static_cast<uint32_t>( in );
+		}
+		catch( std::invalid_argument& )
+		{
+			returnErrorMessage = "Invalid content defined chunk size";
+			return false;
+		}
+		catch( std::out_of_range& )
+		{
+			returnErrorMessage = "Invalid content defined chunk size";
+			return false;
+		}
+		return true;
+	};
+
+	if( !parseContentDefinedChunkSize( m_contentDefinedChunkMinimumSizeArgumentId, createPatchParams.contentDefinedChunkMinimumSize ) ||
+		!parseContentDefinedChunkSize( m_contentDefinedChunkAverageSizeArgumentId, createPatchParams.contentDefinedChunkAverageSize ) ||
+		!parseContentDefinedChunkSize( m_contentDefinedChunkMaximumSizeArgumentId, createPatchParams.contentDefinedChunkMaximumSize ) )
+	{
+		return false;
+	}
+
     bool skipCompressionCalculation = m_argumentParser->get<bool>( m_skipCompressionCalculation );
 
     if (skipCompressionCalculation && createPatchParams.resourcePatchBinaryDestinationSettings.destinationType == CarbonResources::ResourceDestinationType::REMOTE_CDN)
@@ -243,6 +447,27 @@ void CreatePatchCliOperation::PrintStartBanner( const CarbonResources::ResourceG
 
 	std::cout << "Index File Folder: " << createPatchParams.indexFolder << std::endl;
 
+	std::cout << "Index Memory Budget: " << createPatchParams.chunkIndexMemoryBudget << " Bytes" << std::endl;
+
+	std::cout << "Threads: " << createPatchParams.threadCount << std::endl;
+
+	std::cout << "Pending Patch Memory Budget: " << createPatchParams.pendingPatchDataMemoryBudget << " Bytes" << std::endl;
+
+	std::cout << "Diff Threads: " << createPatchParams.diffThreadCount << std::endl;
+
+	std::cout << "Index Threads: " << createPatchParams.chunkIndexThreadCount << std::endl;
+
+	std::cout << "Index Cache Size: " << createPatchParams.chunkIndexCacheSize << " Bytes" << std::endl;
+
+	std::cout << "Index Filter False Positive Rate: " << createPatchParams.chunkIndexFilterFalsePositiveRate << std::endl;
+
+	std::cout << "Chunking Mode: " << PatchChunkingModeToString( createPatchParams.chunkingMode ) << std::endl;
+
+	if( createPatchParams.chunkingMode == CarbonResources::PatchChunkingMode::CONTENT_DEFINED )
+	{
+		std::cout << "Content Defined Chunk Sizes: " << createPatchParams.contentDefinedChunkMinimumSize << " Min, " << createPatchParams.contentDefinedChunkAverageSize << " Avg, " << createPatchParams.contentDefinedChunkMaximumSize << " Max Bytes" << std::endl;
+	}
+
     if( createPatchParams.calculateCompressions )
 	{
 		std::cout << "Calculate Compression: Off" << std::endl;
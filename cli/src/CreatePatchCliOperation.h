@@ -56,6 +56,28 @@ private:
 
 	std::string m_indexFolderArgumentId;
 
+	std::string m_indexMemoryBudgetArgumentId;
+
+	std::string m_indexThreadsArgumentId;
+
+	std::string m_indexCacheSizeArgumentId;
+
+	std::string m_indexFilterFalsePositiveRateArgumentId;
+
+	std::string m_chunkingModeArgumentId;
+
+	std::string m_contentDefinedChunkMinimumSizeArgumentId;
+
+	std::string m_contentDefinedChunkAverageSizeArgumentId;
+
+	std::string m_contentDefinedChunkMaximumSizeArgumentId;
+
+	std::string m_threadsArgumentId;
+
+	std::string m_pendingPatchMemoryBudgetArgumentId;
+
+	std::string m_diffThreadsArgumentId;
+
     std::string m_skipCompressionCalculation;
 };
 
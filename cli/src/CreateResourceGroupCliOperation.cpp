@@ -2,6 +2,7 @@
 
 #include "CreateResourceGroupCliOperation.h"
 
+#include <chrono>
 #include <string>
 #include <argparse/argparse.hpp>
 #include <ResourceGroup.h>
@@ -15,7 +16,13 @@ CreateResourceGroupCliOperation::CreateResourceGroupCliOperation() :
 	m_createResourceGroupSkipCompressionCalculationId( "--skip-compression" ),
 	m_createResourceGroupExportResourcesId( "--export-resources" ),
 	m_createResourceGroupExportResourcesDestinationTypeId( "--export-resources-destination-type" ),
-	m_createResourceGroupExportResourcesDestinationPathId( "--export-resources-destination-path" )
+	m_createResourceGroupExportResourcesDestinationPathId( "--export-resources-destination-path" ),
+	m_createResourceGroupThreadsId( "--threads" ),
+	m_createResourceGroupFingerprintCacheId( "--fingerprint-cache" ),
+	m_createResourceGroupPreviousResourceGroupId( "--previous-resourcegroup" ),
+	m_createResourceGroupPreviousResourceGroupTrustPolicyId( "--previous-resourcegroup-trust" ),
+	m_createResourceGroupPreviousResourceGroupCreatedId( "--previous-resourcegroup-created" ),
+	m_createResourceGroupChecksumAlgorithmId( "--checksum-algorithm" )
 {
 
 	AddRequiredPositionalArgument( m_createResourceGroupPathArgumentId, "Base directory to create resource group from." );
@@ -40,6 +47,22 @@ CreateResourceGroupCliOperation::CreateResourceGroupCliOperation() :
     AddArgument( m_createResourceGroupExportResourcesDestinationTypeId, "Represents the type of repository where exported resources will be saved. Requires --export-resources", false, false, DestinationTypeToString( defaultImportParams.exportResourcesDestinationSettings.destinationType ), ResourceDestinationTypeChoicesAsString() );
 
 	AddArgument( m_createResourceGroupExportResourcesDestinationPathId, "Represents the base path where the exported resources will be saved. Requires --export-resources", false, false, defaultImportParams.exportResourcesDestinationSettings.basePath.string() );
+
+	AddArgument( m_createResourceGroupThreadsId, "Number of threads used to process files. 0 uses all available hardware threads.", false, false, std::to_string( defaultImportParams.threadCount ) );
+
+	AddArgument( m_createResourceGroupFingerprintCacheId, "Optional path to a file fingerprint cache. Files unchanged since the cache was written are not re-read. The cache is created or updated on completion.", false, false, defaultImportParams.fileFingerprintCachePath.string() );
+
+	AddArgument( m_createResourceGroupPreviousResourceGroupId, "Optional path to a ResourceGroup previously created from the same directory. Files trusted to be unchanged are not re-read. see --previous-resourcegroup-trust", false, false, "" );
+
+	AddArgument( m_createResourceGroupPreviousResourceGroupTrustPolicyId, "Determines when a file is trusted to be unchanged from the previous ResourceGroup. SIZE_AND_MODIFICATION_TIME requires a matching size and the file being last modified before --previous-resourcegroup-created. Requires --previous-resourcegroup", false, false, PreviousResourceGroupTrustPolicyToString( defaultImportParams.previousResourceGroupTrustPolicy ), PreviousResourceGroupTrustPolicyChoicesAsString() );
+
+	AddArgument( m_createResourceGroupPreviousResourceGroupCreatedId, "Time creation of the previous ResourceGroup started, in seconds since the Unix epoch. Record it before running create-group as the modification time of the ResourceGroup file changes when it is copied. Required with --previous-resourcegroup when using SIZE_AND_MODIFICATION_TIME", false, false, "" );
+
+	std::string defaultChecksumAlgorithm;
+
+	CarbonResources::ChecksumAlgorithmToString( defaultImportParams.checksumAlgorithm, defaultChecksumAlgorithm );
+
+	AddArgument( m_createResourceGroupChecksumAlgorithmId, "Algorithm used to generate resource checksums. Algorithms other than MD5 require --document-version 1.0.0 or greater.", false, false, defaultChecksumAlgorithm, ChecksumAlgorithmChoicesAsString() );
 }
 
 bool CreateResourceGroupCliOperation::Execute( std::string& returnErrorMessage ) const
@@ -79,6 +102,81 @@ bool CreateResourceGroupCliOperation::Execute( std::string& returnErrorMessage )
 		createResourceGroupParams.exportResourcesDestinationSettings.basePath = m_argumentParser->get<std::string>( m_createResourceGroupExportResourcesDestinationPathId );
 	}
 
+	try
+	{
+		unsigned long threadCount = std::stoul( m_argumentParser->get( m_createResourceGroupThreadsId ) );
+		if( threadCount > std::numeric_limits<unsigned int>::max() )
+		{
+			returnErrorMessage = "Invalid thread count";
+			return false;
+		}
+		createResourceGroupParams.threadCount = static_cast<unsigned int>( threadCount );
+	}
+	catch( std::invalid_argument& )
+	{
+		returnErrorMessage = "Invalid thread count";
+		return false;
+	}
+	catch( std::out_of_range& )
+	{
+		returnErrorMessage = "Invalid thread count";
+		return false;
+	}
+
+	createResourceGroupParams.fileFingerprintCachePath = m_argumentParser->get<std::string>( m_createResourceGroupFingerprintCacheId );
+
+	std::filesystem::path previousResourceGroupPath = m_argumentParser->get<std::string>( m_createResourceGroupPreviousResourceGroupId );
+
+	if( !previousResourceGroupPath.empty() )
+	{
+		std::string previousResourceGroupTrustPolicy = m_argumentParser->get<std::string>( m_createResourceGroupPreviousResourceGroupTrustPolicyId );
+
+		if( !StringToPreviousResourceGroupTrustPolicy( previousResourceGroupTrustPolicy, createResourceGroupParams.previousResourceGroupTrustPolicy ) )
+		{
+			returnErrorMessage = "Invalid previous resource group trust policy";
+
+			return false;
+		}
+
+		if( createResourceGroupParams.previousResourceGroupTrustPolicy == CarbonResources::PreviousResourceGroupTrustPolicy::SIZE_AND_MODIFICATION_TIME )
+		{
+			std::string previousResourceGroupCreatedString = m_argumentParser->get( m_createResourceGroupPreviousResourceGroupCreatedId );
+
+			if( previousResourceGroupCreatedString.empty() )
+			{
+				returnErrorMessage = "Previous resource group creation time is required with trust policy SIZE_AND_MODIFICATION_TIME";
+
+				return false;
+			}
+
+			try
+			{
+				long long previousResourceGroupCreated = std::stoll( previousResourceGroupCreatedString );
+
+				// Converted through the current time of both clocks as file clock conversions are not available on all platforms
+				std::chrono::system_clock::time_point previousResourceGroupCreatedTime{ std::chrono::seconds( previousResourceGroupCreated ) };
+
+				createResourceGroupParams.previousResourceGroupTimestamp = std::filesystem::file_time_type::clock::now() - std::chrono::duration_cast<std::filesystem::file_time_type::duration>( std::chrono::system_clock::now() - previousResourceGroupCreatedTime );
+			}
+			catch( std::invalid_argument& )
+			{
+				returnErrorMessage = "Invalid previous resource group creation time";
+				return false;
+			}
+			catch( std::out_of_range& )
+			{
+				returnErrorMessage = "Invalid previous resource group creation time";
+				return false;
+			}
+		}
+	}
+
+	if( !CarbonResources::StringToChecksumAlgorithm( m_argumentParser->get<std::string>( m_createResourceGroupChecksumAlgorithmId ), createResourceGroupParams.checksumAlgorithm ) )
+	{
+		returnErrorMessage = "Invalid checksum algorithm";
+
+		return false;
+	}
 
     exportParams.filename = m_argumentParser->get<std::string>( m_createResourceGroupOutputFileArgumentId );
 
@@ -86,13 +184,13 @@ bool CreateResourceGroupCliOperation::Execute( std::string& returnErrorMessage )
 
     if (ShowCliStatusUpdates())
     {
-		PrintStartBanner( createResourceGroupParams, exportParams );
+		PrintStartBanner( createResourceGroupParams, exportParams, previousResourceGroupPath );
     }
 
-	return CreateResourceGroup( createResourceGroupParams, exportParams );
+	return CreateResourceGroup( createResourceGroupParams, exportParams, previousResourceGroupPath );
 }
 
-void CreateResourceGroupCliOperation::PrintStartBanner( CarbonResources::CreateResourceGroupFromDirectoryParams& createResourceGroupFromDirectoryParams, CarbonResources::ResourceGroupExportToFileParams& ResourceGroupExportToFileParams ) const
+void CreateResourceGroupCliOperation::PrintStartBanner( CarbonResources::CreateResourceGroupFromDirectoryParams& createResourceGroupFromDirectoryParams, CarbonResources::ResourceGroupExportToFileParams& ResourceGroupExportToFileParams, const std::filesystem::path& previousResourceGroupPath ) const
 {
 	std::cout << "---Creating Resource Group---" << std::endl;
 
@@ -128,14 +226,70 @@ void CreateResourceGroupCliOperation::PrintStartBanner( CarbonResources::CreateR
 		std::cout << "Export Resources: Off" << std::endl;
 	}
 
+	std::cout << "Threads: " << createResourceGroupFromDirectoryParams.threadCount << std::endl;
+
+	std::string checksumAlgorithm;
+
+	CarbonResources::ChecksumAlgorithmToString( createResourceGroupFromDirectoryParams.checksumAlgorithm, checksumAlgorithm );
+
+	std::cout << "Checksum Algorithm: " << checksumAlgorithm << std::endl;
+
+	if( !createResourceGroupFromDirectoryParams.fileFingerprintCachePath.empty() )
+	{
+		std::cout << "File Fingerprint Cache: " << createResourceGroupFromDirectoryParams.fileFingerprintCachePath << std::endl;
+	}
+	else
+	{
+		std::cout << "File Fingerprint Cache: Off" << std::endl;
+	}
+
+	if( !previousResourceGroupPath.empty() )
+	{
+		std::cout << "Previous Resource Group: " << previousResourceGroupPath << std::endl;
+
+		std::cout << "Previous Resource Group Trust Policy: " << PreviousResourceGroupTrustPolicyToString( createResourceGroupFromDirectoryParams.previousResourceGroupTrustPolicy ) << std::endl;
+	}
+	else
+	{
+		std::cout << "Previous Resource Group: Off" << std::endl;
+	}
+
 	std::cout << "----------------------------\n"
 			  << std::endl;
 }
 
-bool CreateResourceGroupCliOperation::CreateResourceGroup( CarbonResources::CreateResourceGroupFromDirectoryParams& createResourceGroupFromDirectoryParams, CarbonResources::ResourceGroupExportToFileParams& ResourceGroupExportToFileParams ) const
+bool CreateResourceGroupCliOperation::CreateResourceGroup( CarbonResources::CreateResourceGroupFromDirectoryParams& createResourceGroupFromDirectoryParams, CarbonResources::ResourceGroupExportToFileParams& ResourceGroupExportToFileParams, const std::filesystem::path& previousResourceGroupPath ) const
 {
 	CarbonResources::ResourceGroup resourceGroup;
 
+	CarbonResources::ResourceGroup previousResourceGroup;
+
+	if( !previousResourceGroupPath.empty() )
+	{
+		if( ShowCliStatusUpdates() )
+		{
+			CliStatusUpdate( "Importing previous resource group." );
+		}
+
+		CarbonResources::ResourceGroupImportFromFileParams previousResourceGroupParams;
+
+		previousResourceGroupParams.filename = previousResourceGroupPath;
+
+		previousResourceGroupParams.callbackSettings.statusCallback = GetStatusCallback();
+		previousResourceGroupParams.callbackSettings.verbosityLevel = GetVerbosityLevel();
+
+		CarbonResources::Result importPreviousResult = previousResourceGroup.ImportFromFile( previousResourceGroupParams );
+
+		if( importPreviousResult.type != CarbonResources::ResultType::SUCCESS )
+		{
+			PrintCarbonResourcesError( importPreviousResult );
+
+			return false;
+		}
+
+		createResourceGroupFromDirectoryParams.previousResourceGroup = &previousResourceGroup;
+	}
+
 	createResourceGroupFromDirectoryParams.callbackSettings.statusCallback = GetStatusCallback();
 	createResourceGroupFromDirectoryParams.callbackSettings.verbosityLevel = GetVerbosityLevel();
 
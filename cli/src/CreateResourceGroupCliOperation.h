@@ -18,9 +18,9 @@ public:
 	virtual bool Execute( std::string& returnErrorMessage ) const final;
 
 private:
-	void PrintStartBanner( CarbonResources::CreateResourceGroupFromDirectoryParams& createResourceGroupFromDirectoryParams, CarbonResources::ResourceGroupExportToFileParams& ResourceGroupExportToFileParams ) const;
+	void PrintStartBanner( CarbonResources::CreateResourceGroupFromDirectoryParams& createResourceGroupFromDirectoryParams, CarbonResources::ResourceGroupExportToFileParams& ResourceGroupExportToFileParams, const std::filesystem::path& previousResourceGroupPath ) const;
 
-    bool CreateResourceGroup( CarbonResources::CreateResourceGroupFromDirectoryParams& createResourceGroupFromDirectoryParams, CarbonResources::ResourceGroupExportToFileParams& ResourceGroupExportToFileParams ) const;
+    bool CreateResourceGroup( CarbonResources::CreateResourceGroupFromDirectoryParams& createResourceGroupFromDirectoryParams, CarbonResources::ResourceGroupExportToFileParams& ResourceGroupExportToFileParams, const std::filesystem::path& previousResourceGroupPath ) const;
 
 private:
 	std::string m_createResourceGroupPathArgumentId;
@@ -38,6 +38,18 @@ private:
     std::string m_createResourceGroupExportResourcesDestinationTypeId;
 		
     std::string m_createResourceGroupExportResourcesDestinationPathId;
+
+    std::string m_createResourceGroupThreadsId;
+
+    std::string m_createResourceGroupFingerprintCacheId;
+
+    std::string m_createResourceGroupPreviousResourceGroupId;
+
+    std::string m_createResourceGroupPreviousResourceGroupTrustPolicyId;
+
+    std::string m_createResourceGroupPreviousResourceGroupCreatedId;
+
+    std::string m_createResourceGroupChecksumAlgorithmId;
 };
 
 #endif // CreateResourceGroupCliOperation_H
\ No newline at end of file
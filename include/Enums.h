@@ -124,6 +124,12 @@ using StatusCallback = std::function<void( StatusProgressType statusProgressType
     * Required resource not found
     * @var REQUIRED_INPUT_PARAMETER_NOT_SET
     * A required input parameter was not set
+    * @var CHECKSUM_ALGORITHM_UNSUPPORTED_BY_DOCUMENT_VERSION
+    * The checksum algorithm cannot be represented in the requested document version. Only MD5 is supported before document version 1.0.0.
+    * @var CHECKSUM_ALGORITHM_MISMATCH
+    * ResourceGroups supplied to the operation use different checksum algorithms.
+    * @var FAILED_TO_ROLL_BACK_PATCH
+    * A resource patched in place could not be restored after an interrupted or failed apply. Its rollback journal is kept so restoring can be retried by applying again.
     */
 enum class ResultType
 {
@@ -164,6 +170,9 @@ enum class ResultType
 	RESOURCE_LIST_NOT_SET,
 	RESOURCE_NOT_FOUND,
 	REQUIRED_INPUT_PARAMETER_NOT_SET,
+	CHECKSUM_ALGORITHM_UNSUPPORTED_BY_DOCUMENT_VERSION,
+	CHECKSUM_ALGORITHM_MISMATCH,
+	FAILED_TO_ROLL_BACK_PATCH,
 	//NOTE: if adding to this enum, a complimentary entry must be added to resultToString.
 };
 
@@ -221,6 +230,63 @@ enum class ResourceDestinationType
 	//Note: If altering this enum, ensure that Enums::resourceDestinationTypeChoicesAsString reflects update.
 };
 
+/** @enum PreviousResourceGroupTrustPolicy
+    *  @brief Determines when a Resource from a previous ResourceGroup is trusted in place of processing a file.
+    *  @var PreviousResourceGroupTrustPolicy::SIZE_AND_MODIFICATION_TIME
+    *  File size must match the previous Resource and the file must have been last modified before creation of the previous ResourceGroup started.
+    *  @var PreviousResourceGroupTrustPolicy::SIZE
+    *  File size must match the previous Resource. Only use where files are known not to change without a change in size.
+    */
+enum class PreviousResourceGroupTrustPolicy
+{
+	SIZE_AND_MODIFICATION_TIME,
+	SIZE,
+};
+
+/** @enum PatchChunkingMode
+    *  @brief Determines how resources are divided into chunks when searching previous resources for matching data during patch creation.
+    *  @var PatchChunkingMode::FIXED_SIZE
+    *  Resources are divided into chunks of PatchCreateParams::maxInputFileChunkSize which are searched for at every offset of the previous resource using a rolling checksum index.
+    *  @var PatchChunkingMode::CONTENT_DEFINED
+    *  Both versions of a resource are divided at boundaries determined by their content and chunks are matched by checksum, no index is generated. An insertion or removal only changes the chunks around it.
+    */
+enum class PatchChunkingMode
+{
+	FIXED_SIZE,
+	CONTENT_DEFINED,
+	//Note: If altering this enum, ensure that CliOperation::PatchChunkingModeChoicesAsString reflects update.
+};
+
+/** @enum ChecksumAlgorithm
+    *  @brief Algorithm used to generate Resource data checksums within a ResourceGroup.
+    *  @var ChecksumAlgorithm::MD5
+    *  MD5 checksum. Supported by all document versions.
+    *  @var ChecksumAlgorithm::BLAKE2B_128
+    *  BLAKE2b checksum with a 128 bit digest. Somewhat faster than MD5 on 64 bit hardware, requires document version 1.0.0 or greater.
+    *  @var ChecksumAlgorithm::XXH3_128
+    *  XXH3 checksum with a 128 bit digest. Around ten times faster than MD5, requires document version 1.0.0 or greater.
+    *  Not a cryptographic hash, detects changed or corrupted data but not data crafted to collide.
+    */
+enum class ChecksumAlgorithm
+{
+	MD5,
+	BLAKE2B_128,
+	XXH3_128,
+	//Note: If altering this enum, ensure that ChecksumAlgorithmToString, StringToChecksumAlgorithm and CliOperation::ChecksumAlgorithmChoicesAsString reflect update.
+};
+
+/** Converts ChecksumAlgorithm to string
+    * @param checksumAlgorithm Checksum algorithm to be converted.
+    * @param output Output to string conversion.
+    */
+bool API ChecksumAlgorithmToString( ChecksumAlgorithm checksumAlgorithm, std::string& output );
+
+/** Converts string to ChecksumAlgorithm
+    * @param input String representation of checksum algorithm, as produced by ChecksumAlgorithmToString.
+    * @param checksumAlgorithm Output of string conversion.
+    */
+bool API StringToChecksumAlgorithm( const std::string& input, ChecksumAlgorithm& checksumAlgorithm );
+
 /** @struct Version
     *  @brief Represents Version information. Version follows semantic versioning paradigm.
     *  @var Version::major
@@ -239,11 +305,16 @@ struct Version
 
 static const Version S_LIBRARY_VERSION = { VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH }; /*!< Current version of the resources */
 
-static const Version S_DOCUMENT_VERSION = { 0, 1, 0 }; /*!< Maximum document version supported by resources */
+static const Version S_DOCUMENT_VERSION = { 0, 1, 0 }; /*!< Default document version output by resources */
+
+static const Version S_MAX_DOCUMENT_VERSION = { 1, 0, 0 }; /*!< Maximum document version supported by resources */
+
+static const Version S_CHECKSUM_ALGORITHM_DOCUMENT_VERSION = { 1, 0, 0 }; /*!< Minimum document version able to record a checksum algorithm other than MD5 */
 
 static const std::vector S_VALID_DOCUMENT_VERSIONS = {
 	Version{ 0, 0, 0 },
-	Version{ 0, 1, 0 }
+	Version{ 0, 1, 0 },
+	Version{ 1, 0, 0 }
 }; /*!< List of valid document version supported by resources */
 
 }
@@ -26,6 +26,17 @@ namespace CarbonResources
     *  Location where to place patched resources. This can match PatchApplyParams::resourcesToPatchSourceSettings to overwrite. Allows creation of staging area in case of failure.
     *  @var PatchApplyParams::temporaryFilePath
     *  Name of a temporary filename to use when patching large files. This file will be cleaned up on process completion. 
+    *  @var PatchApplyParams::applyDirectlyToDestination
+    *  If true each patched resource is written to a temporary file beside its destination and renamed over it once its checksum is verified, rather than being written to PatchApplyParams::temporaryFilePath and copied.
+    *  Halves the data written per resource. Only applies to LOCAL_RELATIVE and LOCAL_CDN destinations, other destinations are copied as before.
+    *  @var PatchApplyParams::applyInPlace
+    *  If true a resource read from its own destination is patched in place when each of its unchanged regions keeps its offset, such as a resource that only grows or changes near its end.
+    *  Only the changed ranges are written and the resource is truncated or extended to its new size. Their original contents are first saved to a journal beside the resource, which is used to roll back
+    *  a failed apply and, if the apply was interrupted, the next time the resource is applied in place. Resources that cannot be patched in place are rebuilt in full as usual. A status update reports each patched resource as patched in place or, with the reason, as rebuilt, also when patching on several threads. Takes precedence over PatchApplyParams::applyDirectlyToDestination.
+    *  @var PatchApplyParams::threadCount
+    *  Number of worker threads used to patch resources, each worker patches a separate resource. 1 patches on the calling thread, 0 uses the number of hardware threads available.
+    *  Each worker writes to its own temporary file, named after PatchApplyParams::temporaryFilePath with the worker index appended. Resources are streamed in chunks of the patch's maximum input chunk size,
+    *  so memory use grows with the number of workers rather than resource size. Progress is reported in resource order regardless of thread count.
     *  @var PatchApplyParams::CallbackSettings
     *  Settings relating to status callback messaging
     */
@@ -41,6 +52,12 @@ struct PatchApplyParams final
 
 	std::filesystem::path temporaryFilePath = "tempFile.resource";
 
+	bool applyDirectlyToDestination = false;
+
+	bool applyInPlace = false;
+
+	unsigned int threadCount = 1;
+
 	CallbackSettings callbackSettings;
 };
 
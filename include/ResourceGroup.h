@@ -125,6 +125,7 @@ struct BundleCreateParams
     *  Where resources for the current ResourceGroup build will be sourced.
     *  @var PatchCreateParams::resourcePatchBinaryDestinationSettings
     *  Where the produced binary patches will be saved.
+    *  Patches with identical data share a single stored binary unless the destination is ResourceDestinationType::LOCAL_RELATIVE.
     *  @var PatchCreateParams::resourcePatchResourceGroupDestinationSettings
     *  Where the produced PatchResourceGroup will be saved.
     *  @var PatchCreateParams::CallbackSettings
@@ -133,6 +134,38 @@ struct BundleCreateParams
     *  Delay before a failed download is retried (seconds)
     *  @var PatchCreateParams::indexFolder
     *  Directory to store index calculation files during patch creation.
+    *  @var PatchCreateParams::chunkIndexMemoryBudget
+    *  Maximum memory in bytes used to hold the chunk index of a previous file in memory. Index files are written to PatchCreateParams::indexFolder when the index exceeds this budget. Set to 0 to always write index files.
+    *  @var PatchCreateParams::chunkIndexThreadCount
+    *  Number of worker threads used to generate the chunk index of a previous file, each worker indexes a separate segment of the file. 0 uses the number of hardware threads available.
+    *  The produced patches are the same regardless of thread count.
+    *  @var PatchCreateParams::chunkIndexCacheSize
+    *  Maximum size in bytes of the persistent chunk index cache stored in PatchCreateParams::indexFolder, 0 disables the cache.
+    *  Indexes are keyed by the checksum of the previous resource and PatchCreateParams::maxInputFileChunkSize and are reused by later patch creation runs, least recently used indexes are removed once the cache exceeds this size.
+    *  Cached indexes are unfiltered so they can be reused for any next build, this takes more space than the per patch index but can find matches the per patch index misses.
+    *  @var PatchCreateParams::chunkIndexFilterFalsePositiveRate
+    *  Rate at which the chunk index filter lets through windows of a previous file that match no chunk of the next file, must be between 0 and 1.
+    *  Windows let through are indexed but never matched, a lower rate indexes fewer of them at the cost of a larger filter.
+    *  @var PatchCreateParams::chunkingMode
+    *  How resources are divided into chunks when searching the previous resource for matching data. See PatchChunkingMode for more details.
+    *  @var PatchCreateParams::contentDefinedChunkMinimumSize
+    *  Minimum size in bytes of a chunk when PatchCreateParams::chunkingMode is PatchChunkingMode::CONTENT_DEFINED, must be greater than 0.
+    *  @var PatchCreateParams::contentDefinedChunkAverageSize
+    *  Expected size in bytes of a chunk when PatchCreateParams::chunkingMode is PatchChunkingMode::CONTENT_DEFINED, rounded down to a power of two.
+    *  Smaller chunks find more matching data at the cost of more patches. Must be between the minimum and maximum size.
+    *  @var PatchCreateParams::contentDefinedChunkMaximumSize
+    *  Maximum size in bytes of a chunk when PatchCreateParams::chunkingMode is PatchChunkingMode::CONTENT_DEFINED.
+    *  Unmatched chunks are combined into patches of up to PatchCreateParams::maxInputFileChunkSize.
+    *  @var PatchCreateParams::threadCount
+    *  Number of worker threads used to create patches, each worker creates the patches of a separate resource. 1 creates patches on the calling thread, 0 uses the number of hardware threads available.
+    *  Patch ids and order in the produced PatchResourceGroup are the same regardless of thread count. PatchCreateParams::chunkIndexMemoryBudget, PatchCreateParams::chunkIndexThreadCount and PatchCreateParams::diffThreadCount are divided evenly between the workers, each worker gets at least one index and one diff thread.
+    *  @var PatchCreateParams::pendingPatchDataMemoryBudget
+    *  Maximum memory in bytes used to hold patch data generated for later resources while waiting for earlier resources to be committed, when PatchCreateParams::threadCount is greater than 1.
+    *  Patches of the earliest resource not yet committed are committed as they are generated and are not limited by this budget. Workers wait once the budget is exceeded, 0 holds no patch data back.
+    *  @var PatchCreateParams::diffThreadCount
+    *  Number of worker threads used to create the binary diffs of a single resource. Chunks are matched against the previous resource in order and the diff of each unmatched chunk is created on a worker while later chunks are matched.
+    *  1 creates diffs as chunks are matched, 0 uses the number of hardware threads available. The produced patches are the same regardless of thread count.
+    *  Each worker holds a previous and next chunk of up to PatchCreateParams::maxInputFileChunkSize, at most twice this many chunks are held at once per resource.
     *  @var PatchCreateParams::calculateCompressions
     *  Specifies if compression will be calculated for the generated bundle chunks
     */
@@ -162,6 +195,28 @@ struct PatchCreateParams
 
 	std::filesystem::path indexFolder = std::filesystem::temp_directory_path() / "carbonResources" / "chunkIndexes";
 
+	uintmax_t chunkIndexMemoryBudget = 1024 * 1024 * 1024;
+
+	unsigned int chunkIndexThreadCount = 0;
+
+	uintmax_t chunkIndexCacheSize = 0;
+
+	double chunkIndexFilterFalsePositiveRate = 0.01;
+
+	PatchChunkingMode chunkingMode = PatchChunkingMode::FIXED_SIZE;
+
+	uint32_t contentDefinedChunkMinimumSize = 16 * 1024;
+
+	uint32_t contentDefinedChunkAverageSize = 64 * 1024;
+
+	uint32_t contentDefinedChunkMaximumSize = 256 * 1024;
+
+	unsigned int threadCount = 1;
+
+	uintmax_t pendingPatchDataMemoryBudget = 256 * 1024 * 1024;
+
+	unsigned int diffThreadCount = 1;
+
     bool calculateCompressions = true;
 };
 
@@ -184,7 +239,7 @@ struct ResourceGroupImportFromFileParams
     *  @var ResourceGroupExportToFileParams::filename
     *  Full filename of output file. If directory doesn't exist it will be created.
     *  @var ResourceGroupExportToFileParams::outputDocumentVersion
-    *  Document version to output. By default this will be latest supported by the library.
+    *  Document version to output. By default this will be S_DOCUMENT_VERSION, up to S_MAX_DOCUMENT_VERSION is supported.
     *  @var ResourceGroupExportToFileParams::CallbackSettings
     *  Settings relating to status callback messaging
     */
@@ -204,7 +259,7 @@ struct ResourceGroupExportToFileParams
     *  @var CreateResourceGroupFromDirectoryParams::resourceStreamThreshold
     *  Files encountered that are above this the threshold value will be streamed in. Value is in bytes, default: 10000000
     *  @var CreateResourceGroupFromDirectoryParams::outputDocumentVersion
-    *  Document version to output. By default this will be latest supported by the library.
+    *  Document version to output. By default this will be S_DOCUMENT_VERSION, up to S_MAX_DOCUMENT_VERSION is supported.
     *  @var CreateResourceGroupFromDirectoryParams::CallbackSettings
     *  Settings relating to status callback messaging
     *  @var CreateResourceGroupFromDirectoryParams::resourcePrefix
@@ -217,6 +272,29 @@ struct ResourceGroupExportToFileParams
     *  @var CreateResourceGroupFromDirectoryParams::exportResourcesDestinationSettings
     *  If export resources is set, specifies where the produced PatchResourceGroup will be saved.
     *  @see CreateResourceGroupFromDirectoryParams::exportResources
+    *  @var CreateResourceGroupFromDirectoryParams::threadCount
+    *  Number of worker threads used to checksum and compress files. 1 processes files on the calling thread, 0 uses the number of hardware threads available.
+    *  Resource order in the produced ResourceGroup is the same regardless of thread count.
+    *  @var CreateResourceGroupFromDirectoryParams::fileFingerprintCachePath
+    *  Optional path to a file fingerprint cache, disabled if empty. Files whose size, modification time and file id match an entry in the cache are not read,
+    *  checksum, compressed size and location are taken from the cache instead. Any mismatch results in the file being processed in full.
+    *  Files last modified at or after the time the cache started to be populated are also processed in full, as a modification in the same clock tick leaves the fingerprint unchanged.
+    *  The cache is created if it doesn't exist and is updated on successful completion.
+    *  @var CreateResourceGroupFromDirectoryParams::previousResourceGroup
+    *  Optional previous ResourceGroup created from the same directory. Files trusted according to previousResourceGroupTrustPolicy are not read,
+    *  checksum and compressed size are taken from the matching Resource instead.
+    *  @see CreateResourceGroupFromDirectoryParams::previousResourceGroupTrustPolicy
+    *  @var CreateResourceGroupFromDirectoryParams::previousResourceGroupTrustPolicy
+    *  Determines when a Resource in previousResourceGroup is trusted. See PreviousResourceGroupTrustPolicy for more details.
+    *  @var CreateResourceGroupFromDirectoryParams::previousResourceGroupTimestamp
+    *  Time at which creation of previousResourceGroup started, recorded before its directory was read.
+    *  The modification time of an exported ResourceGroup file is not suitable as copying or downloading the file changes it.
+    *  Files modified at or after this time are not trusted when using PreviousResourceGroupTrustPolicy::SIZE_AND_MODIFICATION_TIME.
+    *  The default trusts no files under that policy.
+    *  previousResourceGroup is ignored if it was created with a different checksumAlgorithm.
+    *  @var CreateResourceGroupFromDirectoryParams::checksumAlgorithm
+    *  Algorithm used to generate Resource checksums, recorded in the ResourceGroup. Default is MD5.
+    *  Algorithms other than MD5 require outputDocumentVersion 1.0.0 or greater.
     */
 struct CreateResourceGroupFromDirectoryParams
 {
@@ -235,6 +313,18 @@ struct CreateResourceGroupFromDirectoryParams
     bool exportResources = false;
 
     ResourceDestinationSettings exportResourcesDestinationSettings = { CarbonResources::ResourceDestinationType::LOCAL_CDN, "ExportedResources" };
+
+    unsigned int threadCount = 1;
+
+    std::filesystem::path fileFingerprintCachePath = "";
+
+    ResourceGroup* previousResourceGroup = nullptr;
+
+    PreviousResourceGroupTrustPolicy previousResourceGroupTrustPolicy = PreviousResourceGroupTrustPolicy::SIZE_AND_MODIFICATION_TIME;
+
+    std::filesystem::file_time_type previousResourceGroupTimestamp = std::filesystem::file_time_type::min();
+
+    ChecksumAlgorithm checksumAlgorithm = ChecksumAlgorithm::MD5;
 };
 
 /** @struct ResourceGroupMergeParams
@@ -10,7 +10,7 @@
 
 #include <FileDataStreamOut.h>
 
-#include <Md5ChecksumStream.h>
+#include <ChecksumStream.h>
 
 #include "ResourceGroupFactory.h"
 
@@ -68,7 +68,9 @@ Result BundleResourceGroup::BundleResourceGroupImpl::Unpack( const BundleUnpackP
 
 	resourceGroupDataParams.data = &resourceGroupData;
 
-	Result getChecksumResult = resourceGroupResource->GetChecksum( resourceGroupDataParams.expectedChecksum );
+	resourceGroupDataParams.checksumAlgorithm = m_checksumAlgorithm.GetValue();
+
+	Result getChecksumResult = resourceGroupResource->GetChecksum( resourceGroupDataParams.expectedChecksum.emplace() );
 
 	if( getChecksumResult.type != ResultType::SUCCESS )
 	{
@@ -203,7 +205,7 @@ Result BundleResourceGroup::BundleResourceGroupImpl::Unpack( const BundleUnpackP
 			file.fileSize = resourceFileUncompressedSize;
 
             // Calculate checksum while processing chunks
-            ResourceTools::Md5ChecksumStream resourceChecksumStream;
+            ResourceTools::ChecksumStream resourceChecksumStream( GetResourceToolsChecksumAlgorithm( resourceGroup->GetChecksumAlgorithm() ) );
 
             while (resourceDataStreamOut.GetFileSize() < resourceFileUncompressedSize)
             {
@@ -220,7 +222,9 @@ Result BundleResourceGroup::BundleResourceGroupImpl::Unpack( const BundleUnpackP
 
                     resourceGetDataParams.data = &chunkData;
 
-                    Result getChunkChecksumResult = chunk->GetChecksum(resourceGetDataParams.expectedChecksum);
+                    resourceGetDataParams.checksumAlgorithm = m_checksumAlgorithm.GetValue();
+
+                    Result getChunkChecksumResult = chunk->GetChecksum(resourceGetDataParams.expectedChecksum.emplace());
 
                     if (getChunkChecksumResult.type != ResultType::SUCCESS)
                     {
@@ -278,7 +282,7 @@ Result BundleResourceGroup::BundleResourceGroupImpl::Unpack( const BundleUnpackP
             }
 
             // Validate the resource data
-            std::string recreatedResourceChecksum;
+            ResourceTools::Digest128 recreatedResourceChecksum;
 
             if (!resourceChecksumStream.FinishAndRetrieve(recreatedResourceChecksum))
             {
@@ -286,7 +290,7 @@ Result BundleResourceGroup::BundleResourceGroupImpl::Unpack( const BundleUnpackP
             }
 
 
-            std::string resourceChecksum;
+            ResourceTools::Digest128 resourceChecksum;
 
             Result getChecksumResult = resource->GetChecksum(resourceChecksum);
 
@@ -316,6 +320,9 @@ Result BundleResourceGroup::BundleResourceGroupImpl::Unpack( const BundleUnpackP
 		}
 		exportParams.filename = params.resourceDestinationSettings.basePath / resourceGroupRelativePath;
 
+		// Export is clamped to the imported document version, which preserves it
+		exportParams.outputDocumentVersion = S_MAX_DOCUMENT_VERSION;
+
 		Result exportResult = resourceGroup->ExportToFile( exportParams, exportStatusSettings );
 		if( exportResult.type != ResultType::SUCCESS )
 		{
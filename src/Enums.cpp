@@ -156,10 +156,65 @@ bool ResultTypeToString( ResultType resultType, std::string& output )
 	case ResultType::REQUIRED_INPUT_PARAMETER_NOT_SET:
 		output = "A required parameter was not set";
 		return true;
+
+	case ResultType::CHECKSUM_ALGORITHM_UNSUPPORTED_BY_DOCUMENT_VERSION:
+		output = "The checksum algorithm cannot be represented in the requested document version. Only MD5 is supported before document version 1.0.0.";
+		return true;
+
+	case ResultType::CHECKSUM_ALGORITHM_MISMATCH:
+		output = "ResourceGroups supplied to the operation use different checksum algorithms.";
+		return true;
+
+	case ResultType::FAILED_TO_ROLL_BACK_PATCH:
+		output = "A resource patched in place could not be restored after an interrupted or failed apply. Its rollback journal is kept so restoring can be retried by applying again.";
+		return true;
 	}
 
 	output = "Error code unrecognised. This is an internal library error which shouldn't be encountered. If you encounter this error contact API addministrators.";
 
 	return false;
 }
-}
\ No newline at end of file
+
+bool ChecksumAlgorithmToString( ChecksumAlgorithm checksumAlgorithm, std::string& output )
+{
+	switch( checksumAlgorithm )
+	{
+	case ChecksumAlgorithm::MD5:
+		output = "MD5";
+		return true;
+
+	case ChecksumAlgorithm::BLAKE2B_128:
+		output = "BLAKE2B_128";
+		return true;
+
+	case ChecksumAlgorithm::XXH3_128:
+		output = "XXH3_128";
+		return true;
+	}
+
+	return false;
+}
+
+bool StringToChecksumAlgorithm( const std::string& input, ChecksumAlgorithm& checksumAlgorithm )
+{
+	if( input == "MD5" )
+	{
+		checksumAlgorithm = ChecksumAlgorithm::MD5;
+		return true;
+	}
+
+	if( input == "BLAKE2B_128" )
+	{
+		checksumAlgorithm = ChecksumAlgorithm::BLAKE2B_128;
+		return true;
+	}
+
+	if( input == "XXH3_128" )
+	{
+		checksumAlgorithm = ChecksumAlgorithm::XXH3_128;
+		return true;
+	}
+
+	return false;
+}
+}
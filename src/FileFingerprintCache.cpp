@@ -0,0 +1,180 @@
+// Copyright © 2025 CCP ehf.
+
+#include "FileFingerprintCache.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+namespace CarbonResources
+{
+
+// Bump if the line format changes, mismatched caches are discarded
+static const std::string FILE_FINGERPRINT_CACHE_HEADER = "FileFingerprintCache 3";
+
+FileFingerprintCache::FileFingerprintCache( ChecksumAlgorithm checksumAlgorithm ) :
+	m_checksumAlgorithm( checksumAlgorithm ),
+	m_timestamp( 0 ),
+	m_previousTimestamp( 0 )
+{
+	// Taken before any file is fingerprinted, rounded down to whole seconds for file systems with coarse modification times
+	std::filesystem::file_time_type now = std::filesystem::file_time_type::clock::now();
+
+	std::filesystem::file_time_type::duration nowInSeconds = std::chrono::floor<std::chrono::seconds>( now.time_since_epoch() );
+
+	m_timestamp = static_cast<int64_t>( nowInSeconds.count() );
+}
+
+std::string FileFingerprintCache::GetHeader() const
+{
+	std::string checksumAlgorithm;
+
+	ChecksumAlgorithmToString( m_checksumAlgorithm, checksumAlgorithm );
+
+	return FILE_FINGERPRINT_CACHE_HEADER + " " + checksumAlgorithm;
+}
+
+Result FileFingerprintCache::ImportFromFile( const std::filesystem::path& path )
+{
+	m_previousEntries.clear();
+
+	m_previousTimestamp = 0;
+
+	std::ifstream in( path, std::ios::in | std::ios::binary );
+
+	if( !in )
+	{
+		return Result{ ResultType::FAILED_TO_OPEN_FILE };
+	}
+
+	std::string line;
+
+	if( !std::getline( in, line ) || line != GetHeader() )
+	{
+		return Result{ ResultType::UNSUPPORTED_FILE_FORMAT };
+	}
+
+	// Second line holds the time the cache started to be populated
+	if( !std::getline( in, line ) )
+	{
+		return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+	}
+
+	try
+	{
+		m_previousTimestamp = std::stoll( line );
+	}
+	catch( std::exception& )
+	{
+		return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+	}
+
+	// Line format: size,modificationTime,fileId,compressedSize,checksum,location,relativePath
+	// Relative path is last so that it may contain commas
+	while( std::getline( in, line ) )
+	{
+		if( line.empty() )
+		{
+			continue;
+		}
+
+		std::stringstream ss( line );
+
+		FileFingerprintCacheEntry entry;
+
+		std::string size, modificationTime, fileId, compressedSize, checksum, relativePath;
+
+		if( !std::getline( ss, size, ',' ) || !std::getline( ss, modificationTime, ',' ) || !std::getline( ss, fileId, ',' ) || !std::getline( ss, compressedSize, ',' ) || !std::getline( ss, checksum, ',' ) || !std::getline( ss, entry.location, ',' ) || !std::getline( ss, relativePath ) || !entry.checksum.FromHexString( checksum ) )
+		{
+			m_previousEntries.clear();
+
+			return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+		}
+
+		try
+		{
+			entry.fingerprint.size = std::stoull( size );
+
+			entry.fingerprint.modificationTime = std::stoll( modificationTime );
+
+			entry.fingerprint.fileId = std::stoull( fileId );
+
+			entry.compressedSize = std::stoull( compressedSize );
+		}
+		catch( std::exception& )
+		{
+			m_previousEntries.clear();
+
+			return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+		}
+
+		m_previousEntries[relativePath] = entry;
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result FileFingerprintCache::ExportToFile( const std::filesystem::path& path ) const
+{
+	std::stringstream out;
+
+	out << GetHeader() << "\n";
+
+	out << m_timestamp << "\n";
+
+	{
+		std::lock_guard<std::mutex> lock( m_entriesMutex );
+
+		for( const auto& [relativePath, entry] : m_entries )
+		{
+			out << entry.fingerprint.size << ",";
+			out << entry.fingerprint.modificationTime << ",";
+			out << entry.fingerprint.fileId << ",";
+			out << entry.compressedSize << ",";
+			out << entry.checksum.ToHexString() << ",";
+			out << entry.location << ",";
+			out << relativePath << "\n";
+		}
+	}
+
+	if( !ResourceTools::SaveFile( path, out.str() ) )
+	{
+		return Result{ ResultType::FAILED_TO_SAVE_FILE };
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+bool FileFingerprintCache::Find( const std::filesystem::path& relativePath, const ResourceTools::FileFingerprint& fingerprint, FileFingerprintCacheEntry& entry ) const
+{
+	auto iter = m_previousEntries.find( relativePath.generic_string() );
+
+	if( iter == m_previousEntries.end() )
+	{
+		return false;
+	}
+
+	if( !( iter->second.fingerprint == fingerprint ) )
+	{
+		return false;
+	}
+
+	// File may have been modified in the same clock tick as it was fingerprinted
+	if( iter->second.fingerprint.modificationTime >= m_previousTimestamp )
+	{
+		return false;
+	}
+
+	entry = iter->second;
+
+	return true;
+}
+
+void FileFingerprintCache::Insert( const std::filesystem::path& relativePath, const FileFingerprintCacheEntry& entry )
+{
+	std::lock_guard<std::mutex> lock( m_entriesMutex );
+
+	m_entries[relativePath.generic_string()] = entry;
+}
+
+}
@@ -0,0 +1,74 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef FileFingerprintCache_H
+#define FileFingerprintCache_H
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <ResourceTools.h>
+
+#include "Enums.h"
+
+namespace CarbonResources
+{
+
+struct FileFingerprintCacheEntry
+{
+	ResourceTools::FileFingerprint fingerprint;
+
+	ResourceTools::Digest128 checksum;
+
+	uintmax_t compressedSize = 0;
+
+	std::string location = "";
+};
+
+// Maps relative path of a file to results of a previous checksum and compression pass.
+// Entries are only valid while the file fingerprint (size, modification time and file id) matches.
+// Lookups are made against the loaded entries, inserts go to a separate set which is what gets saved.
+// This means files no longer present are dropped from the cache on save.
+// Checksums are only valid for the algorithm the cache was saved with, a cache saved with another algorithm is discarded.
+// The cache records when it started to be populated, entries for files modified at or after that time are not trusted
+// as a modification in the same clock tick as the file was fingerprinted leaves the fingerprint unchanged.
+// Entries are saved sorted by relative path so that the output is stable between runs.
+// Insert is safe to call from multiple threads.
+class FileFingerprintCache
+{
+public:
+	FileFingerprintCache( ChecksumAlgorithm checksumAlgorithm );
+
+	Result ImportFromFile( const std::filesystem::path& path );
+
+	Result ExportToFile( const std::filesystem::path& path ) const;
+
+	bool Find( const std::filesystem::path& relativePath, const ResourceTools::FileFingerprint& fingerprint, FileFingerprintCacheEntry& entry ) const;
+
+	void Insert( const std::filesystem::path& relativePath, const FileFingerprintCacheEntry& entry );
+
+private:
+	std::string GetHeader() const;
+
+private:
+	ChecksumAlgorithm m_checksumAlgorithm;
+
+	// Time at which this cache started to be populated, in file time ticks
+	int64_t m_timestamp;
+
+	// Time at which the loaded cache started to be populated, in file time ticks
+	int64_t m_previousTimestamp;
+
+	std::unordered_map<std::string, FileFingerprintCacheEntry> m_previousEntries;
+
+	std::map<std::string, FileFingerprintCacheEntry> m_entries;
+
+	mutable std::mutex m_entriesMutex;
+};
+
+}
+
+#endif // FileFingerprintCache_H
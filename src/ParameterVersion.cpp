@@ -28,6 +28,7 @@ ParameterInfo PARAMETER_TYPE( Parameter::TYPE, "Type", { { CONTEXT_RESOURCE_GROU
 ParameterInfo PARAMETER_NUMBER_OF_RESOURCES( Parameter::NUMBER_OF_RESOURCES, "NumberOfResources", { { CONTEXT_RESOURCE_GROUP, VERSION_0_1_0, VERSION_MAX } } );
 ParameterInfo PARAMETER_TOTAL_RESOURCE_SIZE_COMPRESSED( Parameter::TOTAL_RESOURCE_SIZE_COMPRESSED, "TotalResourcesSizeCompressed", { { CONTEXT_RESOURCE_GROUP, VERSION_0_1_0, VERSION_MAX } } );
 ParameterInfo PARAMETER_TOTAL_RESOURCE_SIZE_UNCOMPRESSED( Parameter::TOTAL_RESOURCE_SIZE_UNCOMPRESSED, "TotalResourcesSizeUnCompressed", { { CONTEXT_RESOURCE_GROUP, VERSION_0_1_0, VERSION_MAX } } );
+ParameterInfo PARAMETER_CHECKSUM_ALGORITHM( Parameter::CHECKSUM_ALGORITHM, "ChecksumAlgorithm", { { CONTEXT_RESOURCE_GROUP, VERSION_1_0_0, VERSION_MAX } } );
 ParameterInfo PARAMETER_RESOURCES( Parameter::RESOURCE, "Resources", { { CONTEXT_RESOURCE_GROUP, VERSION_0_0_0, VERSION_MAX } } );
 ParameterInfo PARAMETER_DATA_OFFSET( Parameter::DATA_OFFSET, "DataOffset", { { CONTEXT_BINARY_PATCH, VERSION_0_0_0, VERSION_MAX } } );
 ParameterInfo PARAMETER_SOURCE_OFFSET( Parameter::SOURCE_OFFSET, "SourceOffset", { { CONTEXT_BINARY_PATCH, VERSION_0_0_0, VERSION_MAX } } );
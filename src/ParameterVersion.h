@@ -39,7 +39,8 @@ enum Parameter
 	UNCOMPRESSED_SIZE,
 	BINARY_OPERATION,
 	PREFIX,
-	REMOVED_RESOURCE_RELATIVE_PATHS
+	REMOVED_RESOURCE_RELATIVE_PATHS,
+	CHECKSUM_ALGORITHM
 };
 
 class ParameterContext
@@ -16,7 +16,23 @@
 
 #include <FileDataStreamOut.h>
 
-#include <Md5ChecksumStream.h>
+#include <ChecksumStream.h>
+
+#include <FileRollbackJournal.h>
+
+#include <algorithm>
+
+#include <atomic>
+
+#include <condition_variable>
+
+#include <fstream>
+
+#include <functional>
+
+#include <mutex>
+
+#include <thread>
 
 namespace CarbonResources
 {
@@ -108,12 +124,143 @@ Result PatchResourceGroup::PatchResourceGroupImpl::CreateResourceFromYaml( YAML:
 
 		return importFromYamlResult;
 	}
-	else
+
+	resourceOut = patchResource;
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result PatchResourceGroup::PatchResourceGroupImpl::BuildTargetResourcePatchIndex()
+{
+	m_targetResourcePatches.clear();
+
+	for( ResourceInfo* patchResource : m_resourcesParameter )
 	{
-		resourceOut = patchResource;
+		const PatchResourceInfo* patch = reinterpret_cast<PatchResourceInfo*>( patchResource );
+
+		std::filesystem::path patchTargetResource;
+
+		Result getPatchTargetResource = patch->GetTargetResourceRelativePath( patchTargetResource );
+
+		if( getPatchTargetResource.type != ResultType::SUCCESS )
+		{
+			return getPatchTargetResource;
+		}
+
+		m_targetResourcePatches[patchTargetResource.generic_string()].push_back( patch );
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result PatchResourceGroup::PatchResourceGroupImpl::UpdateSharedPatchData( const PatchApplyParams& params )
+{
+	m_sharedPatchData.clear();
 
+	// Patches stored by relative path never share data
+	if( params.patchBinarySourceSettings.sourceType == ResourceSourceType::LOCAL_RELATIVE )
+	{
 		return Result{ ResultType::SUCCESS };
 	}
+
+	std::unordered_map<std::string, size_t> locationUses;
+
+	for( const auto& targetResourcePatches : m_targetResourcePatches )
+	{
+		for( const PatchResourceInfo* patch : targetResourcePatches.second )
+		{
+			std::string location;
+
+			Result getLocationResult = patch->GetLocation( location );
+
+			if( getLocationResult.type != ResultType::SUCCESS )
+			{
+				return getLocationResult;
+			}
+
+			if( !location.empty() )
+			{
+				locationUses[location]++;
+			}
+		}
+	}
+
+	for( const auto& [location, uses] : locationUses )
+	{
+		if( uses > 1 )
+		{
+			auto sharedPatchData = std::make_unique<SharedPatchData>();
+
+			sharedPatchData->remainingUses = uses;
+
+			m_sharedPatchData.emplace( location, std::move( sharedPatchData ) );
+		}
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result PatchResourceGroup::PatchResourceGroupImpl::GetPatchData( const PatchApplyParams& params, const PatchResourceInfo* patch, std::string& patchData ) const
+{
+	ResourceGetDataParams patchGetDataParams;
+
+	patchGetDataParams.resourceSourceSettings = params.patchBinarySourceSettings;
+
+	patchGetDataParams.data = &patchData;
+
+	std::string location;
+
+	Result getLocationResult = patch->GetLocation( location );
+
+	if( getLocationResult.type != ResultType::SUCCESS )
+	{
+		return getLocationResult;
+	}
+
+	auto sharedPatchDataIter = m_sharedPatchData.find( location );
+
+	if( sharedPatchDataIter == m_sharedPatchData.end() )
+	{
+		return patch->GetData( patchGetDataParams );
+	}
+
+	// Map entries are only added before patching starts, each entry is locked so its data is retrieved once
+	SharedPatchData& sharedPatchData = *sharedPatchDataIter->second;
+
+	std::lock_guard<std::mutex> lock( sharedPatchData.mutex );
+
+	if( !sharedPatchData.retrieved )
+	{
+		Result getPatchDataResult = patch->GetData( patchGetDataParams );
+
+		if( getPatchDataResult.type != ResultType::SUCCESS )
+		{
+			return getPatchDataResult;
+		}
+
+		sharedPatchData.retrieved = true;
+
+		sharedPatchData.data = patchData;
+	}
+	else
+	{
+		patchData = sharedPatchData.data;
+	}
+
+	if( sharedPatchData.remainingUses > 0 )
+	{
+		sharedPatchData.remainingUses--;
+	}
+
+	// A patch retrieved again, as when falling back from applying in place, uses up the count early so the data is retrieved afresh after release
+	if( sharedPatchData.remainingUses == 0 )
+	{
+		sharedPatchData.retrieved = false;
+
+		std::string().swap( sharedPatchData.data );
+	}
+
+	return Result{ ResultType::SUCCESS };
 }
 
 Result PatchResourceGroup::PatchResourceGroupImpl::ImportGroupSpecialisedYaml( YAML::Node& resourceGroupFile )
@@ -222,470 +369,1021 @@ Result PatchResourceGroup::PatchResourceGroupImpl::GetTargetResourcePatches( con
 		return resourceRelativePathResult;
 	}
 
-	for( ResourceInfo* patchResource : m_resourcesParameter )
-	{
-		PatchResourceInfo* patch = reinterpret_cast<PatchResourceInfo*>( patchResource );
-
-		std::filesystem::path patchTargetResource;
-
-		Result getPatchTargetResource = patch->GetTargetResourceRelativePath( patchTargetResource );
-
-		if( getPatchTargetResource.type != ResultType::SUCCESS )
-		{
-			return getPatchTargetResource;
-		}
+	auto targetResourcePatches = m_targetResourcePatches.find( resourceRelativePath.generic_string() );
 
-		if( resourceRelativePath == patchTargetResource )
-		{
-			patches.push_back( patch );
-		}
+	if( targetResourcePatches != m_targetResourcePatches.end() )
+	{
+		patches.insert( patches.end(), targetResourcePatches->second.begin(), targetResourcePatches->second.end() );
 	}
 
 	return Result{ ResultType::SUCCESS };
 }
 
-Result PatchResourceGroup::PatchResourceGroupImpl::Apply( const PatchApplyParams& params, StatusSettings& statusSettings )
+// A patch applied in place, covering its resource from dataOffset up to the next patch or the end of the resource
+struct InPlacePatch
 {
-	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 10, "Applying Patch." );
-
-	// Will be removed when falls out of scope
-	ResourceTools::ScopedFile temporaryFileScope( params.temporaryFilePath );
-
-	ResourceGroupInfo* resourceGroupResource = m_resourceGroupParameter.GetValue();
-
-
-	// Load the resourceGroup from the resourceGroupResource
-	std::string resourceGroupData;
+	const PatchResourceInfo* patch;
 
-	ResourceGetDataParams resourceGroupDataParams;
+	uint64_t dataOffset;
 
-	resourceGroupDataParams.resourceSourceSettings = params.patchBinarySourceSettings;
+	uint64_t sourceOffset;
 
-	resourceGroupDataParams.data = &resourceGroupData;
+	uint64_t size;
 
-	Result resourceGroupGetDataResult = m_resourceGroupParameter.GetValue()->GetData( resourceGroupDataParams );
+	bool hasPatchFile;
+};
 
-	if( resourceGroupGetDataResult.type != ResultType::SUCCESS )
+// Adds a region of the resource left unchanged to the checksum
+static bool ChecksumResourceRange( std::fstream& resource, uint64_t offset, uint64_t size, uint64_t chunkSize, ResourceTools::ChecksumStream& checksum )
+{
+	if( !resource.seekg( static_cast<std::streamoff>( offset ) ) )
 	{
-		return resourceGroupGetDataResult;
+		return false;
 	}
 
-	ResourceGroupImpl resourceGroup;
-
-    {
-		StatusSettings importFromDataStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 10, "Applying Patch.", &importFromDataStatusSettings );
+	std::string data;
 
-		Result resourceGroupImportFromDataResult = resourceGroup.ImportFromData( resourceGroupData, importFromDataStatusSettings );
+	while( size > 0 )
+	{
+		data.resize( std::min( size, chunkSize ) );
 
-		if( resourceGroupImportFromDataResult.type != ResultType::SUCCESS )
+		if( !resource.read( data.data(), static_cast<std::streamsize>( data.size() ) ) )
 		{
-			return resourceGroupImportFromDataResult;
+			return false;
 		}
-	}
-    {
-		StatusSettings patchingStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 20, 70, "Applying Patch.", &patchingStatusSettings );
-
-		auto numResources = resourceGroup.GetSize();
-		int numProcessed = 0;
 
-		for( ResourceInfo* resource : resourceGroup )
+		if( !( checksum << data ) )
 		{
-			if( patchingStatusSettings.RequiresStatusUpdates() )
-			{
-				std::filesystem::path relativePath;
-
-				if( resource->GetRelativePath( relativePath ).type != ResultType::SUCCESS )
-				{
-					return Result{ ResultType::FAIL };
-				}
-
-				float step = static_cast<float>( 100.0 / numResources );
-				float percentage = static_cast<float>( step * numProcessed );
+			return false;
+		}
 
-				std::string message = "Patching: " + relativePath.string();
+		size -= data.size();
+	}
 
-				patchingStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, message );
+	return true;
+}
 
-				numProcessed++;
-			}
+// Writes each patched region over the resource in order
+// The previous data a patch reads starts at or after its own region, so it is never overwritten before it is read
+static bool WriteInPlacePatches( const std::function<bool( const PatchResourceInfo* patch, std::string& patchData )>& getPatchData, const std::vector<InPlacePatch>& patches, const std::filesystem::path& resourcePath, uint64_t previousSize, uint64_t chunkSize, ResourceTools::ChecksumStream& checksum )
+{
+	std::fstream resource( resourcePath, std::ios::in | std::ios::out | std::ios::binary );
 
-			// See if there is a patch available for resource
-			std::vector<const PatchResourceInfo*> patchesForResource;
+	if( !resource )
+	{
+		return false;
+	}
 
-			Result getTargetResourcePatchesResult = GetTargetResourcePatches( resource, patchesForResource );
+	// Data before the first patch is unchanged
+	if( !ChecksumResourceRange( resource, 0, patches.front().dataOffset, chunkSize, checksum ) )
+	{
+		return false;
+	}
 
-			if( getTargetResourcePatchesResult.type != ResultType::SUCCESS )
+	for( const InPlacePatch& inPlacePatch : patches )
+	{
+		if( !inPlacePatch.hasPatchFile )
+		{
+			if( !ChecksumResourceRange( resource, inPlacePatch.dataOffset, inPlacePatch.size, chunkSize, checksum ) )
 			{
-				return getTargetResourcePatchesResult;
+				return false;
 			}
 
+			continue;
+		}
 
-			// Open a stream to write a temp file of the patched resource
-			ResourceTools::FileDataStreamOut temporaryResourceDataStreamOut;
-
-			if( !temporaryResourceDataStreamOut.StartWrite( params.temporaryFilePath ) )
-			{
-				return Result{ ResultType::FAILED_TO_OPEN_FILE };
-			}
+		std::string patchData;
 
-			// Incrementally calculate checksum for temporary patch file
-			ResourceTools::Md5ChecksumStream patchedFileChecksumStream;
+		if( !getPatchData( inPlacePatch.patch, patchData ) )
+		{
+			return false;
+		}
 
-			if( patchesForResource.size() > 0 )
-			{
-				// Open stream for resource
-				auto resourceDataStreamIn = std::make_shared<ResourceTools::FileDataStreamIn>( m_maxInputChunkSize.GetValue() );
+		// Previous data is a chunk from the source offset, as read for full reconstruction
+		std::string previousData( std::min( chunkSize, previousSize - std::min( previousSize, inPlacePatch.sourceOffset ) ), '\0' );
 
-				ResourceGetDataStreamParams resourceDataStreamParams;
+		if( !resource.seekg( static_cast<std::streamoff>( inPlacePatch.sourceOffset ) ) || !resource.read( previousData.data(), static_cast<std::streamsize>( previousData.size() ) ) )
+		{
+			return false;
+		}
 
-				resourceDataStreamParams.resourceSourceSettings = params.resourcesToPatchSourceSettings;
+		std::string patchedData;
 
-				resourceDataStreamParams.dataStream = resourceDataStreamIn;
+		if( !ResourceTools::ApplyPatch( previousData, patchData, patchedData ) )
+		{
+			return false;
+		}
 
-				Result getResourceDataStream = resource->GetDataStream( resourceDataStreamParams );
+		// A patch must fill its region exactly, otherwise the unchanged data after it would be in the wrong place
+		if( patchedData.size() != inPlacePatch.size )
+		{
+			return false;
+		}
 
-				if( getResourceDataStream.type != ResultType::SUCCESS )
-				{
-					return getResourceDataStream;
-				}
+		if( !resource.seekp( static_cast<std::streamoff>( inPlacePatch.dataOffset ) ) || !resource.write( patchedData.data(), static_cast<std::streamsize>( patchedData.size() ) ) )
+		{
+			return false;
+		}
 
+		if( !( checksum << patchedData ) )
+		{
+			return false;
+		}
+	}
 
-				for( auto patchIter = patchesForResource.begin(); patchIter != patchesForResource.end(); patchIter++ )
-				{
+	return static_cast<bool>( resource.flush() );
+}
 
-					const PatchResourceInfo* patch = ( *patchIter );
+Result PatchResourceGroup::PatchResourceGroupImpl::ApplyResourceInPlace( const PatchApplyParams& params, ResourceInfo* resource, const std::vector<const PatchResourceInfo*>& patches, ChecksumAlgorithm checksumAlgorithm, bool& appliedInPlace, std::string& fallbackReason ) const
+{
+	appliedInPlace = false;
 
-					// Patch found, Retreive and apply
-					std::string patchData;
+	fallbackReason.clear();
 
-					ResourceGetDataParams patchGetDataParams;
+	std::filesystem::path destinationPath;
 
-					patchGetDataParams.resourceSourceSettings = params.patchBinarySourceSettings;
+	// A resource without patches is copied from the next build
+	if( patches.empty() )
+	{
+		return Result{ ResultType::SUCCESS };
+	}
 
-					patchGetDataParams.data = &patchData;
+	if( resource->GetLocalDestinationPath( params.resourcesToPatchDestinationSettings, destinationPath ).type != ResultType::SUCCESS )
+	{
+		fallbackReason = "destination is not a local file";
 
-					std::string location;
-					Result patchGetLocationResult = patch->GetLocation( location );
-					if( patchGetLocationResult.type != ResultType::SUCCESS )
-					{
-						return patchGetLocationResult;
-					}
-					bool hasPatchFile{ !location.empty() };
+		return Result{ ResultType::SUCCESS };
+	}
 
-					if( hasPatchFile )
-					{
-						Result getPatchDataResult = patch->GetData( patchGetDataParams );
+	// Only a resource read from its own destination can be patched in place
+	std::filesystem::path resourcePath;
 
-						if( getPatchDataResult.type != ResultType::SUCCESS )
-						{
-							return getPatchDataResult;
-						}
-					}
+	{
+		auto resourceDataStreamIn = std::make_shared<ResourceTools::FileDataStreamIn>( m_maxInputChunkSize.GetValue() );
 
-					// Get previous data
-					uintmax_t dataOffset;
-					uintmax_t sourceOffset;
-					Result getPatchDataOffset = patch->GetDataOffset( dataOffset );
+		ResourceGetDataStreamParams resourceDataStreamParams;
 
-					if( getPatchDataOffset.type != ResultType::SUCCESS )
-					{
-						return getPatchDataOffset;
-					}
+		resourceDataStreamParams.resourceSourceSettings = params.resourcesToPatchSourceSettings;
 
-					Result getPatchSourceOffset = patch->GetSourceOffset( sourceOffset );
-					if( getPatchSourceOffset.type != ResultType::SUCCESS )
-					{
-						return getPatchSourceOffset;
-					}
+		resourceDataStreamParams.dataStream = resourceDataStreamIn;
 
-					std::string previousResourceData;
+		if( resource->GetDataStream( resourceDataStreamParams ).type != ResultType::SUCCESS )
+		{
+			fallbackReason = "resource could not be read";
 
-					// Get previous size of resource
-					uintmax_t previousUncompressedSize;
+			return Result{ ResultType::SUCCESS };
+		}
 
-					Result getPreviousUncompressedSize = resource->GetUncompressedSize( previousUncompressedSize );
+		resourcePath = resourceDataStreamIn->GetPath();
+	}
 
-					if( getPreviousUncompressedSize.type != ResultType::SUCCESS )
-					{
-						return getPreviousUncompressedSize;
-					}
+	std::error_code error;
 
-					if( dataOffset < previousUncompressedSize )
-					{
-						int64_t previousSourcePosition = resourceDataStreamIn->GetCurrentPosition();
-						// Get to location of patch
-						while( temporaryResourceDataStreamOut.GetFileSize() < dataOffset )
-						{
-							std::string dataChunk;
-							uint64_t remaining = dataOffset - temporaryResourceDataStreamOut.GetFileSize();
-							if( remaining < m_maxInputChunkSize.GetValue() )
-							{
-								if( !resourceDataStreamIn->ReadBytes( remaining, dataChunk ) )
-								{
-									return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-								}
-							}
-							else if( !( *resourceDataStreamIn >> dataChunk ) )
-							{
-								return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-							}
-
-							if( !( temporaryResourceDataStreamOut << dataChunk ) )
-							{
-								return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
-							}
-
-							// Add to incremental checksum calculation
-							if( !( patchedFileChecksumStream << dataChunk ) )
-							{
-								return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
-							}
-							previousSourcePosition += dataChunk.size();
-						}
-						if( resourceDataStreamIn->IsFinished() )
-						{
-							resourceDataStreamIn->StartRead( resourceDataStreamIn->GetPath() );
-						}
-						resourceDataStreamIn->Seek( previousSourcePosition );
+	if( !std::filesystem::equivalent( resourcePath, destinationPath, error ) )
+	{
+		fallbackReason = "resource is not read from its destination";
 
+		return Result{ ResultType::SUCCESS };
+	}
 
-						// Apply the patch to the previous data
-						std::string patchedResourceData;
+	ResourceTools::FileRollbackJournal journal( resourcePath );
 
-						if( hasPatchFile )
-						{
-							// Apply patch to data
-							resourceDataStreamIn->Seek( sourceOffset );
-							if( !( *resourceDataStreamIn >> previousResourceData ) )
-							{
-								return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-							}
-							if( !ResourceTools::ApplyPatch( previousResourceData, patchData, patchedResourceData ) )
-							{
-								return Result{ ResultType::FAILED_TO_APPLY_PATCH };
-							}
-							// Write the patch result to file
-							if( !( temporaryResourceDataStreamOut << patchedResourceData ) )
-							{
-								return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
-							}
-
-							// Add to incremental checksum calculation
-							if( !( patchedFileChecksumStream << patchedResourceData ) )
-							{
-								return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
-							}
-						}
-						else
-						{
+	// Restores the resource if an earlier apply in place was interrupted
+	if( journal.Exists() && !journal.RollBack() )
+	{
+		return Result{ ResultType::FAILED_TO_ROLL_BACK_PATCH };
+	}
 
-							auto sourceDataStreamIn = std::make_shared<ResourceTools::FileDataStreamIn>( m_maxInputChunkSize.GetValue() );
-
-							ResourceGetDataStreamParams getDataStreamParams;
-
-							getDataStreamParams.dataStream = sourceDataStreamIn;
-
-							getDataStreamParams.resourceSourceSettings = params.resourcesToPatchSourceSettings;
-
-							Result getDataStreamResult = resource->GetDataStream( getDataStreamParams );
-
-							if( getDataStreamResult.type != ResultType::SUCCESS )
-							{
-								return getDataStreamResult;
-							}
-
-							uintmax_t sourceOffset{ 0 };
-							Result getSourceOffsetResult = patch->GetSourceOffset( sourceOffset );
-							if( getSourceOffsetResult.type != ResultType::SUCCESS )
-							{
-								return getSourceOffsetResult;
-							}
-							uintmax_t unCompressedSize{ 0 };
-							Result getUncompressedSizeResult = patch->GetUncompressedSize( unCompressedSize );
-							if( getUncompressedSizeResult.type != ResultType::SUCCESS )
-							{
-								return getUncompressedSizeResult;
-							}
-							sourceDataStreamIn->Seek( sourceOffset );
-							while( unCompressedSize )
-							{
-								std::string sourceData;
-								if( unCompressedSize >= m_maxInputChunkSize.GetValue() )
-								{
-									*sourceDataStreamIn >> sourceData;
-								}
-								else
-								{
-									sourceDataStreamIn->ReadBytes( unCompressedSize, sourceData );
-								}
-
-								if( sourceData.empty() )
-								{
-									return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-								}
-								*resourceDataStreamIn >> previousResourceData;
-								if( sourceData.size() > unCompressedSize )
-								{
-									sourceData = sourceData.substr( unCompressedSize );
-								}
-								unCompressedSize -= std::min( sourceData.size(), unCompressedSize );
-
-								// Write the data from the source file
-								if( !( temporaryResourceDataStreamOut << sourceData ) )
-								{
-									return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
-								}
-
-								// Add to incremental checksum calculation
-								if( !( patchedFileChecksumStream << sourceData ) )
-								{
-									return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
-								}
-							}
-						}
-					}
-					else
-					{
-						// New data, append on to end
-						if( !( temporaryResourceDataStreamOut << previousResourceData ) )
-						{
-							return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
-						}
+	uint64_t previousSize = std::filesystem::file_size( resourcePath, error );
 
-						// Add to incremental checksum calculation
-						if( !( patchedFileChecksumStream << previousResourceData ) )
-						{
-							return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
-						}
-					}
-				}
+	if( error )
+	{
+		fallbackReason = "size of resource could not be read";
 
-				// Stream out the remaining expected data
-				uintmax_t expectedResourceSize = 0;
+		return Result{ ResultType::SUCCESS };
+	}
 
-				Result getResourceUncompressedSizeResult = resource->GetUncompressedSize( expectedResourceSize );
+	uintmax_t targetSize{ 0 };
 
-				if( getResourceUncompressedSizeResult.type != ResultType::SUCCESS )
-				{
-					return getResourceUncompressedSizeResult;
-				}
+	Result getTargetSizeResult = resource->GetUncompressedSize( targetSize );
 
-				temporaryResourceDataStreamOut.Finish();
-			}
-			else
-			{
-				// No Patch found, indicates this is just a new file
-				// Just replace file directly
-				auto resourceStreamIn = std::make_shared<ResourceTools::FileDataStreamIn>( m_maxInputChunkSize.GetValue() );
+	if( getTargetSizeResult.type != ResultType::SUCCESS )
+	{
+		return getTargetSizeResult;
+	}
 
-				ResourceGetDataStreamParams resourceGetDataParams;
+	ResourceTools::Digest128 expectedChecksum;
 
-				resourceGetDataParams.resourceSourceSettings = params.nextBuildResourcesSourceSettings;
+	Result getChecksumResult = resource->GetChecksum( expectedChecksum );
 
-				resourceGetDataParams.dataStream = resourceStreamIn;
+	if( getChecksumResult.type != ResultType::SUCCESS )
+	{
+		return getChecksumResult;
+	}
 
-				Result resourceGetDataResult = resource->GetDataStream( resourceGetDataParams );
+	std::vector<InPlacePatch> inPlacePatches;
 
-                if (resourceGetDataResult.type != ResultType::SUCCESS)
-                {
-                    return resourceGetDataResult;
-                }
+	for( const PatchResourceInfo* patch : patches )
+	{
+		uintmax_t dataOffset{ 0 };
 
-                while (!resourceStreamIn->IsFinished())
-                {
-                    std::string resourceData;
+		Result getDataOffsetResult = patch->GetDataOffset( dataOffset );
 
-                    if (!(*resourceStreamIn >> resourceData))
-                    {
-                        return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-                    }
+		if( getDataOffsetResult.type != ResultType::SUCCESS )
+		{
+			return getDataOffsetResult;
+		}
 
-                    if (!(temporaryResourceDataStreamOut << resourceData))
-                    {
-                        return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
-                    }
+		uintmax_t sourceOffset{ 0 };
 
-                    // Add to incremental checksum calculation
-                    if (!(patchedFileChecksumStream << resourceData))
-                    {
-                        return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
-                    }
-                }
+		Result getSourceOffsetResult = patch->GetSourceOffset( sourceOffset );
 
-                temporaryResourceDataStreamOut.Finish();
-            }
+		if( getSourceOffsetResult.type != ResultType::SUCCESS )
+		{
+			return getSourceOffsetResult;
+		}
 
+		std::string location;
 
-            // Test checksum against expected
-            std::string destinationExpectedChecksum;
+		Result getLocationResult = patch->GetLocation( location );
 
-            Result getChecksumResult = resource->GetChecksum(destinationExpectedChecksum);
+		if( getLocationResult.type != ResultType::SUCCESS )
+		{
+			return getLocationResult;
+		}
 
-            if (getChecksumResult.type != ResultType::SUCCESS)
-            {
-                return getChecksumResult;
-            }
+		// Size runs to the next patch so is set once every offset is known
+		inPlacePatches.push_back( InPlacePatch{ patch, dataOffset, sourceOffset, 0, !location.empty() } );
+	}
 
-            std::string patchedFileChecksum;
+	// Data before the first patch is copied from the same offset, so must already be there
+	if( inPlacePatches.front().dataOffset > previousSize )
+	{
+		fallbackReason = "resource is shorter than its first patch offset";
 
-            if (!patchedFileChecksumStream.FinishAndRetrieve(patchedFileChecksum))
-            {
-                return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
-            }
+		return Result{ ResultType::SUCCESS };
+	}
 
-            if (patchedFileChecksum != destinationExpectedChecksum)
-            {
-                return Result{ ResultType::UNEXPECTED_PATCH_CHECKSUM_RESULT };
-            }
+	// Original contents of every range that is overwritten or truncated
+	std::vector<ResourceTools::FileRollbackJournal::Range> changedRanges;
 
+	for( size_t i = 0; i < inPlacePatches.size(); i++ )
+	{
+		InPlacePatch& inPlacePatch = inPlacePatches[i];
 
-            // Copy temp file to replace the old resource file
+		uint64_t end = i + 1 < inPlacePatches.size() ? inPlacePatches[i + 1].dataOffset : targetSize;
 
-            // Open output stream
-            ResourceTools::FileDataStreamOut resourceStreamOut;
+		if( end <= inPlacePatch.dataOffset )
+		{
+			fallbackReason = "patches are not in offset order";
 
-            ResourcePutDataStreamParams patchedResourceResourcePutDataStreamParams;
+			return Result{ ResultType::SUCCESS };
+		}
 
-            patchedResourceResourcePutDataStreamParams.resourceDestinationSettings = params.resourcesToPatchDestinationSettings;
+		inPlacePatch.size = end - inPlacePatch.dataOffset;
 
-            patchedResourceResourcePutDataStreamParams.dataStream = &resourceStreamOut;
+		if( inPlacePatch.hasPatchFile )
+		{
+			if( inPlacePatch.sourceOffset < inPlacePatch.dataOffset )
+			{
+				fallbackReason = "changed data is read from before its offset";
 
-            Result putResourceDataStreamResult = resource->PutDataStream(patchedResourceResourcePutDataStreamParams);
+				return Result{ ResultType::SUCCESS };
+			}
 
-            if (putResourceDataStreamResult.type != ResultType::SUCCESS)
-            {
-                return putResourceDataStreamResult;
-            }
+			changedRanges.push_back( { inPlacePatch.dataOffset, inPlacePatch.size } );
+		}
+		else
+		{
+			uintmax_t matchSize{ 0 };
 
+			Result getMatchSizeResult = inPlacePatch.patch->GetUncompressedSize( matchSize );
 
-            // Open input stream
-            ResourceTools::FileDataStreamIn tempPatchedResourceIn(m_maxInputChunkSize.GetValue());
+			if( getMatchSizeResult.type != ResultType::SUCCESS )
+			{
+				return getMatchSizeResult;
+			}
 
-            if (!tempPatchedResourceIn.StartRead(params.temporaryFilePath))
-            {
-                return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-            }
+			// Matching data must already be at its offset and fill the region up to the next patch
+			if( inPlacePatch.sourceOffset != inPlacePatch.dataOffset || matchSize != inPlacePatch.size || end > previousSize )
+			{
+				fallbackReason = "unchanged data moves offset";
 
-            while (!tempPatchedResourceIn.IsFinished())
-            {
-                std::string data;
+				return Result{ ResultType::SUCCESS };
+			}
+		}
+	}
 
-                if (!(tempPatchedResourceIn >> data))
-                {
-                    return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-                }
+	if( targetSize < previousSize )
+	{
+		changedRanges.push_back( { targetSize, previousSize - targetSize } );
+	}
 
-                if (!(resourceStreamOut << data))
-                {
-                    return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
-                }
-            }
+	// The resource is unchanged if the journal could not be written
+	if( !journal.Begin( changedRanges ) )
+	{
+		fallbackReason = "rollback journal could not be written";
 
-            resourceStreamOut.Finish();
-        }
-    }
+		return Result{ ResultType::SUCCESS };
+	}
+
+	ResourceTools::ChecksumStream patchedFileChecksumStream( GetResourceToolsChecksumAlgorithm( checksumAlgorithm ) );
+
+	auto getPatchData = [this, &params]( const PatchResourceInfo* patch, std::string& patchData ) {
+		return GetPatchData( params, patch, patchData ).type == ResultType::SUCCESS;
+	};
+
+	bool patched = WriteInPlacePatches( getPatchData, inPlacePatches, resourcePath, previousSize, m_maxInputChunkSize.GetValue(), patchedFileChecksumStream );
+
+	if( patched )
+	{
+		std::filesystem::resize_file( resourcePath, targetSize, error );
+
+		patched = !error;
+	}
+
+	ResourceTools::Digest128 patchedFileChecksum;
+
+	if( !patched || !patchedFileChecksumStream.FinishAndRetrieve( patchedFileChecksum ) || patchedFileChecksum != expectedChecksum )
+	{
+		// Leaves the resource as it was to be rebuilt in full
+		if( !journal.RollBack() )
+		{
+			return Result{ ResultType::FAILED_TO_ROLL_BACK_PATCH };
+		}
+
+		fallbackReason = patched ? "checksum of patched resource did not match" : "patches could not be written";
+
+		return Result{ ResultType::SUCCESS };
+	}
+
+	if( !journal.Commit() )
+	{
+		return Result{ ResultType::FAILED_TO_SAVE_FILE };
+	}
+
+	appliedInPlace = true;
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result PatchResourceGroup::PatchResourceGroupImpl::ApplyResource( const PatchApplyParams& params, ResourceInfo* resource, ChecksumAlgorithm checksumAlgorithm, const std::filesystem::path& temporaryFilePath, StatusSettings& statusSettings, std::mutex* statusMutex /* = nullptr */ ) const
+{
+	// See if there is a patch available for resource
+	std::vector<const PatchResourceInfo*> patchesForResource;
+
+	Result getTargetResourcePatchesResult = GetTargetResourcePatches( resource, patchesForResource );
+
+	if( getTargetResourcePatchesResult.type != ResultType::SUCCESS )
+	{
+		return getTargetResourcePatchesResult;
+	}
+
+	if( params.applyInPlace )
+	{
+		bool appliedInPlace{ false };
+
+		std::string fallbackReason;
+
+		Result applyInPlaceResult = ApplyResourceInPlace( params, resource, patchesForResource, checksumAlgorithm, appliedInPlace, fallbackReason );
+
+		if( applyInPlaceResult.type != ResultType::SUCCESS )
+		{
+			return applyInPlaceResult;
+		}
+
+		if( statusSettings.RequiresStatusUpdates() && ( appliedInPlace || !fallbackReason.empty() ) )
+		{
+			std::filesystem::path relativePath;
+
+			if( resource->GetRelativePath( relativePath ).type != ResultType::SUCCESS )
+			{
+				return Result{ ResultType::FAIL };
+			}
+
+			std::string message = appliedInPlace ? "Patched in place: " + relativePath.string() : "Could not patch in place, " + fallbackReason + ", rebuilding: " + relativePath.string();
+
+			std::unique_lock<std::mutex> statusLock;
+
+			if( statusMutex )
+			{
+				statusLock = std::unique_lock<std::mutex>( *statusMutex );
+			}
+
+			statusSettings.Update( CarbonResources::StatusProgressType::UNBOUNDED, 0, 0, message );
+		}
+
+		if( appliedInPlace )
+		{
+			return Result{ ResultType::SUCCESS };
+		}
+	}
+
+
+	// Patched resource is written beside its destination and renamed into place once verified
+	// Destinations that transform the data fall back to copying from the temp file
+	std::filesystem::path destinationPath;
+
+	bool writeToDestination = params.applyDirectlyToDestination && resource->GetLocalDestinationPath( params.resourcesToPatchDestinationSettings, destinationPath ).type == ResultType::SUCCESS;
+
+	std::filesystem::path patchedResourcePath = temporaryFilePath;
+
+	if( writeToDestination )
+	{
+		patchedResourcePath = destinationPath;
+
+		patchedResourcePath += ".patching";
+	}
+
+	// Removes a partially patched resource on failure, declared before the stream so it is closed first
+	ResourceTools::ScopedFile patchedResourceScope( patchedResourcePath );
+
+	// Open a stream to write a temp file of the patched resource
+	ResourceTools::FileDataStreamOut temporaryResourceDataStreamOut;
+
+	if( !temporaryResourceDataStreamOut.StartWrite( patchedResourcePath ) )
+	{
+		return Result{ ResultType::FAILED_TO_OPEN_FILE };
+	}
+
+	// Incrementally calculate checksum for temporary patch file
+	ResourceTools::ChecksumStream patchedFileChecksumStream( GetResourceToolsChecksumAlgorithm( checksumAlgorithm ) );
+
+	if( patchesForResource.size() > 0 )
+	{
+		// Open stream for resource
+		auto resourceDataStreamIn = std::make_shared<ResourceTools::FileDataStreamIn>( m_maxInputChunkSize.GetValue() );
+
+		ResourceGetDataStreamParams resourceDataStreamParams;
+
+		resourceDataStreamParams.resourceSourceSettings = params.resourcesToPatchSourceSettings;
+
+		resourceDataStreamParams.dataStream = resourceDataStreamIn;
+
+		Result getResourceDataStream = resource->GetDataStream( resourceDataStreamParams );
+
+		if( getResourceDataStream.type != ResultType::SUCCESS )
+		{
+			return getResourceDataStream;
+		}
+
+
+		for( auto patchIter = patchesForResource.begin(); patchIter != patchesForResource.end(); patchIter++ )
+		{
+
+			const PatchResourceInfo* patch = ( *patchIter );
+
+			// Patch found, Retreive and apply
+			std::string patchData;
+
+			std::string location;
+			Result patchGetLocationResult = patch->GetLocation( location );
+			if( patchGetLocationResult.type != ResultType::SUCCESS )
+			{
+				return patchGetLocationResult;
+			}
+			bool hasPatchFile{ !location.empty() };
+
+			if( hasPatchFile )
+			{
+				Result getPatchDataResult = GetPatchData( params, patch, patchData );
+
+				if( getPatchDataResult.type != ResultType::SUCCESS )
+				{
+					return getPatchDataResult;
+				}
+			}
+
+			// Get previous data
+			uintmax_t dataOffset;
+			uintmax_t sourceOffset;
+			Result getPatchDataOffset = patch->GetDataOffset( dataOffset );
+
+			if( getPatchDataOffset.type != ResultType::SUCCESS )
+			{
+				return getPatchDataOffset;
+			}
+
+			Result getPatchSourceOffset = patch->GetSourceOffset( sourceOffset );
+			if( getPatchSourceOffset.type != ResultType::SUCCESS )
+			{
+				return getPatchSourceOffset;
+			}
+
+			std::string previousResourceData;
+
+			// Get previous size of resource
+			uintmax_t previousUncompressedSize;
+
+			Result getPreviousUncompressedSize = resource->GetUncompressedSize( previousUncompressedSize );
+
+			if( getPreviousUncompressedSize.type != ResultType::SUCCESS )
+			{
+				return getPreviousUncompressedSize;
+			}
+
+			if( dataOffset < previousUncompressedSize )
+			{
+				int64_t previousSourcePosition = resourceDataStreamIn->GetCurrentPosition();
+				// Get to location of patch, unchanged data is copied straight from the resource
+				if( temporaryResourceDataStreamOut.GetFileSize() < dataOffset )
+				{
+					uint64_t unchangedSize = dataOffset - temporaryResourceDataStreamOut.GetFileSize();
+
+					if( previousSourcePosition + unchangedSize > resourceDataStreamIn->Size() )
+					{
+						return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
+					}
+
+					// Also adds to incremental checksum calculation
+					if( !temporaryResourceDataStreamOut.CopySpan( resourceDataStreamIn->GetPath(), previousSourcePosition, unchangedSize, patchedFileChecksumStream ) )
+					{
+						return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
+					}
+					previousSourcePosition += unchangedSize;
+				}
+				if( resourceDataStreamIn->IsFinished() )
+				{
+					resourceDataStreamIn->StartRead( resourceDataStreamIn->GetPath() );
+				}
+				resourceDataStreamIn->Seek( previousSourcePosition );
+
+
+				// Apply the patch to the previous data
+				std::string patchedResourceData;
+
+				if( hasPatchFile )
+				{
+					// Apply patch to data
+					resourceDataStreamIn->Seek( sourceOffset );
+					if( !( *resourceDataStreamIn >> previousResourceData ) )
+					{
+						return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
+					}
+					if( !ResourceTools::ApplyPatch( previousResourceData, patchData, patchedResourceData ) )
+					{
+						return Result{ ResultType::FAILED_TO_APPLY_PATCH };
+					}
+					// Write the patch result to file
+					if( !( temporaryResourceDataStreamOut << patchedResourceData ) )
+					{
+						return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
+					}
+
+					// Add to incremental checksum calculation
+					if( !( patchedFileChecksumStream << patchedResourceData ) )
+					{
+						return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
+					}
+				}
+				else
+				{
+					uintmax_t unCompressedSize{ 0 };
+					Result getUncompressedSizeResult = patch->GetUncompressedSize( unCompressedSize );
+					if( getUncompressedSizeResult.type != ResultType::SUCCESS )
+					{
+						return getUncompressedSizeResult;
+					}
+
+					if( sourceOffset + unCompressedSize > resourceDataStreamIn->Size() )
+					{
+						return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
+					}
+
+					// Copy the matching data from the source file, also adds to incremental checksum calculation
+					if( !temporaryResourceDataStreamOut.CopySpan( resourceDataStreamIn->GetPath(), sourceOffset, unCompressedSize, patchedFileChecksumStream ) )
+					{
+						return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
+					}
+
+					// The resource stream moves on by a chunk for each chunk of matching data, as it did when the data was read in chunks
+					uint64_t chunkSize = m_maxInputChunkSize.GetValue();
+					uint64_t matchingChunkCount = ( unCompressedSize + chunkSize - 1 ) / chunkSize;
+
+					if( !resourceDataStreamIn->IsFinished() && matchingChunkCount > 0 )
+					{
+						size_t resourcePosition = std::min<uint64_t>( resourceDataStreamIn->Size(), resourceDataStreamIn->GetCurrentPosition() + matchingChunkCount * chunkSize );
+
+						resourceDataStreamIn->Seek( resourcePosition );
+
+						if( resourcePosition == resourceDataStreamIn->Size() )
+						{
+							resourceDataStreamIn->Finish();
+						}
+					}
+				}
+			}
+			else
+			{
+				// New data, append on to end
+				if( !( temporaryResourceDataStreamOut << previousResourceData ) )
+				{
+					return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
+				}
+
+				// Add to incremental checksum calculation
+				if( !( patchedFileChecksumStream << previousResourceData ) )
+				{
+					return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
+				}
+			}
+		}
+
+		// Stream out the remaining expected data
+		uintmax_t expectedResourceSize = 0;
+
+		Result getResourceUncompressedSizeResult = resource->GetUncompressedSize( expectedResourceSize );
+
+		if( getResourceUncompressedSizeResult.type != ResultType::SUCCESS )
+		{
+			return getResourceUncompressedSizeResult;
+		}
+
+		temporaryResourceDataStreamOut.Finish();
+	}
+	else
+	{
+		// No Patch found, indicates this is just a new file
+		// Just replace file directly
+		auto resourceStreamIn = std::make_shared<ResourceTools::FileDataStreamIn>( m_maxInputChunkSize.GetValue() );
+
+		ResourceGetDataStreamParams resourceGetDataParams;
+
+		resourceGetDataParams.resourceSourceSettings = params.nextBuildResourcesSourceSettings;
+
+		resourceGetDataParams.dataStream = resourceStreamIn;
+
+		Result resourceGetDataResult = resource->GetDataStream( resourceGetDataParams );
+
+		if (resourceGetDataResult.type != ResultType::SUCCESS)
+		{
+			return resourceGetDataResult;
+		}
+
+		while (!resourceStreamIn->IsFinished())
+		{
+			std::string resourceData;
+
+			if (!(*resourceStreamIn >> resourceData))
+			{
+				return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
+			}
+
+			if (!(temporaryResourceDataStreamOut << resourceData))
+			{
+				return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
+			}
+
+			// Add to incremental checksum calculation
+			if (!(patchedFileChecksumStream << resourceData))
+			{
+				return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
+			}
+		}
+
+		temporaryResourceDataStreamOut.Finish();
+	}
+
+
+	// Test checksum against expected
+	ResourceTools::Digest128 destinationExpectedChecksum;
+
+	Result getChecksumResult = resource->GetChecksum(destinationExpectedChecksum);
+
+	if (getChecksumResult.type != ResultType::SUCCESS)
+	{
+		return getChecksumResult;
+	}
+
+	ResourceTools::Digest128 patchedFileChecksum;
+
+	if (!patchedFileChecksumStream.FinishAndRetrieve(patchedFileChecksum))
+	{
+		return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
+	}
+
+	if (patchedFileChecksum != destinationExpectedChecksum)
+	{
+		return Result{ ResultType::UNEXPECTED_PATCH_CHECKSUM_RESULT };
+	}
+
+	if( writeToDestination )
+	{
+		// Streams of the resource being replaced have been closed, so it can be replaced even when patching in place
+		std::error_code ec;
+
+		std::filesystem::rename( patchedResourcePath, destinationPath, ec );
+
+		if( ec )
+		{
+			return Result{ ResultType::FAILED_TO_SAVE_FILE };
+		}
+
+		return Result{ ResultType::SUCCESS };
+	}
+
+
+	// Copy temp file to replace the old resource file
+
+	// Open output stream
+	ResourceTools::FileDataStreamOut resourceStreamOut;
+
+	ResourcePutDataStreamParams patchedResourceResourcePutDataStreamParams;
+
+	patchedResourceResourcePutDataStreamParams.resourceDestinationSettings = params.resourcesToPatchDestinationSettings;
+
+	patchedResourceResourcePutDataStreamParams.dataStream = &resourceStreamOut;
+
+	Result putResourceDataStreamResult = resource->PutDataStream(patchedResourceResourcePutDataStreamParams);
+
+	if (putResourceDataStreamResult.type != ResultType::SUCCESS)
+	{
+		return putResourceDataStreamResult;
+	}
+
+
+	// Open input stream
+	ResourceTools::FileDataStreamIn tempPatchedResourceIn(m_maxInputChunkSize.GetValue());
+
+	if (!tempPatchedResourceIn.StartRead(temporaryFilePath))
+	{
+		return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
+	}
+
+	while (!tempPatchedResourceIn.IsFinished())
+	{
+		std::string data;
+
+		if (!(tempPatchedResourceIn >> data))
+		{
+			return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
+		}
+
+		if (!(resourceStreamOut << data))
+		{
+			return Result{ ResultType::FAILED_TO_WRITE_TO_STREAM };
+		}
+	}
+
+	resourceStreamOut.Finish();
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result PatchResourceGroup::PatchResourceGroupImpl::ApplyResourcesParallel( const PatchApplyParams& params, const std::vector<ResourceInfo*>& resources, ChecksumAlgorithm checksumAlgorithm, unsigned int threadCount, StatusSettings& statusSettings ) const
+{
+	size_t resourceCount = resources.size();
+
+	// Workers patch resources in any order, results are checked
+	// and progress reported in resource order on this thread
+	std::vector<Result> results( resourceCount, Result{ ResultType::SUCCESS } );
+
+	std::vector<bool> processed( resourceCount, false );
+
+	std::mutex processedMutex;
+
+	std::condition_variable processedCondition;
+
+	// Status callbacks are not thread safe, every update made once workers are started holds this
+	std::mutex statusMutex;
+
+	std::atomic<size_t> nextResource = 0;
+
+	std::atomic<bool> cancelled = false;
+
+	auto worker = [&]( unsigned int workerIndex ) {
+		// Each worker writes patched resources to its own temporary file
+		std::filesystem::path workerTemporaryFilePath = params.temporaryFilePath;
+
+		workerTemporaryFilePath += "." + std::to_string( workerIndex );
+
+		// Will be removed when falls out of scope
+		ResourceTools::ScopedFile temporaryFileScope( workerTemporaryFilePath );
+
+		while( !cancelled )
+		{
+			size_t resourceIndex = nextResource++;
+
+			if( resourceIndex >= resourceCount )
+			{
+				return;
+			}
+
+			Result result = ApplyResource( params, resources[resourceIndex], checksumAlgorithm, workerTemporaryFilePath, statusSettings, &statusMutex );
+
+			{
+				std::lock_guard<std::mutex> lock( processedMutex );
+
+				results[resourceIndex] = result;
+
+				processed[resourceIndex] = true;
+
+				// Resources already being patched are finished but no more are started
+				if( result.type != ResultType::SUCCESS )
+				{
+					cancelled = true;
+				}
+			}
+
+			processedCondition.notify_all();
+		}
+	};
+
+	std::vector<std::thread> workers;
+
+	for( unsigned int i = 0; i < threadCount; i++ )
+	{
+		workers.emplace_back( worker, i );
+	}
+
+	Result result{ ResultType::SUCCESS };
+
+	for( size_t resourceIndex = 0; resourceIndex < resourceCount; resourceIndex++ )
+	{
+		{
+			std::unique_lock<std::mutex> lock( processedMutex );
+
+			processedCondition.wait( lock, [&]() { return processed[resourceIndex] || cancelled; } );
+
+			if( !processed[resourceIndex] )
+			{
+				break;
+			}
+		}
+
+		if( results[resourceIndex].type != ResultType::SUCCESS )
+		{
+			result = results[resourceIndex];
+
+			break;
+		}
+
+		if( statusSettings.RequiresStatusUpdates() )
+		{
+			std::filesystem::path relativePath;
+
+			if( resources[resourceIndex]->GetRelativePath( relativePath ).type != ResultType::SUCCESS )
+			{
+				result = Result{ ResultType::FAIL };
+
+				break;
+			}
+
+			float step = static_cast<float>( 100.0 / resourceCount );
+			float percentage = static_cast<float>( step * resourceIndex );
+
+			std::string message = "Patching: " + relativePath.string();
+
+			std::lock_guard<std::mutex> statusLock( statusMutex );
+
+			statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, message );
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( processedMutex );
+
+		cancelled = true;
+	}
+
+	processedCondition.notify_all();
+
+	for( std::thread& workerThread : workers )
+	{
+		workerThread.join();
+	}
+
+	// A failure found while waiting on an earlier resource is reported once all workers have stopped
+	if( result.type == ResultType::SUCCESS )
+	{
+		for( size_t resourceIndex = 0; resourceIndex < resourceCount; resourceIndex++ )
+		{
+			if( processed[resourceIndex] && results[resourceIndex].type != ResultType::SUCCESS )
+			{
+				return results[resourceIndex];
+			}
+		}
+	}
+
+	return result;
+}
+
+Result PatchResourceGroup::PatchResourceGroupImpl::Apply( const PatchApplyParams& params, StatusSettings& statusSettings )
+{
+	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 10, "Applying Patch." );
+
+	// Will be removed when falls out of scope
+	ResourceTools::ScopedFile temporaryFileScope( params.temporaryFilePath );
+
+	ResourceGroupInfo* resourceGroupResource = m_resourceGroupParameter.GetValue();
+
+
+	// Load the resourceGroup from the resourceGroupResource
+	std::string resourceGroupData;
+
+	ResourceGetDataParams resourceGroupDataParams;
+
+	resourceGroupDataParams.resourceSourceSettings = params.patchBinarySourceSettings;
+
+	resourceGroupDataParams.data = &resourceGroupData;
+
+	Result resourceGroupGetDataResult = m_resourceGroupParameter.GetValue()->GetData( resourceGroupDataParams );
+
+	if( resourceGroupGetDataResult.type != ResultType::SUCCESS )
+	{
+		return resourceGroupGetDataResult;
+	}
+
+	ResourceGroupImpl resourceGroup;
+
+	// Built for each apply so it always matches the patches in the group, however they were added
+	Result buildTargetResourcePatchIndexResult = BuildTargetResourcePatchIndex();
+
+	if( buildTargetResourcePatchIndexResult.type != ResultType::SUCCESS )
+	{
+		return buildTargetResourcePatchIndexResult;
+	}
+
+	Result updateSharedPatchDataResult = UpdateSharedPatchData( params );
+
+	if( updateSharedPatchDataResult.type != ResultType::SUCCESS )
+	{
+		return updateSharedPatchDataResult;
+	}
+
+    {
+		StatusSettings importFromDataStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 10, "Applying Patch.", &importFromDataStatusSettings );
+
+		Result resourceGroupImportFromDataResult = resourceGroup.ImportFromData( resourceGroupData, importFromDataStatusSettings );
+
+		if( resourceGroupImportFromDataResult.type != ResultType::SUCCESS )
+		{
+			return resourceGroupImportFromDataResult;
+		}
+	}
+    {
+		StatusSettings patchingStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 20, 70, "Applying Patch.", &patchingStatusSettings );
+
+		auto numResources = resourceGroup.GetSize();
+		int numProcessed = 0;
+
+		unsigned int threadCount = params.threadCount;
+
+		if( threadCount == 0 )
+		{
+			threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+		}
+
+		threadCount = static_cast<unsigned int>( std::min<size_t>( threadCount, numResources ) );
+
+		if( threadCount > 1 )
+		{
+			std::vector<ResourceInfo*> resources( resourceGroup.begin(), resourceGroup.end() );
+
+			Result applyResourcesResult = ApplyResourcesParallel( params, resources, resourceGroup.GetChecksumAlgorithm(), threadCount, patchingStatusSettings );
+
+			if( applyResourcesResult.type != ResultType::SUCCESS )
+			{
+				return applyResourcesResult;
+			}
+		}
+		else
+		{
+			for( ResourceInfo* resource : resourceGroup )
+			{
+				if( patchingStatusSettings.RequiresStatusUpdates() )
+				{
+					std::filesystem::path relativePath;
+
+					if( resource->GetRelativePath( relativePath ).type != ResultType::SUCCESS )
+					{
+						return Result{ ResultType::FAIL };
+					}
+
+					float step = static_cast<float>( 100.0 / numResources );
+					float percentage = static_cast<float>( step * numProcessed );
+
+					std::string message = "Patching: " + relativePath.string();
+
+					patchingStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, message );
+
+					numProcessed++;
+				}
+
+				Result applyResourceResult = ApplyResource( params, resource, resourceGroup.GetChecksumAlgorithm(), params.temporaryFilePath, patchingStatusSettings );
+
+				if( applyResourceResult.type != ResultType::SUCCESS )
+				{
+					return applyResourceResult;
+				}
+			}
+		}
+	}
+
+	// Shared data of patches not needed by any resource is still held
+	m_sharedPatchData.clear();
 
     {
 		StatusSettings removingFilesStatusSettings;
@@ -12,6 +12,12 @@
 
 #include "ResourceInfo/PatchResourceInfo.h"
 
+#include <memory>
+
+#include <mutex>
+
+#include <unordered_map>
+
 namespace CarbonResources
 {
 
@@ -43,14 +49,52 @@ private:
 
 	virtual Result ExportGroupSpecialisedYaml( YAML::Emitter& out, VersionInternal outputDocumentVersion ) const override;
 
+	// Indexes the patches of the group by target resource so Apply does not search every patch for each resource
+	Result BuildTargetResourcePatchIndex();
+
 	Result GetTargetResourcePatches( const ResourceInfo* targetResource, std::vector<const PatchResourceInfo*>& patches ) const;
 
+	// Counts the patches sharing each stored location, data shared by several patches is then held in memory between them
+	Result UpdateSharedPatchData( const PatchApplyParams& params );
+
+	// Retrieves the stored data of a patch, safe to call from multiple threads
+	Result GetPatchData( const PatchApplyParams& params, const PatchResourceInfo* patch, std::string& patchData ) const;
+
+	// Patches a single resource via temporaryFilePath and writes it to the destination, safe to call from multiple threads with separate temporary files
+	// Reports through statusSettings whether the resource was patched in place or why it was rebuilt instead, holding statusMutex if given so threads can share statusSettings
+	Result ApplyResource( const PatchApplyParams& params, ResourceInfo* resource, ChecksumAlgorithm checksumAlgorithm, const std::filesystem::path& temporaryFilePath, StatusSettings& statusSettings, std::mutex* statusMutex = nullptr ) const;
+
+	// Rewrites only the changed ranges of a resource whose source is also its destination, possible when every unchanged region keeps its offset
+	// appliedInPlace is false when the patches or destination do not allow this, the resource is then left as it was for full reconstruction
+	// fallbackReason then describes why, it is left empty for a resource without patches
+	Result ApplyResourceInPlace( const PatchApplyParams& params, ResourceInfo* resource, const std::vector<const PatchResourceInfo*>& patches, ChecksumAlgorithm checksumAlgorithm, bool& appliedInPlace, std::string& fallbackReason ) const;
+
+	Result ApplyResourcesParallel( const PatchApplyParams& params, const std::vector<ResourceInfo*>& resources, ChecksumAlgorithm checksumAlgorithm, unsigned int threadCount, StatusSettings& statusSettings ) const;
+
 protected:
 	DocumentParameter<uintmax_t> m_maxInputChunkSize = DocumentParameter<uintmax_t>( MAX_INPUT_CHUNK_SIZE, TypeId() );
 
 	DocumentParameter<ResourceGroupInfo*> m_resourceGroupParameter = DocumentParameter<ResourceGroupInfo*>( RESOURCE_GROUP_RESOURCE, TypeId() );
 
 	DocumentParameterCollection<std::filesystem::path> m_removedResources = DocumentParameterCollection<std::filesystem::path>( REMOVED_RESOURCE_RELATIVE_PATHS, TypeId() );
+
+	// Patches of each target resource keyed on generic relative path, in the order they appear in the group
+	std::unordered_map<std::string, std::vector<const PatchResourceInfo*>> m_targetResourcePatches;
+
+	// Data stored once for several patches, retrieved by the first of them and released after the last
+	struct SharedPatchData
+	{
+		std::mutex mutex;
+
+		size_t remainingUses = 0;
+
+		bool retrieved = false;
+
+		std::string data;
+	};
+
+	// Shared patch data keyed on location, only locations used by more than one patch are present
+	mutable std::unordered_map<std::string, std::unique_ptr<SharedPatchData>> m_sharedPatchData;
 };
 
 }
@@ -8,7 +8,7 @@
 #include <BundleStreamOut.h>
 #include <FileDataStreamIn.h>
 #include <CompressedFileDataStreamOut.h>
-#include <Md5ChecksumStream.h>
+#include <ChecksumStream.h>
 #include <GzipCompressionStream.h>
 #include "ResourceInfo/PatchResourceGroupInfo.h"
 #include "ResourceInfo/BundleResourceGroupInfo.h"
@@ -18,7 +18,17 @@
 #include "PatchResourceGroupImpl.h"
 #include "BundleResourceGroupImpl.h"
 #include "ChunkIndex.h"
+#include "ChunkIndexCache.h"
+#include "ContentDefinedChunking.h"
+#include "MemoryMappedFile.h"
+#include "PatchPipeline.h"
 #include "ResourceGroupFactory.h"
+#include "FileFingerprintCache.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace CarbonResources
 {
@@ -26,10 +36,12 @@ namespace CarbonResources
 
 ResourceGroup::ResourceGroupImpl::ResourceGroupImpl()
 {
-	m_versionParameter = VersionInternal( S_DOCUMENT_VERSION );
+	m_versionParameter = VersionInternal( S_MAX_DOCUMENT_VERSION );
 
 	m_type = TypeId();
 
+	m_checksumAlgorithm = ChecksumAlgorithm::MD5;
+
 	m_numberOfResources = 0;
 
 	m_totalResourcesSizeCompressed = 0;
@@ -63,1342 +75,2699 @@ Result ResourceGroup::ResourceGroupImpl::CreateFromDirectory( const CreateResour
 		return Result{ ResultType::DOCUMENT_VERSION_UNSUPPORTED };
 	}
 
-	// Walk directory and create a resource from each file using data
-	auto recursiveDirectoryIter = std::filesystem::recursive_directory_iterator( params.directory );
+	// Older document versions have no way to record the checksum algorithm so are MD5 only
+	if( params.checksumAlgorithm != ChecksumAlgorithm::MD5 && !m_checksumAlgorithm.IsParameterExpectedInDocumentVersion( documentVersion ) )
+	{
+		return Result{ ResultType::CHECKSUM_ALGORITHM_UNSUPPORTED_BY_DOCUMENT_VERSION };
+	}
+
+	m_checksumAlgorithm = params.checksumAlgorithm;
 
-    {
-		StatusSettings fileProcessingInnerStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Processing Files", &fileProcessingInnerStatusSettings );
+	// Walk directory and collect files up front
+	// Resources are added in the order they are walked regardless of how they are processed
+	std::vector<std::filesystem::directory_entry> entries;
 
-		for( const std::filesystem::directory_entry& entry : recursiveDirectoryIter )
+	for( const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator( params.directory ) )
+	{
+		if( entry.is_regular_file() )
 		{
-			if( entry.is_regular_file() )
-			{
-				// Update status
-				fileProcessingInnerStatusSettings.Update( CarbonResources::StatusProgressType::UNBOUNDED, 0, 0, "Processing File: " + entry.path().string() );
+			entries.push_back( entry );
+		}
+	}
 
-				// Create resource
-				auto fileSize = entry.file_size();
+	unsigned int threadCount = params.threadCount;
 
-				if( fileSize < params.resourceStreamThreshold )
-				{
-					// Create resource from data
-					ResourceInfoParams resourceParams;
+	if( threadCount == 0 )
+	{
+		threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+	}
 
-					resourceParams.relativePath = std::filesystem::relative( entry.path(), params.directory );
+	threadCount = static_cast<unsigned int>( std::min<size_t>( threadCount, entries.size() ) );
 
-					resourceParams.binaryOperation = ResourceTools::CalculateBinaryOperation( entry.path() );
+	DirectoryProcessingContext context;
 
-					resourceParams.prefix = params.resourcePrefix;
+	// Optional fingerprint cache, a missing or unreadable cache results in a full pass
+	std::unique_ptr<FileFingerprintCache> fingerprintCache;
 
-					ResourceInfo* resource = new ResourceInfo( resourceParams );
+	if( !params.fileFingerprintCachePath.empty() )
+	{
+		fingerprintCache = std::make_unique<FileFingerprintCache>( params.checksumAlgorithm );
 
-					std::string resourceData;
+		fingerprintCache->ImportFromFile( params.fileFingerprintCachePath );
 
-					ResourceGetDataParams resourceGetDataParams;
+		context.fingerprintCache = fingerprintCache.get();
+	}
 
-					resourceGetDataParams.resourceSourceSettings.basePaths = { params.directory };
+	// Optional previous ResourceGroup, trusted entries are used in place of a full pass
+	// Checksums can only be reused if they were generated with the same algorithm
+	if( params.previousResourceGroup && params.previousResourceGroup->m_impl->GetChecksumAlgorithm() == params.checksumAlgorithm )
+	{
+		for( ResourceInfo* previousResource : *params.previousResourceGroup->m_impl )
+		{
+			std::filesystem::path previousRelativePath;
 
-					resourceGetDataParams.resourceSourceSettings.sourceType = ResourceSourceType::LOCAL_RELATIVE;
+			Result getRelativePathResult = previousResource->GetRelativePath( previousRelativePath );
 
-					resourceGetDataParams.data = &resourceData;
+			if( getRelativePathResult.type != ResultType::SUCCESS )
+			{
+				return getRelativePathResult;
+			}
 
-					Result getResourceDataResult = resource->GetData( resourceGetDataParams );
+			context.previousResources[previousRelativePath.generic_string()] = previousResource;
+		}
+	}
 
-					if( getResourceDataResult.type != ResultType::SUCCESS )
-					{
-						return getResourceDataResult;
-					}
+    {
+		StatusSettings fileProcessingInnerStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Processing Files", &fileProcessingInnerStatusSettings );
 
-					Result setParametersFromDataResult = resource->SetParametersFromData( resourceData, params.calculateCompressions );
+		if( threadCount > 1 )
+		{
+			Result createResourcesResult = CreateResourcesFromFilesParallel( params, entries, context, threadCount, fileProcessingInnerStatusSettings );
 
-					if( setParametersFromDataResult.type != ResultType::SUCCESS )
-					{
-						return setParametersFromDataResult;
-					}
+			if( createResourcesResult.type != ResultType::SUCCESS )
+			{
+				return createResourcesResult;
+			}
+		}
+		else
+		{
+			for( const std::filesystem::directory_entry& entry : entries )
+			{
+				// Update status
+				fileProcessingInnerStatusSettings.Update( CarbonResources::StatusProgressType::UNBOUNDED, 0, 0, "Processing File: " + entry.path().string() );
 
-					Result addResourceResult = AddResource( resource );
+				ResourceInfo* resource = nullptr;
 
-					if( addResourceResult.type != ResultType::SUCCESS )
-					{
-						return addResourceResult;
-					}
+				Result createResourceResult = CreateResourceFromFile( params, entry, context, fileProcessingInnerStatusSettings, resource );
 
-					// If resources are set to be exported, then export as specified
-					if( params.exportResources )
-					{
-						ResourcePutDataParams putDataParams;
+				if( createResourceResult.type != ResultType::SUCCESS )
+				{
+					return createResourceResult;
+				}
 
-						putDataParams.resourceDestinationSettings = params.exportResourcesDestinationSettings;
+				Result addResourceResult = AddResource( resource );
 
-						putDataParams.data = &resourceData;
+				if( addResourceResult.type != ResultType::SUCCESS )
+				{
+					return addResourceResult;
+				}
+			}
+		}
+
+		if( !params.calculateCompressions )
+		{
+			m_totalResourcesSizeCompressed.Reset();
+		}
+	}
 
-						Result putDataResult = resource->PutData( putDataParams );
+	if( fingerprintCache )
+	{
+		Result exportFingerprintCacheResult = fingerprintCache->ExportToFile( params.fileFingerprintCachePath );
 
-						if( putDataResult.type != ResultType::SUCCESS )
-						{
-							return putDataResult;
-						}
-					}
-				}
-				else
-				{
-					// Process data via stream
-					ResourceTools::Md5ChecksumStream checksumStream;
-					std::string compressedData;
+		if( exportFingerprintCacheResult.type != ResultType::SUCCESS )
+		{
+			return exportFingerprintCacheResult;
+		}
+	}
 
-					ResourceTools::GzipCompressionStream compressionStream( &compressedData );
+	return Result{ ResultType::SUCCESS };
+}
 
-					ResourceTools::FileDataStreamIn fileStreamIn( params.resourceStreamThreshold );
+Result ResourceGroup::ResourceGroupImpl::CreateResourcesFromFilesParallel( const CreateResourceGroupFromDirectoryParams& params, const std::vector<std::filesystem::directory_entry>& entries, DirectoryProcessingContext& context, unsigned int threadCount, StatusSettings& statusSettings )
+{
+	// Each entry gets a result slot, workers fill slots in any order
+	// and slots are committed to the group in entry order on this thread
+	std::vector<ResourceInfo*> resources( entries.size(), nullptr );
 
-					if( params.calculateCompressions )
-					{
-						if( !compressionStream.Start() )
-						{
-							return Result{ ResultType::FAILED_TO_COMPRESS_DATA };
-						}
-					}
+	std::vector<Result> results( entries.size(), Result{ ResultType::SUCCESS } );
 
-					if( !fileStreamIn.StartRead( entry.path() ) )
-					{
-						return Result{ ResultType::FAILED_TO_OPEN_FILE_STREAM };
-					}
+	std::vector<bool> processed( entries.size(), false );
 
-					uintmax_t compressedDataSize = 0;
+	std::mutex processedMutex;
 
-					while( !fileStreamIn.IsFinished() )
-					{
-						// Update status
-						if( fileProcessingInnerStatusSettings.RequiresStatusUpdates() )
-						{
-							float step = static_cast<float>( 100.0 / fileStreamIn.Size() );
-							float percentage = static_cast<float>( fileStreamIn.GetCurrentPosition() * step );
-							fileProcessingInnerStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, "Percentage Update" );
-						}
-
-						std::string fileData;
-
-						if( !( fileStreamIn >> fileData ) )
-						{
-							return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-						}
-
-						if( !( checksumStream << fileData ) )
-						{
-							return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
-						}
-
-						if( params.calculateCompressions )
-						{
-							if( !( compressionStream << &fileData ) )
-							{
-								return Result{ ResultType::FAILED_TO_COMPRESS_DATA };
-							}
-						}
-
-						compressedDataSize += compressedData.size();
-						compressedData.clear();
-					}
+	std::condition_variable processedCondition;
 
-					if( params.calculateCompressions )
-					{
-						if( !compressionStream.Finish() )
-						{
-							return Result{ ResultType::FAILED_TO_COMPRESS_DATA };
-						}
+	std::atomic<size_t> nextEntry = 0;
 
-						compressedDataSize += compressedData.size();
-						compressedData.clear();
-					}
+	std::atomic<bool> cancelled = false;
 
-					std::string checksum;
+	auto worker = [&]() {
+		// Status callbacks are not thread safe, workers report nothing
+		// and progress is reported as results are committed
+		StatusSettings workerStatusSettings;
 
-					if( !checksumStream.FinishAndRetrieve( checksum ) )
-					{
-						return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
-					}
+		while( !cancelled )
+		{
+			size_t entryIndex = nextEntry++;
 
-					// Create resource from parameters
-					ResourceInfoParams resourceParams;
+			if( entryIndex >= entries.size() )
+			{
+				return;
+			}
 
-					resourceParams.relativePath = std::filesystem::relative( entry.path(), params.directory );
+			results[entryIndex] = CreateResourceFromFile( params, entries[entryIndex], context, workerStatusSettings, resources[entryIndex] );
 
-					resourceParams.uncompressedSize = fileSize;
+			{
+				std::lock_guard<std::mutex> lock( processedMutex );
 
-					resourceParams.compressedSize = compressedDataSize;
+				processed[entryIndex] = true;
+			}
 
-					resourceParams.checksum = checksum;
+			processedCondition.notify_all();
+		}
+	};
 
-					resourceParams.binaryOperation = ResourceTools::CalculateBinaryOperation( entry.path() );
+	std::vector<std::thread> workers;
 
-					Location l;
+	for( unsigned int i = 0; i < threadCount; i++ )
+	{
+		workers.emplace_back( worker );
+	}
 
-					Result calculateLocationResult = l.SetFromRelativePathAndDataChecksum( resourceParams.relativePath, resourceParams.checksum );
+	Result result{ ResultType::SUCCESS };
 
-					if( calculateLocationResult.type != ResultType::SUCCESS )
-					{
-						return calculateLocationResult;
-					}
+	size_t entryIndex = 0;
 
-					resourceParams.location = l.ToString();
+	for( ; entryIndex < entries.size(); entryIndex++ )
+	{
+		{
+			std::unique_lock<std::mutex> lock( processedMutex );
 
-					ResourceInfo* resource = new ResourceInfo( resourceParams );
+			processedCondition.wait( lock, [&]() { return processed[entryIndex]; } );
+		}
 
-					Result addResourceResult = AddResource( resource );
+		// Update status
+		if( statusSettings.RequiresStatusUpdates() )
+		{
+			float step = static_cast<float>( 100.0 / entries.size() );
+			float percentage = static_cast<float>( entryIndex * step );
+			statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, "Processing File: " + entries[entryIndex].path().string() );
+		}
 
-					if( addResourceResult.type != ResultType::SUCCESS )
-					{
-						return addResourceResult;
-					}
+		if( results[entryIndex].type != ResultType::SUCCESS )
+		{
+			result = results[entryIndex];
 
-					// If resources are set to be exported, then export as specified.
-					// This is slow with large files as each need to be streamed again
-					// The problem is that checksum of the whole file needs to be calculated first
-					// in order to get the correct destination CDN path
-					// If compression is not skipped and REMOTE_CDN is chosen as destination then
-					// compression will also be calculated twice.
-					// This can be improved with a refactor but currently this code path not
-					// likely to be relied upon often
-					if( params.exportResources )
-					{
-						ResourcePutDataStreamParams putDataStreamParams;
-
-						// Create the correct file data streaming for the desination
-						std::unique_ptr<ResourceTools::FileDataStreamOut> resourceDataStreamOut;
-
-						if( params.exportResourcesDestinationSettings.destinationType == ResourceDestinationType::REMOTE_CDN )
-						{
-							// REMOTE_CDN requires compression
-							resourceDataStreamOut = std::make_unique<ResourceTools::CompressedFileDataStreamOut>();
-						}
-						else
-						{
-							// Else just stream out uncompressed
-							resourceDataStreamOut = std::make_unique<ResourceTools::FileDataStreamOut>();
-						}
-
-						putDataStreamParams.resourceDestinationSettings = params.exportResourcesDestinationSettings;
-
-						putDataStreamParams.dataStream = resourceDataStreamOut.get();
-
-						Result putDataStreamResult = resource->PutDataStream( putDataStreamParams );
-
-						if( putDataStreamResult.type != ResultType::SUCCESS )
-						{
-							return putDataStreamResult;
-						}
-
-						// Export resource using streaming
-						ResourceTools::FileDataStreamIn fileStreamIn( params.resourceStreamThreshold );
-
-						if( !fileStreamIn.StartRead( entry.path() ) )
-						{
-							return Result{ ResultType::FAILED_TO_OPEN_FILE_STREAM };
-						}
-
-						while( !fileStreamIn.IsFinished() )
-						{
-							std::string data = "";
-
-							if( !( fileStreamIn >> data ) )
-							{
-								return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-							}
-
-							if( !( resourceDataStreamOut->operator<<( data ) ) )
-							{
-								return Result{ ResultType::FAILED_TO_SAVE_TO_STREAM };
-							}
-						}
-
-						if( !resourceDataStreamOut->Finish() )
-						{
-							return Result{ ResultType::FAILED_TO_SAVE_TO_STREAM };
-						}
-					}
-				}
-			}
+			break;
 		}
 
-		if( !params.calculateCompressions )
+		Result addResourceResult = AddResource( resources[entryIndex] );
+
+		resources[entryIndex] = nullptr;
+
+		if( addResourceResult.type != ResultType::SUCCESS )
 		{
-			m_totalResourcesSizeCompressed.Reset();
+			result = addResourceResult;
+
+			break;
 		}
 	}
 
-	return Result{ ResultType::SUCCESS };
-}
+	cancelled = true;
 
-Result ResourceGroup::ResourceGroupImpl::ImportFromData( const std::string& data, StatusSettings& statusSettings, DocumentType documentType /* = DocumentType::YAML */ )
-{
-	switch( documentType )
+	for( std::thread& workerThread : workers )
 	{
-	case DocumentType::CSV:
-#ifdef _MSC_VER
-#pragma warning( push )
-#pragma warning( disable : 4996 ) // Suppress deprecation warning.
-#elif __APPLE__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-#endif
-		return ImportFromCSV( data, statusSettings );
-#ifdef _MSC_VER
-#pragma warning( pop )
-#elif __APPLE__
-#pragma clang diagnostic pop
-#endif
-	case DocumentType::YAML:
-		return ImportFromYamlString( data, statusSettings );
-	default:
-		return Result{ ResultType::UNSUPPORTED_FILE_FORMAT };
+		workerThread.join();
 	}
 
-	return Result{ ResultType::FAIL };
+	// Clean up anything processed but not committed due to an error
+	for( ResourceInfo* resource : resources )
+	{
+		delete resource;
+	}
+
+	return result;
 }
 
-Result ResourceGroup::ResourceGroupImpl::ImportFromFile( const ResourceGroupImportFromFileParams& params, StatusSettings& statusSettings )
+Result ResourceGroup::ResourceGroupImpl::CreateResourceFromFile( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, DirectoryProcessingContext& context, StatusSettings& statusSettings, ResourceInfo*& resourceOut ) const
 {
-	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 20, "Importing Resource Group from file." );
+	resourceOut = nullptr;
 
-	if( params.filename.empty() )
+	std::filesystem::path relativePath = std::filesystem::relative( entry.path(), params.directory );
+
+	// Fingerprint is taken before the file is read so that a modification during processing
+	// results in a mismatch on the next run rather than a stale entry
+	ResourceTools::FileFingerprint fingerprint;
+
+	bool fingerprintValid = context.fingerprintCache && ResourceTools::GetFileFingerprint( entry.path(), fingerprint );
+
+	if( fingerprintValid )
 	{
-		return Result{ ResultType::FILE_NOT_FOUND };
+		FileFingerprintCacheEntry cacheEntry;
+
+		// A cache entry without compressed size cannot be used when compression is requested
+		if( context.fingerprintCache->Find( relativePath, fingerprint, cacheEntry ) && ( cacheEntry.compressedSize > 0 || !params.calculateCompressions ) )
+		{
+			Result createResourceResult = CreateResourceFromKnownParameters( params, entry, fingerprint.size, cacheEntry.checksum, cacheEntry.compressedSize, cacheEntry.location, resourceOut );
+
+			if( createResourceResult.type != ResultType::SUCCESS )
+			{
+				return createResourceResult;
+			}
+
+			context.fingerprintCache->Insert( relativePath, cacheEntry );
+
+			return Result{ ResultType::SUCCESS };
+		}
 	}
 
-	std::string data;
+	Result createResourceFromPreviousResult = CreateResourceFromPreviousResourceGroup( params, entry, relativePath, context, resourceOut );
 
-	if( !ResourceTools::GetLocalFileData( params.filename, data ) )
+	if( createResourceFromPreviousResult.type != ResultType::SUCCESS )
 	{
-		return Result{ ResultType::FAILED_TO_OPEN_FILE };
+		return createResourceFromPreviousResult;
 	}
 
-	// VERSION NEEDS TO BE CHECKED TO ENSURE ITS SUPPORTED ON IMPORT
-	std::filesystem::path filename = params.filename;
+	if( !resourceOut )
+	{
+		Result createResourceResult = CreateResourceFromFileData( params, entry, statusSettings, resourceOut );
 
-	std::string extension = filename.extension().string();
+		if( createResourceResult.type != ResultType::SUCCESS )
+		{
+			return createResourceResult;
+		}
+	}
 
-	Result importResult;
+	if( fingerprintValid )
+	{
+		FileFingerprintCacheEntry cacheEntry;
 
-    {
-		StatusSettings nestedStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 20, 80, "Importing Resource Group from file.", &nestedStatusSettings );
+		cacheEntry.fingerprint = fingerprint;
 
-		if( extension == ".txt" )
-		{
-#ifdef _MSC_VER
-#pragma warning( push )
-#pragma warning( disable : 4996 ) // Suppress deprecation warning.
-#elif __APPLE__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-#endif
-			importResult = ImportFromCSV( data, nestedStatusSettings );
-#ifdef _MSC_VER
-#pragma warning( pop )
-#elif __APPLE__
-#pragma clang diagnostic pop
-#endif
-		}
-		else if( extension == ".yml" || extension == ".yaml" || extension.empty() )
-		{
-			importResult = ImportFromYamlString( data, nestedStatusSettings );
-		}
-		else
+		Result getChecksumResult = resourceOut->GetChecksum( cacheEntry.checksum );
+
+		if( getChecksumResult.type != ResultType::SUCCESS )
 		{
-			return Result{ ResultType::UNSUPPORTED_FILE_FORMAT };
+			return getChecksumResult;
 		}
 
-		if( importResult.type != ResultType::SUCCESS )
+		Result getLocationResult = resourceOut->GetLocation( cacheEntry.location );
+
+		if( getLocationResult.type != ResultType::SUCCESS )
 		{
-			return importResult;
+			return getLocationResult;
 		}
-    }
 
-    return importResult;
+		// Compressed size is not set if compression calculations are skipped
+		// this is stored as 0 and treated as a miss when compression is requested
+		resourceOut->GetCompressedSize( cacheEntry.compressedSize );
+
+		context.fingerprintCache->Insert( relativePath, cacheEntry );
+	}
+
+	return Result{ ResultType::SUCCESS };
 }
 
-Result ResourceGroup::ResourceGroupImpl::ExportToFile( const ResourceGroupExportToFileParams& params, StatusSettings& statusSettings ) const
+Result ResourceGroup::ResourceGroupImpl::CreateResourceFromPreviousResourceGroup( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, const std::filesystem::path& relativePath, const DirectoryProcessingContext& context, ResourceInfo*& resourceOut ) const
 {
-	// Update status
-	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 10, "Exporting Resource Group to file: " + params.filename.string() );
+	resourceOut = nullptr;
 
-	std::string data = "";
+	auto previousResourceIter = context.previousResources.find( relativePath.generic_string() );
 
-	if( params.outputDocumentVersion.major == 0 && params.outputDocumentVersion.minor == 0 )
+	if( previousResourceIter == context.previousResources.end() )
 	{
-		{
-			StatusSettings exportCsvstatusSettings;
-			statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Exporting Resource Group to file: " + params.filename.string(), &exportCsvstatusSettings );
+		return Result{ ResultType::SUCCESS };
+	}
 
+	const ResourceInfo* previousResource = previousResourceIter->second;
 
-			Result exportCsvResult = ExportCsv( params.outputDocumentVersion, data, exportCsvstatusSettings );
-			if( exportCsvResult.type != ResultType::SUCCESS )
-			{
-				return exportCsvResult;
-			}
-		}
+	uintmax_t previousUncompressedSize = 0;
+
+	if( previousResource->GetUncompressedSize( previousUncompressedSize ).type != ResultType::SUCCESS || previousUncompressedSize != entry.file_size() )
+	{
+		return Result{ ResultType::SUCCESS };
 	}
-	else
+
+	if( params.previousResourceGroupTrustPolicy == PreviousResourceGroupTrustPolicy::SIZE_AND_MODIFICATION_TIME )
 	{
-		{
-			StatusSettings exportYamlstatusSettings;
-			statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Exporting Resource Group to file: " + params.filename.string(), &exportYamlstatusSettings );
+		// File must have been last modified before the previous ResourceGroup was created
+		// A modification in the same clock tick can't be ordered so is not trusted
+		std::error_code ec;
 
-			Result exportYamlResult = ExportYaml( params.outputDocumentVersion, data, exportYamlstatusSettings );
+		std::filesystem::file_time_type modificationTime = std::filesystem::last_write_time( entry.path(), ec );
 
-			if( exportYamlResult.type != ResultType::SUCCESS )
-			{
-				return exportYamlResult;
-			}
+		if( ec || modificationTime >= params.previousResourceGroupTimestamp )
+		{
+			return Result{ ResultType::SUCCESS };
 		}
 	}
 
-	if( !ResourceTools::SaveFile( params.filename, data ) )
+	ResourceTools::Digest128 checksum;
+
+	if( previousResource->GetChecksum( checksum ).type != ResultType::SUCCESS )
 	{
-		return Result{ ResultType::FAILED_TO_SAVE_FILE };
+		return Result{ ResultType::SUCCESS };
 	}
 
-	return Result{ ResultType::SUCCESS };
-}
-
-Result ResourceGroup::ResourceGroupImpl::ExportToData( std::string& data, StatusSettings& statusSettings, VersionInternal outputDocumentVersion /* = S_DOCUMENT_VERSION*/ ) const
-{
-	Result exportYamlResult = ExportYaml( outputDocumentVersion, data, statusSettings );
+	uintmax_t compressedSize = 0;
 
-	if( exportYamlResult.type != ResultType::SUCCESS )
+	if( params.calculateCompressions && previousResource->GetCompressedSize( compressedSize ).type != ResultType::SUCCESS )
 	{
-		return exportYamlResult;
+		// Previous ResourceGroup was created without compression, a full pass is required
+		return Result{ ResultType::SUCCESS };
 	}
 
-	return Result{ ResultType::SUCCESS };
+	// Location is recalculated if not present in previous document version
+	std::string location;
+
+	previousResource->GetLocation( location );
+
+	return CreateResourceFromKnownParameters( params, entry, previousUncompressedSize, checksum, compressedSize, location, resourceOut );
 }
 
-Result ResourceGroup::ResourceGroupImpl::ImportFromCSV( const std::string& data, StatusSettings& statusSettings )
+Result ResourceGroup::ResourceGroupImpl::CreateResourceFromKnownParameters( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, uintmax_t uncompressedSize, const ResourceTools::Digest128& checksum, uintmax_t compressedSize, const std::string& location, ResourceInfo*& resourceOut ) const
 {
-	// Status update
-	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 10, "Importing Resource Group from CSV file." );
+	resourceOut = nullptr;
 
-	std::stringstream inputStream;
+	// Matches the parameters that a full pass would produce
+	ResourceInfoParams resourceParams;
 
-	inputStream << data;
+	resourceParams.relativePath = std::filesystem::relative( entry.path(), params.directory );
 
-	std::string stringIn;
+	resourceParams.uncompressedSize = uncompressedSize;
 
-    {
-		StatusSettings detailStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Importing Resource Group from CSV file.", &detailStatusSettings );
+	resourceParams.compressedSize = params.calculateCompressions ? compressedSize : 0;
 
-		while( !inputStream.eof() )
-		{
-			std::getline( inputStream, stringIn );
+	resourceParams.checksum = checksum;
 
-			if( stringIn == "" )
-			{
-				continue;
-			}
+	resourceParams.binaryOperation = ResourceTools::CalculateBinaryOperation( entry.path() );
 
-			std::stringstream ss( stringIn );
+	if( uncompressedSize < params.resourceStreamThreshold )
+	{
+		resourceParams.prefix = params.resourcePrefix;
+	}
 
-			std::string value;
+	resourceParams.location = location;
 
-			char delimiter = ',';
+	if( resourceParams.location.empty() )
+	{
+		Location l;
 
-			ResourceInfoParams resourceParams;
+		Result calculateLocationResult = l.SetFromRelativePathAndDataChecksum( resourceParams.relativePath, checksum );
 
-			if( !std::getline( ss, value, delimiter ) )
-			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
-			}
+		if( calculateLocationResult.type != ResultType::SUCCESS )
+		{
+			return calculateLocationResult;
+		}
 
-			// Split filename and prefix
-			std::string resourcePrefixDelimiter = ":/";
-			std::string filename = value.substr( value.find( resourcePrefixDelimiter ) + resourcePrefixDelimiter.size() );
-			std::string resourcePrefix = value.substr( 0, value.find( ":" ) );
+		resourceParams.location = l.ToString();
+	}
 
-			resourceParams.relativePath = filename;
+	std::unique_ptr<ResourceInfo> resource = std::make_unique<ResourceInfo>( resourceParams );
 
-			resourceParams.prefix = resourcePrefix;
+	if( params.exportResources )
+	{
+		Result exportResourceResult = ExportResourceFromFile( params, entry, *resource );
 
-			if( !std::getline( ss, value, delimiter ) )
-			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
-			}
+		if( exportResourceResult.type != ResultType::SUCCESS )
+		{
+			return exportResourceResult;
+		}
+	}
 
-			resourceParams.location = value;
+	resourceOut = resource.release();
 
-			if( !std::getline( ss, value, delimiter ) )
-			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
-			}
+	return Result{ ResultType::SUCCESS };
+}
 
-			resourceParams.checksum = value;
+Result ResourceGroup::ResourceGroupImpl::CreateResourceFromFileData( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, StatusSettings& statusSettings, ResourceInfo*& resourceOut ) const
+{
+	resourceOut = nullptr;
 
-			if( !std::getline( ss, value, delimiter ) )
-			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
-			}
+	auto fileSize = entry.file_size();
 
-			try
-			{
-				resourceParams.uncompressedSize = std::stoull( value.c_str() );
-			}
-			catch( std::invalid_argument& )
-			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
-			}
-			catch( std::out_of_range& )
-			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
-			}
+	if( fileSize < params.resourceStreamThreshold )
+	{
+		// Create resource from data
+		ResourceInfoParams resourceParams;
 
-			if( !std::getline( ss, value, delimiter ) )
+		resourceParams.relativePath = std::filesystem::relative( entry.path(), params.directory );
+
+		resourceParams.binaryOperation = ResourceTools::CalculateBinaryOperation( entry.path() );
+
+		resourceParams.prefix = params.resourcePrefix;
+
+		std::unique_ptr<ResourceInfo> resource = std::make_unique<ResourceInfo>( resourceParams );
+
+		std::string resourceData;
+
+		ResourceGetDataParams resourceGetDataParams;
+
+		resourceGetDataParams.resourceSourceSettings.basePaths = { params.directory };
+
+		resourceGetDataParams.resourceSourceSettings.sourceType = ResourceSourceType::LOCAL_RELATIVE;
+
+		resourceGetDataParams.data = &resourceData;
+
+		Result getResourceDataResult = resource->GetData( resourceGetDataParams );
+
+		if( getResourceDataResult.type != ResultType::SUCCESS )
+		{
+			return getResourceDataResult;
+		}
+
+		Result setParametersFromDataResult = resource->SetParametersFromData( resourceData, params.checksumAlgorithm, params.calculateCompressions );
+
+		if( setParametersFromDataResult.type != ResultType::SUCCESS )
+		{
+			return setParametersFromDataResult;
+		}
+
+		// If resources are set to be exported, then export as specified
+		if( params.exportResources )
+		{
+			ResourcePutDataParams putDataParams;
+
+			putDataParams.resourceDestinationSettings = params.exportResourcesDestinationSettings;
+
+			putDataParams.data = &resourceData;
+
+			Result putDataResult = resource->PutData( putDataParams );
+
+			if( putDataResult.type != ResultType::SUCCESS )
 			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+				return putDataResult;
 			}
+		}
 
-			try
+		resourceOut = resource.release();
+	}
+	else
+	{
+		// Process data via stream
+		ResourceTools::ChecksumStream checksumStream( GetResourceToolsChecksumAlgorithm( params.checksumAlgorithm ) );
+		std::string compressedData;
+
+		ResourceTools::GzipCompressionStream compressionStream( &compressedData );
+
+		ResourceTools::FileDataStreamIn fileStreamIn( params.resourceStreamThreshold );
+
+		if( params.calculateCompressions )
+		{
+			if( !compressionStream.Start() )
 			{
-				resourceParams.compressedSize = std::stoull( value.c_str() );
+				return Result{ ResultType::FAILED_TO_COMPRESS_DATA };
 			}
-			catch( std::invalid_argument& )
+		}
+
+		if( !fileStreamIn.StartRead( entry.path() ) )
+		{
+			return Result{ ResultType::FAILED_TO_OPEN_FILE_STREAM };
+		}
+
+		uintmax_t compressedDataSize = 0;
+
+		while( !fileStreamIn.IsFinished() )
+		{
+			// Update status
+			if( statusSettings.RequiresStatusUpdates() )
 			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+				float step = static_cast<float>( 100.0 / fileStreamIn.Size() );
+				float percentage = static_cast<float>( fileStreamIn.GetCurrentPosition() * step );
+				statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, "Percentage Update" );
 			}
-			catch( std::out_of_range& )
+
+			std::string fileData;
+
+			if( !( fileStreamIn >> fileData ) )
 			{
-				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+				return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
 			}
 
-			if( !std::getline( ss, value, delimiter ) )
+			if( !( checksumStream << fileData ) )
 			{
-				resourceParams.binaryOperation = 0;
+				return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
 			}
-			else
-			{
-				try
-				{
-					unsigned long long valueToULongLong = std::stoull( value.c_str() );
-
-					if( valueToULongLong > std::numeric_limits<uint32_t>::max() )
-					{
-						return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
-					}
 
-					resourceParams.binaryOperation = static_cast<uint32_t>( valueToULongLong );
-				}
-				catch( std::invalid_argument& )
-				{
-					return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
-				}
-				catch( std::out_of_range& )
+			if( params.calculateCompressions )
+			{
+				if( !( compressionStream << &fileData ) )
 				{
-					return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+					return Result{ ResultType::FAILED_TO_COMPRESS_DATA };
 				}
 			}
 
-			// ResourceGroup gets upgraded to 0.1.0
-			m_versionParameter = VersionInternal{ 0, 1, 0 };
-
-			// Create a Resource
-			ResourceInfo* resource = new ResourceInfo( resourceParams );
-
-			Result addResourceResult = AddResource( resource );
+			compressedDataSize += compressedData.size();
+			compressedData.clear();
+		}
 
-			if( addResourceResult.type != ResultType::SUCCESS )
+		if( params.calculateCompressions )
+		{
+			if( !compressionStream.Finish() )
 			{
-				return addResourceResult;
+				return Result{ ResultType::FAILED_TO_COMPRESS_DATA };
 			}
 
-			detailStatusSettings.Update( CarbonResources::StatusProgressType::UNBOUNDED, 0, 0, "Imported resource: " + resourceParams.relativePath.string() );
+			compressedDataSize += compressedData.size();
+			compressedData.clear();
 		}
-	}
-
-	return Result{ ResultType::SUCCESS };
-}
-
-Result ResourceGroup::ResourceGroupImpl::CreateResourceFromResource( const ResourceInfo& resourceIn, ResourceInfo*& resourceOut ) const
-{
-	resourceOut = nullptr;
 
-	std::string resourceType = "";
+		ResourceTools::Digest128 checksum;
 
-	Result getResourceTypeResult = resourceIn.GetType( resourceType );
+		if( !checksumStream.FinishAndRetrieve( checksum ) )
+		{
+			return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
+		}
 
-	if( getResourceTypeResult.type != ResultType::SUCCESS )
-	{
-		return getResourceTypeResult;
-	}
+		// Create resource from parameters
+		ResourceInfoParams resourceParams;
 
-	if( resourceType == ResourceInfo::TypeId() )
-	{
-		resourceOut = new ResourceInfo( {} );
+		resourceParams.relativePath = std::filesystem::relative( entry.path(), params.directory );
 
-		Result setParametersFromResourceResult = resourceOut->SetParametersFromResource( &resourceIn, m_versionParameter.GetValue() );
+		resourceParams.uncompressedSize = fileSize;
 
-		if( setParametersFromResourceResult.type != ResultType::SUCCESS )
-		{
-			return setParametersFromResourceResult;
-		}
-	}
-	else if( resourceType == PatchResourceInfo::TypeId() )
-	{
-		PatchResourceInfo* patchResourceInfo = new PatchResourceInfo( {} );
+		resourceParams.compressedSize = compressedDataSize;
 
-		Result setParametersFromResourceResult = patchResourceInfo->SetParametersFromResource( &resourceIn, m_versionParameter.GetValue() );
+		resourceParams.checksum = checksum;
 
-		if( setParametersFromResourceResult.type != ResultType::SUCCESS )
-		{
-			return setParametersFromResourceResult;
-		}
+		resourceParams.binaryOperation = ResourceTools::CalculateBinaryOperation( entry.path() );
 
-		resourceOut = patchResourceInfo;
-	}
-	else if( resourceType == BundleResourceInfo::TypeId() )
-	{
-		BundleResourceInfo* bundleResourceInfo = new BundleResourceInfo( {} );
+		Location l;
 
-		Result setParametersFromResourceResult = bundleResourceInfo->SetParametersFromResource( &resourceIn, m_versionParameter.GetValue() );
+		Result calculateLocationResult = l.SetFromRelativePathAndDataChecksum( resourceParams.relativePath, checksum );
 
-		if( setParametersFromResourceResult.type != ResultType::SUCCESS )
+		if( calculateLocationResult.type != ResultType::SUCCESS )
 		{
-			return setParametersFromResourceResult;
+			return calculateLocationResult;
 		}
 
-		resourceOut = bundleResourceInfo;
-	}
-	else if( resourceType == BundleResourceInfo::TypeId() )
-	{
-		ResourceInfo* binaryResourceInfo = new ResourceInfo( {} );
+		resourceParams.location = l.ToString();
 
-		Result setParametersFromResourceResult = binaryResourceInfo->SetParametersFromResource( &resourceIn, m_versionParameter.GetValue() );
+		std::unique_ptr<ResourceInfo> resource = std::make_unique<ResourceInfo>( resourceParams );
 
-		if( setParametersFromResourceResult.type != ResultType::SUCCESS )
+		// If resources are set to be exported, then export as specified.
+		// This is slow with large files as each need to be streamed again
+		// The problem is that checksum of the whole file needs to be calculated first
+		// in order to get the correct destination CDN path
+		// If compression is not skipped and REMOTE_CDN is chosen as destination then
+		// compression will also be calculated twice.
+		// This can be improved with a refactor but currently this code path not
+		// likely to be relied upon often
+		if( params.exportResources )
 		{
-			return setParametersFromResourceResult;
+			Result exportResourceResult = ExportResourceFromFile( params, entry, *resource );
+
+			if( exportResourceResult.type != ResultType::SUCCESS )
+			{
+				return exportResourceResult;
+			}
 		}
 
-		resourceOut = binaryResourceInfo;
+		resourceOut = resource.release();
 	}
 
 	return Result{ ResultType::SUCCESS };
 }
 
-Result ResourceGroup::ResourceGroupImpl::CreateResourceFromYaml( YAML::Node& resource, ResourceInfo*& resourceOut )
+Result ResourceGroup::ResourceGroupImpl::ExportResourceFromFile( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, const ResourceInfo& resource ) const
 {
-	std::unique_ptr<ResourceInfo> resourceInfo;
+	ResourcePutDataStreamParams putDataStreamParams;
 
-	Result createResourceInfoResult = CreateResourceInfoFromYamlNode( resource, resourceInfo, m_versionParameter.GetValue() );
+	// Create the correct file data streaming for the desination
+	std::unique_ptr<ResourceTools::FileDataStreamOut> resourceDataStreamOut;
 
-	if( createResourceInfoResult.type != ResultType::SUCCESS )
+	if( params.exportResourcesDestinationSettings.destinationType == ResourceDestinationType::REMOTE_CDN )
 	{
-
-		return createResourceInfoResult;
+		// REMOTE_CDN requires compression
+		resourceDataStreamOut = std::make_unique<ResourceTools::CompressedFileDataStreamOut>();
 	}
 	else
 	{
-		resourceOut = resourceInfo.release();
-
-		return Result{ ResultType::SUCCESS };
+		// Else just stream out uncompressed
+		resourceDataStreamOut = std::make_unique<ResourceTools::FileDataStreamOut>();
 	}
-}
 
-Result ResourceGroup::ResourceGroupImpl::ImportFromYamlString( const std::string& data, StatusSettings& statusSettings )
-{
-	YAML::Node resourceGroupFile;
-	try
-	{
-		resourceGroupFile = YAML::Load( data );
-	}
-	catch( YAML::ParserException& )
-	{
-		return Result{ ResultType::FAILED_TO_PARSE_YAML };
-	}
-	return ImportFromYaml( resourceGroupFile, statusSettings );
-}
+	putDataStreamParams.resourceDestinationSettings = params.exportResourcesDestinationSettings;
 
-Result ResourceGroup::ResourceGroupImpl::ImportFromYaml( YAML::Node& resourceGroupFile, StatusSettings& statusSettings )
-{
-	statusSettings.Update( StatusProgressType::PERCENTAGE, 0, 30, "Importing from Yaml file." );
+	putDataStreamParams.dataStream = resourceDataStreamOut.get();
 
-	YAML::Node typeNode = resourceGroupFile[m_type.GetTag()];
-	if( !typeNode.IsDefined() )
-	{
-		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
-	}
-	m_type = typeNode.as<std::string>();
-	if( m_type.GetValue() != GetType() )
-	{
-		return Result{ ResultType::FILE_TYPE_MISMATCH };
-	}
+	Result putDataStreamResult = resource.PutDataStream( putDataStreamParams );
 
-	YAML::Node resourceGroupVersionNode = resourceGroupFile[m_versionParameter.GetTag()];
-	if( !resourceGroupVersionNode.IsDefined() )
+	if( putDataStreamResult.type != ResultType::SUCCESS )
 	{
-		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+		return putDataStreamResult;
 	}
-	std::string versionStr = resourceGroupVersionNode.as<std::string>(); //version stringID needs to be in one place
 
-	VersionInternal version;
-	version.FromString( versionStr );
-	m_versionParameter = version;
+	// Export resource using streaming
+	ResourceTools::FileDataStreamIn fileStreamIn( params.resourceStreamThreshold );
 
-	if( m_versionParameter.GetValue().getMajor() > S_DOCUMENT_VERSION.major )
+	if( !fileStreamIn.StartRead( entry.path() ) )
 	{
-		return Result{ ResultType::DOCUMENT_VERSION_UNSUPPORTED };
+		return Result{ ResultType::FAILED_TO_OPEN_FILE_STREAM };
 	}
 
-	// If version is greater than the max version supported at compile then ceil to that
-	if( version > S_DOCUMENT_VERSION )
+	while( !fileStreamIn.IsFinished() )
 	{
-		statusSettings.Update( StatusProgressType::WARNING, 0, 0, "Supplied resource group version greater than resources build max version. Some data may be lost during import." );
+		std::string data = "";
 
-		version = S_DOCUMENT_VERSION;
-	}
+		if( !( fileStreamIn >> data ) )
+		{
+			return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
+		}
 
-	YAML::Node numberOfResourcesNode = resourceGroupFile[m_numberOfResources.GetTag()];
-	if( !numberOfResourcesNode.IsDefined() )
-	{
-		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+		if( !( resourceDataStreamOut->operator<<( data ) ) )
+		{
+			return Result{ ResultType::FAILED_TO_SAVE_TO_STREAM };
+		}
 	}
 
-	YAML::Node totalResourceSizeCompressedNode = resourceGroupFile[m_totalResourcesSizeCompressed.GetTag()];
-	if( !totalResourceSizeCompressedNode.IsDefined() )
+	if( !resourceDataStreamOut->Finish() )
 	{
-		m_totalResourcesSizeCompressed.Reset();
+		return Result{ ResultType::FAILED_TO_SAVE_TO_STREAM };
 	}
 
-	YAML::Node totalResourceSizeUncompressedNode = resourceGroupFile[m_totalResourcesSizeUncompressed.GetTag()];
-	if( !totalResourceSizeUncompressedNode.IsDefined() )
-	{
-		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ImportFromData( const std::string& data, StatusSettings& statusSettings, DocumentType documentType /* = DocumentType::YAML */ )
+{
+	switch( documentType )
+	{
+	case DocumentType::CSV:
+#ifdef _MSC_VER
+#pragma warning( push )
+#pragma warning( disable : 4996 ) // Suppress deprecation warning.
+#elif __APPLE__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+		return ImportFromCSV( data, statusSettings );
+#ifdef _MSC_VER
+#pragma warning( pop )
+#elif __APPLE__
+#pragma clang diagnostic pop
+#endif
+	case DocumentType::YAML:
+		return ImportFromYamlString( data, statusSettings );
+	default:
+		return Result{ ResultType::UNSUPPORTED_FILE_FORMAT };
+	}
+
+	return Result{ ResultType::FAIL };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ImportFromFile( const ResourceGroupImportFromFileParams& params, StatusSettings& statusSettings )
+{
+	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 20, "Importing Resource Group from file." );
+
+	if( params.filename.empty() )
+	{
+		return Result{ ResultType::FILE_NOT_FOUND };
+	}
+
+	std::string data;
+
+	if( !ResourceTools::GetLocalFileData( params.filename, data ) )
+	{
+		return Result{ ResultType::FAILED_TO_OPEN_FILE };
+	}
+
+	// VERSION NEEDS TO BE CHECKED TO ENSURE ITS SUPPORTED ON IMPORT
+	std::filesystem::path filename = params.filename;
+
+	std::string extension = filename.extension().string();
+
+	Result importResult;
+
+    {
+		StatusSettings nestedStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 20, 80, "Importing Resource Group from file.", &nestedStatusSettings );
+
+		if( extension == ".txt" )
+		{
+#ifdef _MSC_VER
+#pragma warning( push )
+#pragma warning( disable : 4996 ) // Suppress deprecation warning.
+#elif __APPLE__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+			importResult = ImportFromCSV( data, nestedStatusSettings );
+#ifdef _MSC_VER
+#pragma warning( pop )
+#elif __APPLE__
+#pragma clang diagnostic pop
+#endif
+		}
+		else if( extension == ".yml" || extension == ".yaml" || extension.empty() )
+		{
+			importResult = ImportFromYamlString( data, nestedStatusSettings );
+		}
+		else
+		{
+			return Result{ ResultType::UNSUPPORTED_FILE_FORMAT };
+		}
+
+		if( importResult.type != ResultType::SUCCESS )
+		{
+			return importResult;
+		}
+    }
+
+    return importResult;
+}
+
+Result ResourceGroup::ResourceGroupImpl::ExportToFile( const ResourceGroupExportToFileParams& params, StatusSettings& statusSettings ) const
+{
+	// Update status
+	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 10, "Exporting Resource Group to file: " + params.filename.string() );
+
+	std::string data = "";
+
+	if( params.outputDocumentVersion.major == 0 && params.outputDocumentVersion.minor == 0 )
+	{
+		{
+			StatusSettings exportCsvstatusSettings;
+			statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Exporting Resource Group to file: " + params.filename.string(), &exportCsvstatusSettings );
+
+
+			Result exportCsvResult = ExportCsv( params.outputDocumentVersion, data, exportCsvstatusSettings );
+			if( exportCsvResult.type != ResultType::SUCCESS )
+			{
+				return exportCsvResult;
+			}
+		}
+	}
+	else
+	{
+		{
+			StatusSettings exportYamlstatusSettings;
+			statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Exporting Resource Group to file: " + params.filename.string(), &exportYamlstatusSettings );
+
+			Result exportYamlResult = ExportYaml( params.outputDocumentVersion, data, exportYamlstatusSettings );
+
+			if( exportYamlResult.type != ResultType::SUCCESS )
+			{
+				return exportYamlResult;
+			}
+		}
+	}
+
+	if( !ResourceTools::SaveFile( params.filename, data ) )
+	{
+		return Result{ ResultType::FAILED_TO_SAVE_FILE };
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ExportToData( std::string& data, StatusSettings& statusSettings, VersionInternal outputDocumentVersion /* = S_DOCUMENT_VERSION*/ ) const
+{
+	Result exportYamlResult = ExportYaml( outputDocumentVersion, data, statusSettings );
+
+	if( exportYamlResult.type != ResultType::SUCCESS )
+	{
+		return exportYamlResult;
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ImportFromCSV( const std::string& data, StatusSettings& statusSettings )
+{
+	// Status update
+	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 10, "Importing Resource Group from CSV file." );
+
+	std::stringstream inputStream;
+
+	inputStream << data;
+
+	std::string stringIn;
+
+    {
+		StatusSettings detailStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Importing Resource Group from CSV file.", &detailStatusSettings );
+
+		while( !inputStream.eof() )
+		{
+			std::getline( inputStream, stringIn );
+
+			if( stringIn == "" )
+			{
+				continue;
+			}
+
+			std::stringstream ss( stringIn );
+
+			std::string value;
+
+			char delimiter = ',';
+
+			ResourceInfoParams resourceParams;
+
+			if( !std::getline( ss, value, delimiter ) )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			// Split filename and prefix
+			std::string resourcePrefixDelimiter = ":/";
+			std::string filename = value.substr( value.find( resourcePrefixDelimiter ) + resourcePrefixDelimiter.size() );
+			std::string resourcePrefix = value.substr( 0, value.find( ":" ) );
+
+			resourceParams.relativePath = filename;
+
+			resourceParams.prefix = resourcePrefix;
+
+			if( !std::getline( ss, value, delimiter ) )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			resourceParams.location = value;
+
+			if( !std::getline( ss, value, delimiter ) )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			ResourceTools::Digest128 checksum;
+
+			if( !checksum.FromHexString( value ) )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			resourceParams.checksum = checksum;
+
+			if( !std::getline( ss, value, delimiter ) )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			try
+			{
+				resourceParams.uncompressedSize = std::stoull( value.c_str() );
+			}
+			catch( std::invalid_argument& )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+			catch( std::out_of_range& )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			if( !std::getline( ss, value, delimiter ) )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			try
+			{
+				resourceParams.compressedSize = std::stoull( value.c_str() );
+			}
+			catch( std::invalid_argument& )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+			catch( std::out_of_range& )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			if( !std::getline( ss, value, delimiter ) )
+			{
+				resourceParams.binaryOperation = 0;
+			}
+			else
+			{
+				try
+				{
+					unsigned long long valueToULongLong = std::stoull( value.c_str() );
+
+					if( valueToULongLong > std::numeric_limits<uint32_t>::max() )
+					{
+						return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+					}
+
+					resourceParams.binaryOperation = static_cast<uint32_t>( valueToULongLong );
+				}
+				catch( std::invalid_argument& )
+				{
+					return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+				}
+				catch( std::out_of_range& )
+				{
+					return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+				}
+			}
+
+			// ResourceGroup gets upgraded to 0.1.0
+			m_versionParameter = VersionInternal{ 0, 1, 0 };
+
+			// Create a Resource
+			ResourceInfo* resource = new ResourceInfo( resourceParams );
+
+			Result addResourceResult = AddResource( resource );
+
+			if( addResourceResult.type != ResultType::SUCCESS )
+			{
+				return addResourceResult;
+			}
+
+			detailStatusSettings.Update( CarbonResources::StatusProgressType::UNBOUNDED, 0, 0, "Imported resource: " + resourceParams.relativePath.string() );
+		}
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::CreateResourceFromResource( const ResourceInfo& resourceIn, ResourceInfo*& resourceOut ) const
+{
+	resourceOut = nullptr;
+
+	std::string resourceType = "";
+
+	Result getResourceTypeResult = resourceIn.GetType( resourceType );
+
+	if( getResourceTypeResult.type != ResultType::SUCCESS )
+	{
+		return getResourceTypeResult;
+	}
+
+	if( resourceType == ResourceInfo::TypeId() )
+	{
+		resourceOut = new ResourceInfo( {} );
+
+		Result setParametersFromResourceResult = resourceOut->SetParametersFromResource( &resourceIn, m_versionParameter.GetValue() );
+
+		if( setParametersFromResourceResult.type != ResultType::SUCCESS )
+		{
+			return setParametersFromResourceResult;
+		}
+	}
+	else if( resourceType == PatchResourceInfo::TypeId() )
+	{
+		PatchResourceInfo* patchResourceInfo = new PatchResourceInfo( {} );
+
+		Result setParametersFromResourceResult = patchResourceInfo->SetParametersFromResource( &resourceIn, m_versionParameter.GetValue() );
+
+		if( setParametersFromResourceResult.type != ResultType::SUCCESS )
+		{
+			return setParametersFromResourceResult;
+		}
+
+		resourceOut = patchResourceInfo;
+	}
+	else if( resourceType == BundleResourceInfo::TypeId() )
+	{
+		BundleResourceInfo* bundleResourceInfo = new BundleResourceInfo( {} );
+
+		Result setParametersFromResourceResult = bundleResourceInfo->SetParametersFromResource( &resourceIn, m_versionParameter.GetValue() );
+
+		if( setParametersFromResourceResult.type != ResultType::SUCCESS )
+		{
+			return setParametersFromResourceResult;
+		}
+
+		resourceOut = bundleResourceInfo;
+	}
+	else if( resourceType == BundleResourceInfo::TypeId() )
+	{
+		ResourceInfo* binaryResourceInfo = new ResourceInfo( {} );
+
+		Result setParametersFromResourceResult = binaryResourceInfo->SetParametersFromResource( &resourceIn, m_versionParameter.GetValue() );
+
+		if( setParametersFromResourceResult.type != ResultType::SUCCESS )
+		{
+			return setParametersFromResourceResult;
+		}
+
+		resourceOut = binaryResourceInfo;
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::CreateResourceFromYaml( YAML::Node& resource, ResourceInfo*& resourceOut )
+{
+	std::unique_ptr<ResourceInfo> resourceInfo;
+
+	Result createResourceInfoResult = CreateResourceInfoFromYamlNode( resource, resourceInfo, m_versionParameter.GetValue() );
+
+	if( createResourceInfoResult.type != ResultType::SUCCESS )
+	{
+
+		return createResourceInfoResult;
+	}
+	else
+	{
+		resourceOut = resourceInfo.release();
+
+		return Result{ ResultType::SUCCESS };
+	}
+}
+
+Result ResourceGroup::ResourceGroupImpl::ImportFromYamlString( const std::string& data, StatusSettings& statusSettings )
+{
+	YAML::Node resourceGroupFile;
+	try
+	{
+		resourceGroupFile = YAML::Load( data );
+	}
+	catch( YAML::ParserException& )
+	{
+		return Result{ ResultType::FAILED_TO_PARSE_YAML };
+	}
+	return ImportFromYaml( resourceGroupFile, statusSettings );
+}
+
+Result ResourceGroup::ResourceGroupImpl::ImportFromYaml( YAML::Node& resourceGroupFile, StatusSettings& statusSettings )
+{
+	statusSettings.Update( StatusProgressType::PERCENTAGE, 0, 30, "Importing from Yaml file." );
+
+	YAML::Node typeNode = resourceGroupFile[m_type.GetTag()];
+	if( !typeNode.IsDefined() )
+	{
+		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+	}
+	m_type = typeNode.as<std::string>();
+	if( m_type.GetValue() != GetType() )
+	{
+		return Result{ ResultType::FILE_TYPE_MISMATCH };
+	}
+
+	YAML::Node resourceGroupVersionNode = resourceGroupFile[m_versionParameter.GetTag()];
+	if( !resourceGroupVersionNode.IsDefined() )
+	{
+		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+	}
+	std::string versionStr = resourceGroupVersionNode.as<std::string>(); //version stringID needs to be in one place
+
+	VersionInternal version;
+	version.FromString( versionStr );
+	m_versionParameter = version;
+
+	if( m_versionParameter.GetValue().getMajor() > S_MAX_DOCUMENT_VERSION.major )
+	{
+		return Result{ ResultType::DOCUMENT_VERSION_UNSUPPORTED };
+	}
+
+	// If version is greater than the max version supported at compile then ceil to that
+	if( version > S_MAX_DOCUMENT_VERSION )
+	{
+		statusSettings.Update( StatusProgressType::WARNING, 0, 0, "Supplied resource group version greater than resources build max version. Some data may be lost during import." );
+
+		version = S_MAX_DOCUMENT_VERSION;
+	}
+
+	// Documents predating the checksum algorithm parameter are MD5
+	m_checksumAlgorithm = ChecksumAlgorithm::MD5;
+
+	if( m_checksumAlgorithm.IsParameterExpectedInDocumentVersion( version ) )
+	{
+		YAML::Node checksumAlgorithmNode = resourceGroupFile[m_checksumAlgorithm.GetTag()];
+		if( !checksumAlgorithmNode.IsDefined() )
+		{
+			return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+		}
+
+		ChecksumAlgorithm checksumAlgorithm;
+
+		if( !StringToChecksumAlgorithm( checksumAlgorithmNode.as<std::string>(), checksumAlgorithm ) )
+		{
+			return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+		}
+
+		m_checksumAlgorithm = checksumAlgorithm;
+	}
+
+	YAML::Node numberOfResourcesNode = resourceGroupFile[m_numberOfResources.GetTag()];
+	if( !numberOfResourcesNode.IsDefined() )
+	{
+		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+	}
+
+	YAML::Node totalResourceSizeCompressedNode = resourceGroupFile[m_totalResourcesSizeCompressed.GetTag()];
+	if( !totalResourceSizeCompressedNode.IsDefined() )
+	{
+		m_totalResourcesSizeCompressed.Reset();
+	}
+
+	YAML::Node totalResourceSizeUncompressedNode = resourceGroupFile[m_totalResourcesSizeUncompressed.GetTag()];
+	if( !totalResourceSizeUncompressedNode.IsDefined() )
+	{
+		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+	}
+
+	Result res = ImportGroupSpecialisedYaml( resourceGroupFile );
+
+	if( res.type != ResultType::SUCCESS )
+	{
+		return res;
+	}
+
+	YAML::Node resources = resourceGroupFile[m_resourcesParameter.GetTag()];
+	if( !resources.IsDefined() )
+	{
+		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+	}
+
+    {
+		StatusSettings resourcesStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 30, 70, "Processing Resources.", &resourcesStatusSettings );
+
+		int i = 0;
+
+		for( auto iter = resources.begin(); iter != resources.end(); iter++ )
+		{
+			// This bit is a sequence
+			YAML::Node resourceNode = ( *iter );
+
+			ResourceInfo* resource = nullptr;
+
+			Result createResourceFromYamlResult = CreateResourceFromYaml( resourceNode, resource );
+
+			if( createResourceFromYamlResult.type != ResultType::SUCCESS )
+			{
+				return createResourceFromYamlResult;
+			}
+
+            if (resourcesStatusSettings.RequiresStatusUpdates())
+            {
+				float step = static_cast<float>( 100.0 / resources.size() );
+				float progress = static_cast<float>( i * step );
+
+                std::filesystem::path resourcePath;
+				Result getResourcePathResult = resource->GetRelativePath( resourcePath );
+
+                if( getResourcePathResult.type != ResultType::SUCCESS )
+                {
+					return getResourcePathResult;
+                }
+
+				resourcesStatusSettings.Update( StatusProgressType::PERCENTAGE, progress, step, "Adding resource: " + resourcePath.string() );
+            }
+
+			Result addResourceResult = AddResource( resource );
+
+			if( addResourceResult.type != ResultType::SUCCESS )
+			{
+				return addResourceResult;
+			}
+
+			i++;
+		}
+    }
+
+	return Result{ ResultType::SUCCESS };
+}
+
+std::string ResourceGroup::ResourceGroupImpl::GetType() const
+{
+	return TypeId();
+}
+
+std::string ResourceGroup::ResourceGroupImpl::TypeId()
+{
+	return "ResourceGroup";
+}
+
+Result ResourceGroup::ResourceGroupImpl::ImportGroupSpecialisedYaml( YAML::Node& resourceGroupFile )
+{
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ExportGroupSpecialisedYaml( YAML::Emitter& out, VersionInternal outputDocumentVersion ) const
+{
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ExportYaml( const VersionInternal& outputDocumentVersion, std::string& data, StatusSettings& statusSettings ) const
+{
+	statusSettings.Update( StatusProgressType::PERCENTAGE, 0, 20, "Exporting Yaml" );
+
+	YAML::Emitter out;
+
+	// Output header information
+	out << YAML::BeginMap;
+
+	// It is possible to export a different version that the imported version
+	// The version must be less than the version of the document and also no higher than supported by the binary at compile
+	// Ensure document version is valid
+	if( !outputDocumentVersion.isVersionValid() )
+	{
+		return Result{ ResultType::DOCUMENT_VERSION_UNSUPPORTED };
+	}
+
+	VersionInternal sanitisedOutputDocumentVersion = outputDocumentVersion;
+	const VersionInternal documentCurrentVersion = m_versionParameter.GetValue();
+
+	if( sanitisedOutputDocumentVersion > documentCurrentVersion )
+	{
+		sanitisedOutputDocumentVersion = documentCurrentVersion;
+	}
+
+	if( sanitisedOutputDocumentVersion > S_MAX_DOCUMENT_VERSION )
+	{
+		sanitisedOutputDocumentVersion = S_MAX_DOCUMENT_VERSION;
+	}
+
+	// Checksums cannot be downgraded, so only MD5 groups may be exported to versions without the checksum algorithm
+	const bool checksumAlgorithmExpected = m_checksumAlgorithm.IsParameterExpectedInDocumentVersion( sanitisedOutputDocumentVersion );
+
+	if( !checksumAlgorithmExpected && m_checksumAlgorithm.GetValue() != ChecksumAlgorithm::MD5 )
+	{
+		return Result{ ResultType::CHECKSUM_ALGORITHM_UNSUPPORTED_BY_DOCUMENT_VERSION };
+	}
+
+	//Export document parameters
+	out << YAML::Key << m_versionParameter.GetTag();
+	out << YAML::Value << sanitisedOutputDocumentVersion.ToString();
+
+	out << YAML::Key << m_type.GetTag();
+	out << YAML::Value << m_type.GetValue();
+
+	out << YAML::Key << m_numberOfResources.GetTag();
+	out << YAML::Value << m_numberOfResources.GetValue();
+
+    if (m_totalResourcesSizeCompressed.HasValue())
+    {
+		uintmax_t compressedSize = m_totalResourcesSizeCompressed.GetValue();
+
+		out << YAML::Key << m_totalResourcesSizeCompressed.GetTag();
+		out << YAML::Value << compressedSize;
+		
+    }
+
+	out << YAML::Key << m_totalResourcesSizeUncompressed.GetTag();
+	out << YAML::Value << m_totalResourcesSizeUncompressed.GetValue();
+
+	if( checksumAlgorithmExpected )
+	{
+		std::string checksumAlgorithm;
+
+		if( !ChecksumAlgorithmToString( m_checksumAlgorithm.GetValue(), checksumAlgorithm ) )
+		{
+			return Result{ ResultType::FAIL };
+		}
+
+		out << YAML::Key << m_checksumAlgorithm.GetTag();
+		out << YAML::Value << checksumAlgorithm;
+	}
+
+	Result res = ExportGroupSpecialisedYaml( out, sanitisedOutputDocumentVersion );
+
+	if( res.type != ResultType::SUCCESS )
+	{
+		return res;
+	}
+
+	out << YAML::Key << m_resourcesParameter.GetTag();
+
+	out << YAML::Value << YAML::BeginSeq;
+
+	int i = 0;
+
+    {
+		StatusSettings detailExportingStatusSettings;
+		statusSettings.Update( StatusProgressType::PERCENTAGE, 20, 80, "Exporting Yaml", &detailExportingStatusSettings );
+
+		for( ResourceInfo* r : m_resourcesParameter )
+		{
+			// Update status
+			if( detailExportingStatusSettings.RequiresStatusUpdates() )
+			{
+				std::filesystem::path relativePath;
+
+				Result getRelativePathResult = r->GetRelativePath( relativePath );
+
+				if( getRelativePathResult.type != ResultType::SUCCESS )
+				{
+					return Result{ ResultType::FAIL };
+				}
+
+				float step = static_cast<float>( 100.0 / m_resourcesParameter.GetSize() );
+				float percentage = static_cast<float>( step * i );
+
+				std::string message = "Exporting: " + relativePath.string();
+
+				detailExportingStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, message );
+
+				i++;
+			}
+
+			out << YAML::BeginMap;
+
+			Result resourceExportResult = r->ExportToYaml( out, sanitisedOutputDocumentVersion );
+
+			if( resourceExportResult.type != ResultType::SUCCESS )
+			{
+				return resourceExportResult;
+			}
+
+			out << YAML::EndMap;
+		}
+
+		out << YAML::EndSeq;
+
+		out << YAML::EndMap;
+
+		data = out.c_str();
+    }
+    
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ExportCsv( const VersionInternal& outputDocumentVersion, std::string& data, StatusSettings& statusSettings ) const
+{
+	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 10, "Exporting  to CSV" );
+
+	if( outputDocumentVersion.getMajor() > 0 || outputDocumentVersion.getMinor() > 0 || outputDocumentVersion.getPatch() > 0 )
+	{
+		return Result{ ResultType::UNSUPPORTED_FILE_FORMAT };
+	}
+
+	if( m_checksumAlgorithm.GetValue() != ChecksumAlgorithm::MD5 )
+	{
+		return Result{ ResultType::CHECKSUM_ALGORITHM_UNSUPPORTED_BY_DOCUMENT_VERSION };
+	}
+
+	std::string out;
+
+
+	auto resourceInfos = m_resourcesParameter.GetValue();
+	std::sort(
+		resourceInfos->begin(),
+		resourceInfos->end(),
+		[]( ResourceInfo* a, ResourceInfo* b ) {
+			std::filesystem::path ap;
+			std::filesystem::path bp;
+			a->GetRelativePath( ap );
+			b->GetRelativePath( bp );
+			return ap < bp;
+		} );
+
+	int i{ 0 };
+
+    {
+		StatusSettings detailExportStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Exporting  to CSV", &detailExportStatusSettings );
+
+		for( ResourceInfo* r : m_resourcesParameter )
+		{
+			// Update status
+			if( detailExportStatusSettings.RequiresStatusUpdates() )
+			{
+				float step = static_cast<float>( 100.0 / m_resourcesParameter.GetValue()->size() );
+				float percentage = static_cast<float>( step * i );
+				detailExportStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, "Percentage Update" );
+				i++;
+			}
+
+			Result resourceExportResult = r->ExportToCsv( out, m_versionParameter.GetValue() );
+			if( resourceExportResult.type != ResultType::SUCCESS )
+			{
+				return resourceExportResult;
+			}
+			data += out + "\n";
+		}
+    }
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ProcessChunk( ResourceTools::GetChunk& chunkFile, const std::filesystem::path& chunkRelativePath, BundleResourceGroup::BundleResourceGroupImpl& bundleResourceGroup, const ResourceDestinationSettings& chunkDestinationSettings ) const
+{
+	// Create resource from Patch Data
+	BundleResourceInfo* chunkResource = new BundleResourceInfo( { chunkRelativePath } );
+
+	// Checksum
+	ResourceTools::ChecksumStream checksumStream( GetResourceToolsChecksumAlgorithm( m_checksumAlgorithm.GetValue() ) );
+
+	ResourceTools::Digest128 checksum;
+	{
+		std::string chunk;
+
+		while( *chunkFile.uncompressedChunkIn >> chunk )
+		{
+			checksumStream << chunk;
+		}
+	}
+
+	if( !checksumStream.FinishAndRetrieve( checksum ) )
+	{
+		return Result( { ResultType::FAILED_TO_GENERATE_CHECKSUM } );
+	}
+
+	chunkResource->SetDataChecksum( checksum );
+
+	// Compressed Size
+	chunkResource->SetCompressedSize( chunkFile.compressedChunkIn->Size() );
+
+	// Uncompressed Size
+	chunkResource->SetUncompressedSize( chunkFile.uncompressedChunkIn->Size() );
+
+	// Export chunk file
+	std::filesystem::path sourceFile;
+
+	if( chunkDestinationSettings.destinationType == ResourceDestinationType::REMOTE_CDN )
+	{
+		sourceFile = chunkFile.compressedChunkIn->GetPath();
+	}
+	else
+	{
+		sourceFile = chunkFile.uncompressedChunkIn->GetPath();
+	}
+
+	std::filesystem::path targetFile;
+
+	if( chunkDestinationSettings.destinationType == ResourceDestinationType::LOCAL_RELATIVE )
+	{
+		std::filesystem::path relativePath;
+
+		chunkResource->GetRelativePath( relativePath );
+
+		targetFile = chunkDestinationSettings.basePath / relativePath;
+	}
+	else
+	{
+		std::string location;
+
+		chunkResource->GetLocation( location );
+
+		targetFile = chunkDestinationSettings.basePath / location;
+	}
+
+	if( std::filesystem::exists( targetFile ) )
+	{
+		std::filesystem::remove( targetFile );
+	}
+
+	if( !std::filesystem::exists( targetFile.parent_path() ) )
+	{
+		std::filesystem::create_directories( targetFile.parent_path() );
+	}
+
+	try
+	{
+		std::filesystem::copy_file( sourceFile, targetFile );
+	}
+	catch( std::filesystem::filesystem_error& e )
+	{
+		return Result( { ResultType::FAILED_TO_SAVE_FILE, e.what() } );
+	}
+
+	// Add the chunk resource to the bundleResourceGroup
+	Result addResourceResult = bundleResourceGroup.AddResource( chunkResource );
+
+	if( addResourceResult.type != ResultType::SUCCESS )
+	{
+		delete chunkResource;
+
+		return addResourceResult;
+	}
+
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::CreateBundle( const BundleCreateParams& params, StatusSettings& statusSettings ) const
+{
+	// Update status
+	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 5, "Creating Bundle" );
+
+	uintmax_t numberOfChunks = 0;
+
+	std::string chunkBaseName = params.resourceGroupRelativePath.filename().replace_extension().string();
+
+	BundleResourceGroup::BundleResourceGroupImpl bundleResourceGroup;
+
+	bundleResourceGroup.SetChecksumAlgorithm( m_checksumAlgorithm.GetValue() );
+
+	const VersionInternal outputDocumentVersion = GetDerivedGroupDocumentVersion();
+
+	Result setChunkSizeResult = bundleResourceGroup.SetChunkSize( params.chunkSize );
+
+	if( setChunkSizeResult.type != ResultType::SUCCESS )
+	{
+		return setChunkSizeResult;
+	}
+
+	ResourceTools::BundleStreamOut bundleStream( params.chunkSize, params.chunkDestinationSettings.basePath );
+
+
+	// Update status
+	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 5, 40, "Generating Chunks" );
+
+	int i = 0;
+
+	std::vector<ResourceInfo*> toBundle;
+
+	std::copy( m_resourcesParameter.begin(), m_resourcesParameter.end(), std::back_inserter( toBundle ) );
+
+	Result getGroupSpecificResourcesToBundleResult = GetGroupSpecificResourcesToBundle( toBundle );
+
+	if( getGroupSpecificResourcesToBundleResult.type != ResultType::SUCCESS )
+	{
+		return getGroupSpecificResourcesToBundleResult;
+	}
+
+	// Loop through all resources and send data for chunking
+	{
+		StatusSettings fileProcessingDetailStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 45, 35, "Generating Chunks", &fileProcessingDetailStatusSettings );
+
+
+		for( ResourceInfo* resource : toBundle )
+		{
+			std::string location;
+
+			Result getLocationResult = resource->GetLocation( location );
+
+			if( getLocationResult.type != ResultType::SUCCESS )
+			{
+				return getLocationResult;
+			}
+
+			if( fileProcessingDetailStatusSettings.RequiresStatusUpdates() )
+			{
+				std::filesystem::path relativePath;
+
+				Result getRelativePathResult = resource->GetRelativePath( relativePath );
+
+				if( getRelativePathResult.type != ResultType::SUCCESS )
+				{
+					return getRelativePathResult;
+				}
+
+				std::string message;
+
+				if( location.empty() )
+				{
+					message = "No file to process: " + relativePath.string();
+				}
+				else
+				{
+					message = "Processing: " + relativePath.string();
+				}
+
+				float step = static_cast<float>( 100.0 / toBundle.size() );
+				float percentComplete = static_cast<float>( step * i );
+
+				i++;
+
+				fileProcessingDetailStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentComplete, step, message );
+			}
+			if( location.empty() )
+			{
+				continue;
+			}
+
+			auto resourceDataStream = std::make_shared<ResourceTools::FileDataStreamIn>( params.fileReadChunkSize );
+
+			ResourceGetDataStreamParams resourceGetDataParams;
+
+			resourceGetDataParams.resourceSourceSettings = params.resourceSourceSettings;
+
+			resourceGetDataParams.dataStream = resourceDataStream;
+
+			resourceGetDataParams.downloadRetrySeconds = params.downloadRetrySeconds;
+
+			Result resourceGetDataResult = resource->GetDataStream( resourceGetDataParams );
+
+			bundleStream << resourceDataStream;
+
+			if( resourceGetDataResult.type != ResultType::SUCCESS )
+			{
+				return resourceGetDataResult;
+			}
+
+
+			while( !resourceDataStream->IsFinished() )
+			{
+				std::string resourceDataChunk;
+
+				if( !( *resourceDataStream >> resourceDataChunk ) )
+				{
+					return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
+				}
+
+				// Loop through possible created chunks
+				ResourceTools::GetChunk chunkFile;
+
+				chunkFile.clearCache = false;
+
+				bool bundleReadOk{ true };
+
+				while( ( bundleReadOk = bundleStream >> chunkFile ) && !chunkFile.outOfChunks )
+				{
+					std::stringstream ss;
+					ss << chunkBaseName << numberOfChunks << ".chunk";
+					std::string chunkName = ss.str();
+
+					std::filesystem::path chunkPath = params.chunkDestinationSettings.basePath / ss.str();
+
+					Result processChunkResult = ProcessChunk( chunkFile, chunkPath, bundleResourceGroup, params.chunkDestinationSettings );
+
+					if( processChunkResult.type != ResultType::SUCCESS )
+					{
+						return processChunkResult;
+					}
+
+					numberOfChunks++;
+				}
+				if( !bundleReadOk )
+				{
+					return Result( { ResultType::FAILED_TO_READ_FROM_STREAM } );
+				}
+			}
+		}
+	}
+
+
+	ResourceTools::GetChunk chunkFile;
+
+	chunkFile.clearCache = true;
+
+	bundleStream.Flush();
+
+	if( !( bundleStream >> chunkFile ) )
+	{
+		return Result( { ResultType::FAILED_TO_READ_FROM_STREAM } );
+	}
+
+	std::stringstream ss;
+	ss << chunkBaseName << numberOfChunks << ".chunk";
+	std::string chunkName = ss.str();
+
+	std::filesystem::path chunkPath = params.chunkDestinationSettings.basePath / ss.str();
+
+	Result processChunkResult = ProcessChunk( chunkFile, chunkPath, bundleResourceGroup, params.chunkDestinationSettings );
+
+	if( processChunkResult.type != ResultType::SUCCESS )
+	{
+		return processChunkResult;
+	}
+
+	// Export this resource list
+	//
+	// Update status
+	{
+		StatusSettings exportStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 80, 10, "Exporting ResourceGroups", &exportStatusSettings );
+
+		std::string resourceGroupData;
+
+		Result exportToDataResult = ExportToData( resourceGroupData, exportStatusSettings, outputDocumentVersion );
+
+		if( exportToDataResult.type != ResultType::SUCCESS )
+		{
+			return exportToDataResult;
+		}
+
+
+		ResourceGroupInfo resourceGroupInfo( { params.resourceGroupRelativePath } );
+
+		Result setParametersFromDataResult = resourceGroupInfo.SetParametersFromData( resourceGroupData, m_checksumAlgorithm.GetValue() );
+
+		if( setParametersFromDataResult.type != ResultType::SUCCESS )
+		{
+			return setParametersFromDataResult;
+		}
+
+		ResourcePutDataParams putDataParams;
+
+		putDataParams.resourceDestinationSettings = params.chunkDestinationSettings;
+
+		putDataParams.data = &resourceGroupData;
+
+		Result subtractionResourcePutResult = resourceGroupInfo.PutData( putDataParams );
+
+		if( subtractionResourcePutResult.type != ResultType::SUCCESS )
+		{
+			return subtractionResourcePutResult;
+		}
+
+		// Export the bundleGroup
+		Result setResourceGroupResult = bundleResourceGroup.SetResourceGroup( resourceGroupInfo );
+
+		if( setResourceGroupResult.type != ResultType::SUCCESS )
+		{
+			return setResourceGroupResult;
+		}
+	}
+
+    {
+		std::string patchResourceGroupData;
+
+		StatusSettings exportToDataStatusSettings;
+		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 90, 10, "Exporting ResourceGroups", &exportToDataStatusSettings );
+
+		Result exportBundleResourceGroupToDataResult = bundleResourceGroup.ExportToData( patchResourceGroupData, exportToDataStatusSettings, outputDocumentVersion );
+
+		if( exportBundleResourceGroupToDataResult.type != ResultType::SUCCESS )
+		{
+			return exportBundleResourceGroupToDataResult;
+		}
+
+		BundleResourceGroupInfo patchResourceGroupInfo( { params.resourceGroupBundleRelativePath } );
+
+		Result setPatchParametersFromDataResult = patchResourceGroupInfo.SetParametersFromData( patchResourceGroupData, m_checksumAlgorithm.GetValue() );
+
+		if( setPatchParametersFromDataResult.type != ResultType::SUCCESS )
+		{
+			return setPatchParametersFromDataResult;
+		}
+
+		ResourcePutDataParams bundlePutDataParams;
+
+		bundlePutDataParams.resourceDestinationSettings = params.resourceBundleResourceGroupDestinationSettings;
+
+		bundlePutDataParams.data = &patchResourceGroupData;
+
+		Result patchResourceGroupPutResult = patchResourceGroupInfo.PutData( bundlePutDataParams );
+
+		if( patchResourceGroupPutResult.type != ResultType::SUCCESS )
+		{
+			return patchResourceGroupPutResult;
+		}
+    }
+
+	return Result{ ResultType::SUCCESS };
+}
+
+std::filesystem::path ResourceGroup::ResourceGroupImpl::GetPatchRelativePath( const PatchCreateParams& params, int patchId ) const
+{
+	return params.patchFileRelativePathPrefix.string() + "." + std::to_string( patchId );
+}
+
+Result ResourceGroup::ResourceGroupImpl::ConstructPatchResourceInfo( const PatchCreateParams& params, int patchId, uintmax_t dataOffset, uint64_t patchSourceOffset, ResourceInfo* resourceNext, PatchResourceInfo*& patchResource ) const
+{
+	// Create a resource from patch data
+	std::filesystem::path resourceLatestRelativePath;
+	Result getResourceLatestRelativePathResult = resourceNext->GetRelativePath( resourceLatestRelativePath );
+	if( getResourceLatestRelativePathResult.type != ResultType::SUCCESS )
+	{
+		return getResourceLatestRelativePathResult;
 	}
 
-	Result res = ImportGroupSpecialisedYaml( resourceGroupFile );
+	PatchResourceInfoParams patchResourceInfoParams;
+	patchResourceInfoParams.relativePath = GetPatchRelativePath( params, patchId );
+	patchResourceInfoParams.targetResourceRelativePath = resourceLatestRelativePath;
+	patchResourceInfoParams.dataOffset = dataOffset;
+	patchResourceInfoParams.sourceOffset = patchSourceOffset;
+	patchResource = new PatchResourceInfo( patchResourceInfoParams );
 
-	if( res.type != ResultType::SUCCESS )
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::QueuePatch( const PatchCreateParams& params, std::string previousData, std::string nextData, PatchResourceInfo* patchResource, ResourceTools::PatchPipeline& pipeline, std::vector<GeneratedPatch>& patches ) const
+{
+	// Patch data is filled in once the pipeline has created it
+	patches.push_back( GeneratedPatch{ patchResource, std::string(), pipeline.GetQueuedCount() } );
+
+	ChecksumAlgorithm checksumAlgorithm = m_checksumAlgorithm.GetValue();
+
+	bool calculateCompressions = params.calculateCompressions;
+
+	auto setParametersFromData = [patchResource, checksumAlgorithm, calculateCompressions]( const std::string& patchData ) {
+		return patchData.empty() || patchResource->SetParametersFromData( patchData, checksumAlgorithm, calculateCompressions ).type == ResultType::SUCCESS;
+	};
+
+	if( !pipeline.Queue( std::move( previousData ), std::move( nextData ), setParametersFromData ) )
 	{
-		return res;
+		return Result{ ResultType::FAILED_TO_CREATE_PATCH };
 	}
 
-	YAML::Node resources = resourceGroupFile[m_resourcesParameter.GetTag()];
-	if( !resources.IsDefined() )
+	return Result{ ResultType::SUCCESS };
+}
+
+Result ResourceGroup::ResourceGroupImpl::ReleaseGeneratedPatches( ResourceTools::PatchPipeline& pipeline, std::vector<GeneratedPatch>& patches, bool waitForPipeline, const GeneratedPatchCallback& patchGenerated ) const
+{
+	if( waitForPipeline && !pipeline.Finish() )
 	{
-		return Result{ ResultType::MALFORMED_RESOURCE_GROUP };
+		return Result{ ResultType::FAILED_TO_CREATE_PATCH };
 	}
 
-    {
-		StatusSettings resourcesStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 30, 70, "Processing Resources.", &resourcesStatusSettings );
+	Result result{ ResultType::SUCCESS };
 
-		int i = 0;
+	// Patches are released in order, so release stops at the first patch still in the pipeline
+	size_t releasedCount = 0;
 
-		for( auto iter = resources.begin(); iter != resources.end(); iter++ )
+	for( ; releasedCount < patches.size(); releasedCount++ )
+	{
+		GeneratedPatch& patch = patches[releasedCount];
+
+		if( patch.queuedIndex != GeneratedPatch::NOT_QUEUED )
 		{
-			// This bit is a sequence
-			YAML::Node resourceNode = ( *iter );
+			if( !pipeline.IsPatchFinished( patch.queuedIndex ) )
+			{
+				break;
+			}
 
-			ResourceInfo* resource = nullptr;
+			pipeline.TakePatchData( patch.queuedIndex, patch.data );
 
-			Result createResourceFromYamlResult = CreateResourceFromYaml( resourceNode, resource );
+			patch.queuedIndex = GeneratedPatch::NOT_QUEUED;
+		}
 
-			if( createResourceFromYamlResult.type != ResultType::SUCCESS )
-			{
-				return createResourceFromYamlResult;
-			}
+		result = patchGenerated( patch );
 
-            if (resourcesStatusSettings.RequiresStatusUpdates())
-            {
-				float step = static_cast<float>( 100.0 / resources.size() );
-				float progress = static_cast<float>( i * step );
+		if( result.type != ResultType::SUCCESS )
+		{
+			break;
+		}
+	}
 
-                std::filesystem::path resourcePath;
-				Result getResourcePathResult = resource->GetRelativePath( resourcePath );
+	// A patch that failed to release stays in patches so it is cleaned up by the caller
+	patches.erase( patches.begin(), patches.begin() + releasedCount );
 
-                if( getResourcePathResult.type != ResultType::SUCCESS )
-                {
-					return getResourcePathResult;
-                }
+	return result;
+}
 
-				resourcesStatusSettings.Update( StatusProgressType::PERCENTAGE, progress, step, "Adding resource: " + resourcePath.string() );
-            }
+Result ResourceGroup::ResourceGroupImpl::CreateContentDefinedPatches( const PatchCreateParams& params, ResourceInfo* resourceNext, ResourceTools::FileDataStreamIn& previousFileDataStream, ResourceTools::FileDataStreamIn& nextFileDataStream, std::vector<GeneratedPatch>& patches, const GeneratedPatchCallback& patchGenerated ) const
+{
+	ResourceTools::MemoryMappedFile previousFile;
+	ResourceTools::MemoryMappedFile nextFile;
 
-			Result addResourceResult = AddResource( resource );
+	if( !previousFile.Open( previousFileDataStream.GetPath() ) || !nextFile.Open( nextFileDataStream.GetPath() ) )
+	{
+		return Result{ ResultType::FAILED_TO_OPEN_FILE };
+	}
 
-			if( addResourceResult.type != ResultType::SUCCESS )
-			{
-				return addResourceResult;
-			}
+	std::string_view previousData( previousFile.GetData(), previousFile.GetSize() );
+	std::string_view nextData( nextFile.GetData(), nextFile.GetSize() );
 
-			i++;
+	ResourceTools::ContentDefinedChunkSizes chunkSizes;
+	chunkSizes.minimum = params.contentDefinedChunkMinimumSize;
+	chunkSizes.average = params.contentDefinedChunkAverageSize;
+	chunkSizes.maximum = params.contentDefinedChunkMaximumSize;
+
+	ResourceTools::ChecksumAlgorithm checksumAlgorithm = GetResourceToolsChecksumAlgorithm( m_checksumAlgorithm.GetValue() );
+
+	// Chunks of the previous data by checksum, the first occurrence of repeated content is used
+	std::unordered_map<ResourceTools::Digest128, uint64_t, ResourceTools::Digest128Hash> previousChunks;
+
+	std::vector<size_t> chunkLengths;
+	ResourceTools::GenerateContentDefinedChunks( previousData, chunkSizes, chunkLengths );
+
+	uint64_t previousChunkOffset{ 0 };
+	for( size_t chunkLength : chunkLengths )
+	{
+		ResourceTools::Digest128 checksum;
+		if( !ResourceTools::GenerateChecksum( previousData.substr( previousChunkOffset, chunkLength ), checksumAlgorithm, checksum ) )
+		{
+			return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
 		}
-    }
+		previousChunks.emplace( checksum, previousChunkOffset );
+		previousChunkOffset += chunkLength;
+	}
 
-	return Result{ ResultType::SUCCESS };
-}
+	// Consecutive matching chunks that are also consecutive in the previous data become a single patch without data
+	uint64_t matchNextOffset{ 0 };
+	uint64_t matchSourceOffset{ 0 };
+	uint64_t matchSize{ 0 };
 
-std::string ResourceGroup::ResourceGroupImpl::GetType() const
-{
-	return TypeId();
-}
+	// Consecutive unmatched chunks are diffed together, up to maxInputFileChunkSize at a time
+	uint64_t unmatchedNextOffset{ 0 };
+	uint64_t unmatchedSize{ 0 };
 
-std::string ResourceGroup::ResourceGroupImpl::TypeId()
-{
-	return "ResourceGroup";
-}
+	// Unmatched data is diffed against the previous data following the last match, as in fixed size chunking
+	uint64_t patchSourceOffset{ 0 };
 
-Result ResourceGroup::ResourceGroupImpl::ImportGroupSpecialisedYaml( YAML::Node& resourceGroupFile )
-{
-	return Result{ ResultType::SUCCESS };
-}
+	// Temporary ids, final ids are assigned when patches are committed
+	int patchCount{ 0 };
 
-Result ResourceGroup::ResourceGroupImpl::ExportGroupSpecialisedYaml( YAML::Emitter& out, VersionInternal outputDocumentVersion ) const
-{
-	return Result{ ResultType::SUCCESS };
-}
+	ResourceTools::PatchPipeline pipeline( params.diffThreadCount );
 
-Result ResourceGroup::ResourceGroupImpl::ExportYaml( const VersionInternal& outputDocumentVersion, std::string& data, StatusSettings& statusSettings ) const
-{
-	statusSettings.Update( StatusProgressType::PERCENTAGE, 0, 20, "Exporting Yaml" );
+	auto addMatchPatch = [&]() -> Result {
+		if( matchSize == 0 )
+		{
+			return Result{ ResultType::SUCCESS };
+		}
 
-	YAML::Emitter out;
+		PatchResourceInfo* patchResource{ nullptr };
 
-	// Output header information
-	out << YAML::BeginMap;
+		Result constructPatchResult = ConstructPatchResourceInfo( params, patchCount++, matchNextOffset, matchSourceOffset, resourceNext, patchResource );
 
-	// It is possible to export a different version that the imported version
-	// The version must be less than the version of the document and also no higher than supported by the binary at compile
-	// Ensure document version is valid
-	if( !outputDocumentVersion.isVersionValid() )
+		if( constructPatchResult.type != ResultType::SUCCESS )
+		{
+			return constructPatchResult;
+		}
+
+		if( previousFileDataStream.IsFinished() )
+		{
+			previousFileDataStream.StartRead( previousFileDataStream.GetPath() );
+		}
+
+		previousFileDataStream.Seek( matchSourceOffset );
+
+		Result setParametersResult = patchResource->SetParametersFromSourceStream( previousFileDataStream, matchSize, m_checksumAlgorithm.GetValue() );
+
+		if( setParametersResult.type != ResultType::SUCCESS )
+		{
+			delete patchResource;
+
+			return setParametersResult;
+		}
+
+		patches.push_back( GeneratedPatch{ patchResource, std::string(), GeneratedPatch::NOT_QUEUED } );
+
+		patchSourceOffset = matchSourceOffset + matchSize;
+
+		matchSize = 0;
+
+		return ReleaseGeneratedPatches( pipeline, patches, false, patchGenerated );
+	};
+
+	auto addDataPatch = [&]( uint64_t size ) -> Result {
+		// Patch application reads up to maxInputFileChunkSize of previous data from the source offset
+		uint64_t sourceOffset = std::min<uint64_t>( patchSourceOffset, previousData.size() );
+		std::string previousFileData( previousData.substr( sourceOffset, params.maxInputFileChunkSize ) );
+		std::string nextFileData( nextData.substr( unmatchedNextOffset, size ) );
+
+		patchSourceOffset = sourceOffset + previousFileData.size();
+
+		PatchResourceInfo* patchResource{ nullptr };
+
+		Result constructPatchResult = ConstructPatchResourceInfo( params, patchCount++, unmatchedNextOffset, sourceOffset, resourceNext, patchResource );
+
+		if( constructPatchResult.type != ResultType::SUCCESS )
+		{
+			return constructPatchResult;
+		}
+
+		Result queuePatchResult = QueuePatch( params, std::move( previousFileData ), std::move( nextFileData ), patchResource, pipeline, patches );
+
+		if( queuePatchResult.type != ResultType::SUCCESS )
+		{
+			return queuePatchResult;
+		}
+
+		unmatchedNextOffset += size;
+		unmatchedSize -= size;
+
+		return ReleaseGeneratedPatches( pipeline, patches, false, patchGenerated );
+	};
+
+	ResourceTools::GenerateContentDefinedChunks( nextData, chunkSizes, chunkLengths );
+
+	uint64_t nextChunkOffset{ 0 };
+	for( size_t chunkLength : chunkLengths )
 	{
-		return Result{ ResultType::DOCUMENT_VERSION_UNSUPPORTED };
+		std::string_view chunk = nextData.substr( nextChunkOffset, chunkLength );
+
+		ResourceTools::Digest128 checksum;
+		if( !ResourceTools::GenerateChecksum( chunk, checksumAlgorithm, checksum ) )
+		{
+			return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
+		}
+
+		auto previousChunk = previousChunks.find( checksum );
+
+		// Checksum equality is confirmed against the data as a false match would only be caught when the patch is applied
+		bool chunkMatchFound = previousChunk != previousChunks.end() && previousData.substr( previousChunk->second, chunkLength ) == chunk;
+
+		if( chunkMatchFound )
+		{
+			if( unmatchedSize > 0 )
+			{
+				Result addDataPatchResult = addDataPatch( unmatchedSize );
+
+				if( addDataPatchResult.type != ResultType::SUCCESS )
+				{
+					return addDataPatchResult;
+				}
+			}
+
+			if( matchSize > 0 && matchNextOffset + matchSize == nextChunkOffset && matchSourceOffset + matchSize == previousChunk->second )
+			{
+				matchSize += chunkLength;
+			}
+			else
+			{
+				Result addMatchPatchResult = addMatchPatch();
+
+				if( addMatchPatchResult.type != ResultType::SUCCESS )
+				{
+					return addMatchPatchResult;
+				}
+
+				matchNextOffset = nextChunkOffset;
+				matchSourceOffset = previousChunk->second;
+				matchSize = chunkLength;
+			}
+		}
+		else
+		{
+			Result addMatchPatchResult = addMatchPatch();
+
+			if( addMatchPatchResult.type != ResultType::SUCCESS )
+			{
+				return addMatchPatchResult;
+			}
+
+			if( unmatchedSize == 0 )
+			{
+				unmatchedNextOffset = nextChunkOffset;
+			}
+			unmatchedSize += chunkLength;
+
+			while( unmatchedSize >= params.maxInputFileChunkSize )
+			{
+				Result addDataPatchResult = addDataPatch( params.maxInputFileChunkSize );
+
+				if( addDataPatchResult.type != ResultType::SUCCESS )
+				{
+					return addDataPatchResult;
+				}
+			}
+		}
+
+		nextChunkOffset += chunkLength;
 	}
 
-	VersionInternal sanitisedOutputDocumentVersion = outputDocumentVersion;
-	const VersionInternal documentCurrentVersion = m_versionParameter.GetValue();
+	Result addMatchPatchResult = addMatchPatch();
 
-	if( sanitisedOutputDocumentVersion > documentCurrentVersion )
+	if( addMatchPatchResult.type != ResultType::SUCCESS )
 	{
-		sanitisedOutputDocumentVersion = documentCurrentVersion;
+		return addMatchPatchResult;
 	}
 
-	if( sanitisedOutputDocumentVersion > S_DOCUMENT_VERSION )
+	if( unmatchedSize > 0 )
 	{
-		sanitisedOutputDocumentVersion = S_DOCUMENT_VERSION;
+		Result addDataPatchResult = addDataPatch( unmatchedSize );
+
+		if( addDataPatchResult.type != ResultType::SUCCESS )
+		{
+			return addDataPatchResult;
+		}
 	}
 
-	//Export document parameters
-	out << YAML::Key << m_versionParameter.GetTag();
-	out << YAML::Value << sanitisedOutputDocumentVersion.ToString();
+	return ReleaseGeneratedPatches( pipeline, patches, true, patchGenerated );
+}
 
-	out << YAML::Key << m_type.GetTag();
-	out << YAML::Value << m_type.GetValue();
+Result ResourceGroup::ResourceGroupImpl::CreateResourcePatches( const PatchCreateParams& params, ResourceInfo* resourcePrevious, ResourceInfo* resourceNext, const std::filesystem::path& indexFolder, StatusSettings& statusSettings, std::vector<GeneratedPatch>& patches, const GeneratedPatchCallback& patchGenerated ) const
+{
+	size_t patchSourceOffset{ 0 };
+	uint64_t patchSourceOffsetDelta{ 0 };
 
-	out << YAML::Key << m_numberOfResources.GetTag();
-	out << YAML::Value << m_numberOfResources.GetValue();
+	// Check to see if previous entry contains dummy information
+	// Suggesting that this is a new entry in latest
+	// In which case there is no reason to create a patch
+	// The new entry will be stored with the ResourceGroup related to the PatchResourceGroup
+	uintmax_t previousUncompressedSize;
 
-    if (m_totalResourcesSizeCompressed.HasValue())
-    {
-		uintmax_t compressedSize = m_totalResourcesSizeCompressed.GetValue();
+	Result getResourcePreviousCompressedSizeResult = resourcePrevious->GetUncompressedSize( previousUncompressedSize );
 
-		out << YAML::Key << m_totalResourcesSizeCompressed.GetTag();
-		out << YAML::Value << compressedSize;
-		
-    }
+	if( getResourcePreviousCompressedSizeResult.type != ResultType::SUCCESS )
+	{
+		return getResourcePreviousCompressedSizeResult;
+	}
 
-	out << YAML::Key << m_totalResourcesSizeUncompressed.GetTag();
-	out << YAML::Value << m_totalResourcesSizeUncompressed.GetValue();
 
-	Result res = ExportGroupSpecialisedYaml( out, sanitisedOutputDocumentVersion );
 
-	if( res.type != ResultType::SUCCESS )
+	uintmax_t nextUncompressedSize;
+
+	Result getResourceNextCompressedSizeResult = resourceNext->GetUncompressedSize( nextUncompressedSize );
+
+	if( getResourceNextCompressedSizeResult.type != ResultType::SUCCESS )
 	{
-		return res;
+		return getResourceNextCompressedSizeResult;
 	}
 
-	out << YAML::Key << m_resourcesParameter.GetTag();
 
-	out << YAML::Value << YAML::BeginSeq;
+	// If previous size is 0 this suggests that this is a new entry in latest
+	// In which case there is no reason to create a patch
+	if( previousUncompressedSize != 0 )
+	{
+		// Get resource data previous
+		auto previousFileDataStream = std::make_shared<ResourceTools::FileDataStreamIn>( params.maxInputFileChunkSize );
 
-	int i = 0;
+		ResourceGetDataStreamParams previousResourceGetDataStreamParams;
 
-    {
-		StatusSettings detailExportingStatusSettings;
-		statusSettings.Update( StatusProgressType::PERCENTAGE, 20, 80, "Exporting Yaml", &detailExportingStatusSettings );
+		previousResourceGetDataStreamParams.resourceSourceSettings = params.resourceSourceSettingsPrevious;
 
-		for( ResourceInfo* r : m_resourcesParameter )
-		{
-			// Update status
-			if( detailExportingStatusSettings.RequiresStatusUpdates() )
-			{
-				std::filesystem::path relativePath;
+		previousResourceGetDataStreamParams.downloadRetrySeconds = params.downloadRetrySeconds;
 
-				Result getRelativePathResult = r->GetRelativePath( relativePath );
+		previousResourceGetDataStreamParams.dataStream = previousFileDataStream;
 
-				if( getRelativePathResult.type != ResultType::SUCCESS )
-				{
-					return Result{ ResultType::FAIL };
-				}
+		Result getPreviousDataStreamResult = resourcePrevious->GetDataStream( previousResourceGetDataStreamParams );
 
-				float step = static_cast<float>( 100.0 / m_resourcesParameter.GetSize() );
-				float percentage = static_cast<float>( step * i );
+		if( getPreviousDataStreamResult.type != ResultType::SUCCESS )
+		{
+			return getPreviousDataStreamResult;
+		}
 
-				std::string message = "Exporting: " + relativePath.string();
+		// Get resource data next
+		auto nextFileDataStream = std::make_shared<ResourceTools::FileDataStreamIn>( params.maxInputFileChunkSize );
 
-				detailExportingStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, message );
+		ResourceGetDataStreamParams nextResourceGetDataStreamParams;
 
-				i++;
-			}
+		nextResourceGetDataStreamParams.resourceSourceSettings = params.resourceSourceSettingsNext;
 
-			out << YAML::BeginMap;
+		nextResourceGetDataStreamParams.dataStream = nextFileDataStream;
 
-			Result resourceExportResult = r->ExportToYaml( out, sanitisedOutputDocumentVersion );
+		Result getNextDataStreamResult = resourceNext->GetDataStream( nextResourceGetDataStreamParams );
 
-			if( resourceExportResult.type != ResultType::SUCCESS )
-			{
-				return resourceExportResult;
-			}
+		if( getNextDataStreamResult.type != ResultType::SUCCESS )
+		{
+			return getNextDataStreamResult;
+		}
 
-			out << YAML::EndMap;
+		std::filesystem::path relativePath;
+		Result getRelativePathResult = resourcePrevious->GetRelativePath( relativePath );
+		if( getRelativePathResult.type != ResultType::SUCCESS )
+		{
+			return getRelativePathResult;
 		}
 
-		out << YAML::EndSeq;
+		// Content defined chunks are matched by checksum so no index of the previous data is needed
+		if( params.chunkingMode == PatchChunkingMode::CONTENT_DEFINED )
+		{
+			return CreateContentDefinedPatches( params, resourceNext, *previousFileDataStream, *nextFileDataStream, patches, patchGenerated );
+		}
 
-		out << YAML::EndMap;
+		ResourceTools::ChunkIndex index( previousFileDataStream->GetPath(), params.maxInputFileChunkSize, indexFolder, params.chunkIndexMemoryBudget, params.chunkIndexThreadCount );
 
-		data = out.c_str();
-    }
-    
+		bool indexFromCache{ false };
 
-	return Result{ ResultType::SUCCESS };
-}
+		if( params.chunkIndexCacheSize > 0 )
+		{
+			ResourceTools::ChunkIndexCache indexCache( params.indexFolder / "cache", params.chunkIndexCacheSize );
+
+			ResourceTools::Digest128 previousChecksum;
+
+			Result getPreviousChecksumResult = resourcePrevious->GetChecksum( previousChecksum );
 
-Result ResourceGroup::ResourceGroupImpl::ExportCsv( const VersionInternal& outputDocumentVersion, std::string& data, StatusSettings& statusSettings ) const
-{
-	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 10, "Exporting  to CSV" );
+			if( getPreviousChecksumResult.type != ResultType::SUCCESS )
+			{
+				return getPreviousChecksumResult;
+			}
 
-	if( outputDocumentVersion.getMajor() > 0 || outputDocumentVersion.getMinor() > 0 || outputDocumentVersion.getPatch() > 0 )
-	{
-		return Result{ ResultType::UNSUPPORTED_FILE_FORMAT };
-	}
+			std::string indexKey = ResourceTools::ChunkIndexCache::CreateKey( previousChecksum, params.maxInputFileChunkSize );
 
-	std::string out;
+			indexFromCache = indexCache.Load( indexKey, index ) || indexCache.Store( indexKey, previousFileDataStream->GetPath(), params.maxInputFileChunkSize, params.chunkIndexThreadCount, index );
+		}
 
+		// Falls back to an index for this patch only if the cache is disabled or could not be used
+		if( !indexFromCache )
+		{
+			index.GenerateChecksumFilter( nextFileDataStream->GetPath(), params.chunkIndexFilterFalsePositiveRate );
 
-	auto resourceInfos = m_resourcesParameter.GetValue();
-	std::sort(
-		resourceInfos->begin(),
-		resourceInfos->end(),
-		[]( ResourceInfo* a, ResourceInfo* b ) {
-			std::filesystem::path ap;
-			std::filesystem::path bp;
-			a->GetRelativePath( ap );
-			b->GetRelativePath( bp );
-			return ap < bp;
-		} );
+			if( !index.Generate() )
+			{
+				std::string message = "Index generation failed for " + relativePath.string();
+				statusSettings.Update( StatusProgressType::WARNING, 0, 0, message );
+			}
+			else
+			{
+				uint64_t filterHitCount = index.GetFilterHitCount();
+				uint64_t windowCount = filterHitCount + index.GetFilterMissCount();
+				std::string message = "Indexed " + std::to_string( filterHitCount ) + " of " + std::to_string( windowCount ) + " windows for " + relativePath.string();
+				statusSettings.Update( StatusProgressType::UNBOUNDED, 0, 0, message );
+			}
+		}
 
-	int i{ 0 };
+		// Temporary ids, final ids are assigned when patches are committed
+		int patchCount{ 0 };
 
-    {
-		StatusSettings detailExportStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 10, 90, "Exporting  to CSV", &detailExportStatusSettings );
+		ResourceTools::PatchPipeline pipeline( params.diffThreadCount );
 
-		for( ResourceInfo* r : m_resourcesParameter )
+		// Process one chunk at a time
+		for( uintmax_t dataOffset = 0; dataOffset < nextUncompressedSize; dataOffset += params.maxInputFileChunkSize )
 		{
-			// Update status
-			if( detailExportStatusSettings.RequiresStatusUpdates() )
+			std::string previousFileData = "";
+
+			if( previousFileDataStream->IsFinished() )
 			{
-				float step = static_cast<float>( 100.0 / m_resourcesParameter.GetValue()->size() );
-				float percentage = static_cast<float>( step * i );
-				detailExportStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentage, step, "Percentage Update" );
-				i++;
+				if( previousFileDataStream->Size() > nextFileDataStream->GetCurrentPosition() )
+				{
+					// We ran out of data because we found a chunk match later in the file,
+					// but we can rewind back to where the read stream is in hopes
+					// of getting a good diff, rather than just treating it as new data.
+					previousFileDataStream->StartRead( previousFileDataStream->GetPath() );
+				}
 			}
 
-			Result resourceExportResult = r->ExportToCsv( out, m_versionParameter.GetValue() );
-			if( resourceExportResult.type != ResultType::SUCCESS )
+			// Handling if previous file is smaller than next file
+			// If so then previousFileData will be nothing and
+			// All next data will be used for the patch
+			if( !previousFileDataStream->IsFinished() )
 			{
-				return resourceExportResult;
+				if( !( *previousFileDataStream >> previousFileData ) )
+				{
+					return Result{ ResultType::FAILED_TO_RETRIEVE_CHUNK_DATA };
+				}
 			}
-			data += out + "\n";
-		}
-    }
 
-	return Result{ ResultType::SUCCESS };
-}
+			size_t nextStreamPosition = nextFileDataStream->GetCurrentPosition();
+			// Note: in the case that the next file is smaller than previous
+			// nothing is stored, application of the patch will chop off the extra file data
+			std::string nextFileData;
 
-Result ResourceGroup::ResourceGroupImpl::ProcessChunk( ResourceTools::GetChunk& chunkFile, const std::filesystem::path& chunkRelativePath, BundleResourceGroup::BundleResourceGroupImpl& bundleResourceGroup, const ResourceDestinationSettings& chunkDestinationSettings ) const
-{
-	// Create resource from Patch Data
-	BundleResourceInfo* chunkResource = new BundleResourceInfo( { chunkRelativePath } );
+			if( !nextFileDataStream->IsFinished() )
+			{
+				if( !( *nextFileDataStream >> nextFileData ) )
+				{
+					return Result{ ResultType::FAILED_TO_RETRIEVE_CHUNK_DATA };
+				}
+			}
 
-	// md5 Checksum
-	ResourceTools::Md5ChecksumStream checksumStream;
+			bool chunkMatchFound{ false };
+			size_t matchCount{ 0 };
 
-	std::string checksum;
-	{
-		std::string chunk;
 
-		while( *chunkFile.uncompressedChunkIn >> chunk )
-		{
-			checksumStream << chunk;
-		}
-	}
+			if( previousFileData != "" )
+			{
+				// Here's how this should work:
+				// We find a matching chunk if it exists. If the chunk exists we make a patch with no data, because we'll get
+				// the data from the source file using the patch info. Consecutive patches should be collapsed into one big one.
+				// If we can't find a matching chunk, we will base the current diff off the chunk in the source starting after the final byte
+				// in the chunk from the source file that we last used.
+				// These should keep our patches pretty minimal, even if lots of data gets added early in the file causing offsets.
+				// It should also handle small changes in moved parts of the file pretty well.
+				chunkMatchFound = index.FindMatchingChunk( nextFileData, patchSourceOffset );
+
+				if( chunkMatchFound )
+				{
+					matchCount = 1;
+					matchCount += ResourceTools::CountMatchingChunks(
+						nextFileDataStream->GetPath(),
+						nextFileDataStream->GetCurrentPosition(),
+						previousFileDataStream->GetPath(),
+						patchSourceOffset + params.maxInputFileChunkSize,
+						params.maxInputFileChunkSize );
 
-	if( !checksumStream.FinishAndRetrieve( checksum ) )
-	{
-		return Result( { ResultType::FAILED_TO_GENERATE_CHECKSUM } );
-	}
+					size_t matchSize = std::min( params.maxInputFileChunkSize * matchCount, previousFileDataStream->Size() - patchSourceOffset );
 
-	chunkResource->SetDataChecksum( checksum );
+					PatchResourceInfo* patchResource{ nullptr };
 
-	// Compressed Size
-	chunkResource->SetCompressedSize( chunkFile.compressedChunkIn->Size() );
+					ConstructPatchResourceInfo( params, patchCount++, dataOffset, patchSourceOffset, resourceNext, patchResource );
 
-	// Uncompressed Size
-	chunkResource->SetUncompressedSize( chunkFile.uncompressedChunkIn->Size() );
+					if( previousFileDataStream->IsFinished() )
+					{
+						previousFileDataStream->StartRead( previousFileDataStream->GetPath() );
+					}
 
-	// Export chunk file
-	std::filesystem::path sourceFile;
+					previousFileDataStream->Seek( patchSourceOffset );
 
-	if( chunkDestinationSettings.destinationType == ResourceDestinationType::REMOTE_CDN )
-	{
-		sourceFile = chunkFile.compressedChunkIn->GetPath();
-	}
-	else
-	{
-		sourceFile = chunkFile.uncompressedChunkIn->GetPath();
-	}
+					patchResource->SetParametersFromSourceStream( *previousFileDataStream, matchSize, m_checksumAlgorithm.GetValue() );
 
-	std::filesystem::path targetFile;
+					// Advance the first stream by the size of the matching data,
+					// but move the point we generate patches from for the previous
+					// file data stream to the end of the match.
+					// It's hard to tell if it would be smarter to simply advance
+					// the destination data by the same amount of the source data,
+					// or perhaps even not to move it at all.
+					nextFileDataStream->Seek( std::min( nextFileDataStream->Size(), nextStreamPosition + matchSize ) );
 
-	if( chunkDestinationSettings.destinationType == ResourceDestinationType::LOCAL_RELATIVE )
-	{
-		std::filesystem::path relativePath;
+					previousFileDataStream->Seek( std::min( previousFileDataStream->Size(), patchSourceOffset + matchSize ) );
 
-		chunkResource->GetRelativePath( relativePath );
+					dataOffset += matchSize - params.maxInputFileChunkSize;
 
-		targetFile = chunkDestinationSettings.basePath / relativePath;
-	}
-	else
-	{
-		std::string location;
+					patchSourceOffset += matchSize;
 
-		chunkResource->GetLocation( location );
+					if( nextStreamPosition == 0 && patchSourceOffset == 0 )
+					{
+						// This is the beginning of the file and it matches.
+						// There is no need to write patch data.
+						delete patchResource;
 
-		targetFile = chunkDestinationSettings.basePath / location;
-	}
+						continue;
+					}
 
-	if( std::filesystem::exists( targetFile ) )
-	{
-		std::filesystem::remove( targetFile );
-	}
+					patches.push_back( GeneratedPatch{ patchResource, std::string(), GeneratedPatch::NOT_QUEUED } );
 
-	if( !std::filesystem::exists( targetFile.parent_path() ) )
-	{
-		std::filesystem::create_directories( targetFile.parent_path() );
-	}
+					Result releasePatchesResult = ReleaseGeneratedPatches( pipeline, patches, false, patchGenerated );
 
-	try
-	{
-		std::filesystem::copy_file( sourceFile, targetFile );
-	}
-	catch( std::filesystem::filesystem_error& e )
-	{
-		return Result( { ResultType::FAILED_TO_SAVE_FILE, e.what() } );
-	}
+					if( releasePatchesResult.type != ResultType::SUCCESS )
+					{
+						return releasePatchesResult;
+					}
 
-	// Add the chunk resource to the bundleResourceGroup
-	Result addResourceResult = bundleResourceGroup.AddResource( chunkResource );
+					continue;
+				}
+				else
+				{
+					// Previous and next data chunk are different, create a patch
+					patchSourceOffsetDelta = previousFileData.size();
+				}
+			}
+			else
+			{
+				// If there is no previous data then just store the data straight from the file
+				// All this data is new
+				patchSourceOffsetDelta = nextFileData.size();
+			}
 
-	if( addResourceResult.type != ResultType::SUCCESS )
-	{
-		delete chunkResource;
+			PatchResourceInfo* patchResource{ nullptr };
+			ConstructPatchResourceInfo( params, patchCount++, dataOffset, patchSourceOffset, resourceNext, patchResource );
+			patchSourceOffset += patchSourceOffsetDelta;
 
-		return addResourceResult;
+			// Source data for the patch is decided so it can be created while later chunks are matched
+			Result queuePatchResult = QueuePatch( params, std::move( previousFileData ), std::move( nextFileData ), patchResource, pipeline, patches );
+
+			if( queuePatchResult.type != ResultType::SUCCESS )
+			{
+				return queuePatchResult;
+			}
+
+			Result releasePatchesResult = ReleaseGeneratedPatches( pipeline, patches, false, patchGenerated );
+
+			if( releasePatchesResult.type != ResultType::SUCCESS )
+			{
+				return releasePatchesResult;
+			}
+		}
+
+		Result releasePatchesResult = ReleaseGeneratedPatches( pipeline, patches, true, patchGenerated );
+
+		if( releasePatchesResult.type != ResultType::SUCCESS )
+		{
+			return releasePatchesResult;
+		}
+
+		const ResourceTools::ChunkIndex::MatchStatistics& matchStatistics = index.GetMatchStatistics();
+		if( matchStatistics.candidates > 0 )
+		{
+			std::string message = "Verified " + std::to_string( matchStatistics.candidates ) + " candidate chunks for " + relativePath.string() + ", " + std::to_string( matchStatistics.collisions ) + " rolling checksum collisions, " + std::to_string( matchStatistics.strongChecksumCacheHits ) + " strong checksums reused";
+			statusSettings.Update( StatusProgressType::UNBOUNDED, 0, 0, message );
+		}
 	}
 
 	return Result{ ResultType::SUCCESS };
 }
 
-Result ResourceGroup::ResourceGroupImpl::CreateBundle( const BundleCreateParams& params, StatusSettings& statusSettings ) const
+Result ResourceGroup::ResourceGroupImpl::CommitPatch( const PatchCreateParams& params, GeneratedPatch& patch, PatchResourceGroup::PatchResourceGroupImpl& patchResourceGroup, int& patchId, StoredPatchData& storedPatchData ) const
 {
-	// Update status
-	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 5, "Creating Bundle" );
+	// Data stored by location can be shared, data stored by relative path is separate for each patch
+	bool shareStoredData = params.resourcePatchBinaryDestinationSettings.destinationType != ResourceDestinationType::LOCAL_RELATIVE;
 
-	uintmax_t numberOfChunks = 0;
+	// Ids continue on from the patches of previous resources
+	patch.patchResource->SetRelativePath( GetPatchRelativePath( params, patchId ) );
 
-	std::string chunkBaseName = params.resourceGroupRelativePath.filename().replace_extension().string();
+	if( !patch.data.empty() )
+	{
+		std::string checksum;
 
-	BundleResourceGroup::BundleResourceGroupImpl bundleResourceGroup;
+		Result getChecksumResult = patch.patchResource->GetChecksum( checksum );
 
-	Result setChunkSizeResult = bundleResourceGroup.SetChunkSize( params.chunkSize );
+		if( getChecksumResult.type != ResultType::SUCCESS )
+		{
+			return getChecksumResult;
+		}
 
-	if( setChunkSizeResult.type != ResultType::SUCCESS )
-	{
-		return setChunkSizeResult;
-	}
+		std::string storedDataKey = checksum + "_" + std::to_string( patch.data.size() );
 
-	ResourceTools::BundleStreamOut bundleStream( params.chunkSize, params.chunkDestinationSettings.basePath );
+		auto storedLocation = storedPatchData.locations.find( storedDataKey );
 
+		if( shareStoredData && storedLocation != storedPatchData.locations.end() )
+		{
+			// Identical data is already stored for an earlier patch
+			patch.patchResource->SetLocation( storedLocation->second );
 
-	// Update status
-	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 5, 40, "Generating Chunks" );
+			storedPatchData.sharedPatchCount++;
 
-	int i = 0;
+			storedPatchData.sharedPatchSize += patch.data.size();
+		}
+		else
+		{
+			// Location is generated from the relative path so must follow the final id
+			Result updateLocationResult = patch.patchResource->UpdateLocation();
 
-	std::vector<ResourceInfo*> toBundle;
+			if( updateLocationResult.type != ResultType::SUCCESS )
+			{
+				return updateLocationResult;
+			}
 
-	std::copy( m_resourcesParameter.begin(), m_resourcesParameter.end(), std::back_inserter( toBundle ) );
+			// Export patch file
+			ResourcePutDataParams resourcePutDataParams;
 
-	Result getGroupSpecificResourcesToBundleResult = GetGroupSpecificResourcesToBundle( toBundle );
+			resourcePutDataParams.resourceDestinationSettings = params.resourcePatchBinaryDestinationSettings;
 
-	if( getGroupSpecificResourcesToBundleResult.type != ResultType::SUCCESS )
-	{
-		return getGroupSpecificResourcesToBundleResult;
-	}
+			resourcePutDataParams.data = &patch.data;
 
-	// Loop through all resources and send data for chunking
-	{
-		StatusSettings fileProcessingDetailStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 45, 35, "Generating Chunks", &fileProcessingDetailStatusSettings );
+			Result putPatchDataResult = patch.patchResource->PutData( resourcePutDataParams );
 
+			if( putPatchDataResult.type != ResultType::SUCCESS )
+			{
+				return putPatchDataResult;
+			}
 
-		for( ResourceInfo* resource : toBundle )
-		{
 			std::string location;
 
-			Result getLocationResult = resource->GetLocation( location );
+			Result getLocationResult = patch.patchResource->GetLocation( location );
 
 			if( getLocationResult.type != ResultType::SUCCESS )
 			{
 				return getLocationResult;
 			}
 
-			if( fileProcessingDetailStatusSettings.RequiresStatusUpdates() )
-			{
-				std::filesystem::path relativePath;
+			storedPatchData.locations.emplace( storedDataKey, location );
+		}
 
-				Result getRelativePathResult = resource->GetRelativePath( relativePath );
+		std::string().swap( patch.data );
+	}
 
-				if( getRelativePathResult.type != ResultType::SUCCESS )
-				{
-					return getRelativePathResult;
-				}
+	// Add the patch resource to the patchResourceGroup
+	Result addResourceResult = patchResourceGroup.AddResource( patch.patchResource );
 
-				std::string message;
+	if( addResourceResult.type != ResultType::SUCCESS )
+	{
+		return addResourceResult;
+	}
 
-				if( location.empty() )
-				{
-					message = "No file to process: " + relativePath.string();
-				}
-				else
-				{
-					message = "Processing: " + relativePath.string();
-				}
+	patch.patchResource = nullptr;
 
-				float step = static_cast<float>( 100.0 / toBundle.size() );
-				float percentComplete = static_cast<float>( step * i );
+	patchId++;
 
-				i++;
+	return Result{ ResultType::SUCCESS };
+}
 
-				fileProcessingDetailStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentComplete, step, message );
-			}
-			if( location.empty() )
-			{
-				continue;
-			}
+Result ResourceGroup::ResourceGroupImpl::CreatePatchesParallel( const PatchCreateParams& params, ResourceGroupImpl& resourceGroupPrevious, ResourceGroupImpl& resourceGroupNext, unsigned int threadCount, PatchResourceGroup::PatchResourceGroupImpl& patchResourceGroup, StoredPatchData& storedPatchData, StatusSettings& statusSettings ) const
+{
+	size_t resourceCount = resourceGroupNext.m_resourcesParameter.GetSize();
 
-			auto resourceDataStream = std::make_shared<ResourceTools::FileDataStreamIn>( params.fileReadChunkSize );
+	// Workers create the patches of resources in any order, patches are committed to the patch group
+	// in resource order on this thread so patch ids and order are the same as when patches are created serially
+	// Patches of the resource being committed are taken as soon as they are generated, patches of later
+	// resources are held until then and workers wait once the data held exceeds the pending patch data budget
+	std::vector<std::vector<GeneratedPatch>> pendingPatches( resourceCount );
 
-			ResourceGetDataStreamParams resourceGetDataParams;
+	std::vector<Result> results( resourceCount, Result{ ResultType::SUCCESS } );
 
-			resourceGetDataParams.resourceSourceSettings = params.resourceSourceSettings;
+	std::vector<bool> processed( resourceCount, false );
 
-			resourceGetDataParams.dataStream = resourceDataStream;
+	uintmax_t pendingPatchDataSize = 0;
 
-			resourceGetDataParams.downloadRetrySeconds = params.downloadRetrySeconds;
+	size_t committingResource = 0;
 
-			Result resourceGetDataResult = resource->GetDataStream( resourceGetDataParams );
+	std::mutex processedMutex;
 
-			bundleStream << resourceDataStream;
+	std::condition_variable processedCondition;
 
-			if( resourceGetDataResult.type != ResultType::SUCCESS )
-			{
-				return resourceGetDataResult;
-			}
+	std::atomic<size_t> nextResource = 0;
 
+	std::atomic<bool> cancelled = false;
 
-			while( !resourceDataStream->IsFinished() )
-			{
-				std::string resourceDataChunk;
+	// Workers index and diff at the same time, so the memory budget and nested thread counts are divided between them
+	PatchCreateParams workerParams = params;
 
-				if( !( *resourceDataStream >> resourceDataChunk ) )
-				{
-					return Result{ ResultType::FAILED_TO_READ_FROM_STREAM };
-				}
+	auto divideThreadCount = [threadCount]( unsigned int nestedThreadCount ) {
+		if( nestedThreadCount == 0 )
+		{
+			nestedThreadCount = std::max( 1u, std::thread::hardware_concurrency() );
+		}
+
+		return std::max( 1u, nestedThreadCount / threadCount );
+	};
+
+	workerParams.chunkIndexMemoryBudget = params.chunkIndexMemoryBudget / threadCount;
+
+	workerParams.chunkIndexThreadCount = divideThreadCount( params.chunkIndexThreadCount );
+
+	workerParams.diffThreadCount = divideThreadCount( params.diffThreadCount );
+
+	auto worker = [&]( unsigned int workerIndex ) {
+		// Status callbacks are not thread safe, workers report nothing
+		// and progress is reported as patches are committed
+		StatusSettings workerStatusSettings;
 
-				// Loop through possible created chunks
-				ResourceTools::GetChunk chunkFile;
+		// Index files are named after the file indexed, a folder per worker keeps files of the same name apart
+		std::filesystem::path workerIndexFolder = params.indexFolder / ( "worker" + std::to_string( workerIndex ) );
 
-				chunkFile.clearCache = false;
+		while( !cancelled )
+		{
+			size_t resourceIndex = nextResource++;
 
-				bool bundleReadOk{ true };
+			if( resourceIndex >= resourceCount )
+			{
+				return;
+			}
 
-				while( ( bundleReadOk = bundleStream >> chunkFile ) && !chunkFile.outOfChunks )
+			// Patches can only be committed on the calling thread so they are handed over as they are generated
+			// The resource being committed is never held back so the calling thread can always make progress
+			auto collectPatch = [&, resourceIndex]( GeneratedPatch& patch ) {
 				{
-					std::stringstream ss;
-					ss << chunkBaseName << numberOfChunks << ".chunk";
-					std::string chunkName = ss.str();
-
-					std::filesystem::path chunkPath = params.chunkDestinationSettings.basePath / ss.str();
+					std::unique_lock<std::mutex> lock( processedMutex );
 
-					Result processChunkResult = ProcessChunk( chunkFile, chunkPath, bundleResourceGroup, params.chunkDestinationSettings );
+					processedCondition.wait( lock, [&]() { return cancelled || resourceIndex == committingResource || pendingPatchDataSize < params.pendingPatchDataMemoryBudget; } );
 
-					if( processChunkResult.type != ResultType::SUCCESS )
+					if( cancelled )
 					{
-						return processChunkResult;
+						return Result{ ResultType::FAIL };
 					}
 
-					numberOfChunks++;
-				}
-				if( !bundleReadOk )
-				{
-					return Result( { ResultType::FAILED_TO_READ_FROM_STREAM } );
+					pendingPatchDataSize += patch.data.size();
+
+					pendingPatches[resourceIndex].push_back( std::move( patch ) );
+
+					patch.patchResource = nullptr;
 				}
-			}
-		}
-	}
 
+				processedCondition.notify_all();
 
-	ResourceTools::GetChunk chunkFile;
+				return Result{ ResultType::SUCCESS };
+			};
 
-	chunkFile.clearCache = true;
+			std::vector<GeneratedPatch> uncollectedPatches;
 
-	bundleStream.Flush();
+			Result result = CreateResourcePatches( workerParams, resourceGroupPrevious.m_resourcesParameter.At( resourceIndex ), resourceGroupNext.m_resourcesParameter.At( resourceIndex ), workerIndexFolder, workerStatusSettings, uncollectedPatches, collectPatch );
 
-	if( !( bundleStream >> chunkFile ) )
-	{
-		return Result( { ResultType::FAILED_TO_READ_FROM_STREAM } );
-	}
+			// Clean up anything generated but not collected due to an error
+			for( GeneratedPatch& patch : uncollectedPatches )
+			{
+				delete patch.patchResource;
+			}
 
-	std::stringstream ss;
-	ss << chunkBaseName << numberOfChunks << ".chunk";
-	std::string chunkName = ss.str();
+			{
+				std::lock_guard<std::mutex> lock( processedMutex );
 
-	std::filesystem::path chunkPath = params.chunkDestinationSettings.basePath / ss.str();
+				results[resourceIndex] = result;
 
-	Result processChunkResult = ProcessChunk( chunkFile, chunkPath, bundleResourceGroup, params.chunkDestinationSettings );
+				processed[resourceIndex] = true;
+			}
 
-	if( processChunkResult.type != ResultType::SUCCESS )
-	{
-		return processChunkResult;
-	}
+			processedCondition.notify_all();
+		}
+	};
 
-	// Export this resource list
-	//
-	// Update status
+	std::vector<std::thread> workers;
+
+	for( unsigned int i = 0; i < threadCount; i++ )
 	{
-		StatusSettings exportStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 80, 10, "Exporting ResourceGroups", &exportStatusSettings );
+		workers.emplace_back( worker, i );
+	}
 
-		std::string resourceGroupData;
+	Result result{ ResultType::SUCCESS };
 
-		Result exportToDataResult = ExportToData( resourceGroupData, exportStatusSettings );
+	int patchId = 0;
 
-		if( exportToDataResult.type != ResultType::SUCCESS )
+	for( size_t resourceIndex = 0; resourceIndex < resourceCount && result.type == ResultType::SUCCESS; resourceIndex++ )
+	{
+		// Update status
+		if( statusSettings.RequiresStatusUpdates() )
 		{
-			return exportToDataResult;
-		}
+			float step = static_cast<float>( 100.0 / resourceCount );
+			float percentageComplete = static_cast<float>( step * resourceIndex );
 
+			std::filesystem::path relativePath;
 
-		ResourceGroupInfo resourceGroupInfo( { params.resourceGroupRelativePath } );
+			Result getRelativePathResult = resourceGroupPrevious.m_resourcesParameter.At( resourceIndex )->GetRelativePath( relativePath );
+
+			if( getRelativePathResult.type != ResultType::SUCCESS )
+			{
+				result = getRelativePathResult;
 
-		Result setParametersFromDataResult = resourceGroupInfo.SetParametersFromData( resourceGroupData );
+				break;
+			}
 
-		if( setParametersFromDataResult.type != ResultType::SUCCESS )
-		{
-			return setParametersFromDataResult;
+			std::string message = "Creating patch for: " + relativePath.string();
+
+			statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentageComplete, step, message );
 		}
 
-		ResourcePutDataParams putDataParams;
+		bool resourceProcessed = false;
 
-		putDataParams.resourceDestinationSettings = params.chunkDestinationSettings;
+		while( !resourceProcessed )
+		{
+			std::vector<GeneratedPatch> patches;
 
-		putDataParams.data = &resourceGroupData;
+			{
+				std::unique_lock<std::mutex> lock( processedMutex );
 
-		Result subtractionResourcePutResult = resourceGroupInfo.PutData( putDataParams );
+				processedCondition.wait( lock, [&]() { return processed[resourceIndex] || !pendingPatches[resourceIndex].empty(); } );
 
-		if( subtractionResourcePutResult.type != ResultType::SUCCESS )
-		{
-			return subtractionResourcePutResult;
-		}
+				// Patches are collected before a resource is marked as processed, so none are left once it is
+				resourceProcessed = processed[resourceIndex];
 
-		// Export the bundleGroup
-		Result setResourceGroupResult = bundleResourceGroup.SetResourceGroup( resourceGroupInfo );
+				patches.swap( pendingPatches[resourceIndex] );
 
-		if( setResourceGroupResult.type != ResultType::SUCCESS )
-		{
-			return setResourceGroupResult;
-		}
-	}
+				for( const GeneratedPatch& patch : patches )
+				{
+					pendingPatchDataSize -= patch.data.size();
+				}
+			}
 
-    {
-		std::string patchResourceGroupData;
+			processedCondition.notify_all();
 
-		StatusSettings exportToDataStatusSettings;
-		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 90, 10, "Exporting ResourceGroups", &exportToDataStatusSettings );
+			// Committed patches are taken by the patch group, any left are cleaned up
+			for( GeneratedPatch& patch : patches )
+			{
+				if( result.type == ResultType::SUCCESS )
+				{
+					result = CommitPatch( params, patch, patchResourceGroup, patchId, storedPatchData );
+				}
 
-		Result exportBundleResourceGroupToDataResult = bundleResourceGroup.ExportToData( patchResourceGroupData, exportToDataStatusSettings );
+				delete patch.patchResource;
+			}
 
-		if( exportBundleResourceGroupToDataResult.type != ResultType::SUCCESS )
+			if( result.type != ResultType::SUCCESS )
+			{
+				break;
+			}
+		}
+
+		if( result.type == ResultType::SUCCESS && results[resourceIndex].type != ResultType::SUCCESS )
 		{
-			return exportBundleResourceGroupToDataResult;
+			result = results[resourceIndex];
 		}
 
-		BundleResourceGroupInfo patchResourceGroupInfo( { params.resourceGroupBundleRelativePath } );
+		if( result.type == ResultType::SUCCESS )
+		{
+			{
+				std::lock_guard<std::mutex> lock( processedMutex );
 
-		Result setPatchParametersFromDataResult = patchResourceGroupInfo.SetParametersFromData( patchResourceGroupData );
+				committingResource = resourceIndex + 1;
+			}
 
-		if( setPatchParametersFromDataResult.type != ResultType::SUCCESS )
-		{
-			return setPatchParametersFromDataResult;
+			processedCondition.notify_all();
 		}
+	}
 
-		ResourcePutDataParams bundlePutDataParams;
+	{
+		std::lock_guard<std::mutex> lock( processedMutex );
 
-		bundlePutDataParams.resourceDestinationSettings = params.resourceBundleResourceGroupDestinationSettings;
+		cancelled = true;
+	}
 
-		bundlePutDataParams.data = &patchResourceGroupData;
+	processedCondition.notify_all();
 
-		Result patchResourceGroupPutResult = patchResourceGroupInfo.PutData( bundlePutDataParams );
+	for( std::thread& workerThread : workers )
+	{
+		workerThread.join();
+	}
 
-		if( patchResourceGroupPutResult.type != ResultType::SUCCESS )
+	// Clean up anything generated but not committed due to an error
+	for( std::vector<GeneratedPatch>& resourcePatches : pendingPatches )
+	{
+		for( GeneratedPatch& patch : resourcePatches )
 		{
-			return patchResourceGroupPutResult;
+			delete patch.patchResource;
 		}
-    }
+	}
 
-	return Result{ ResultType::SUCCESS };
-}
+	std::error_code error;
 
-Result ResourceGroup::ResourceGroupImpl::ConstructPatchResourceInfo( const PatchCreateParams& params, int patchId, uintmax_t dataOffset, uint64_t patchSourceOffset, ResourceInfo* resourceNext, PatchResourceInfo*& patchResource ) const
-{
-	// Create a resource from patch data
-	std::filesystem::path resourceLatestRelativePath;
-	Result getResourceLatestRelativePathResult = resourceNext->GetRelativePath( resourceLatestRelativePath );
-	if( getResourceLatestRelativePathResult.type != ResultType::SUCCESS )
+	for( unsigned int i = 0; i < threadCount; i++ )
 	{
-		return getResourceLatestRelativePathResult;
+		std::filesystem::remove_all( params.indexFolder / ( "worker" + std::to_string( i ) ), error );
 	}
 
-	PatchResourceInfoParams patchResourceInfoParams;
-	std::string patchFilename = params.patchFileRelativePathPrefix.string() + "." + std::to_string( patchId );
-	patchResourceInfoParams.relativePath = patchFilename;
-	patchResourceInfoParams.targetResourceRelativePath = resourceLatestRelativePath;
-	patchResourceInfoParams.dataOffset = dataOffset;
-	patchResourceInfoParams.sourceOffset = patchSourceOffset;
-	patchResource = new PatchResourceInfo( patchResourceInfoParams );
-
-	return Result{ ResultType::SUCCESS };
+	return result;
 }
 
 Result ResourceGroup::ResourceGroupImpl::CreatePatch( const PatchCreateParams& params, StatusSettings& statusSettings ) const
@@ -1417,6 +2786,10 @@ Result ResourceGroup::ResourceGroupImpl::CreatePatch( const PatchCreateParams& p
 
 	PatchResourceGroup::PatchResourceGroupImpl patchResourceGroup;
 
+	patchResourceGroup.SetChecksumAlgorithm( m_checksumAlgorithm.GetValue() );
+
+	const VersionInternal outputDocumentVersion = GetDerivedGroupDocumentVersion();
+
 	Result setMaxInputChunkSizeResult = patchResourceGroup.SetMaxInputChunkSize( params.maxInputFileChunkSize );
 
 	if( setMaxInputChunkSizeResult.type != ResultType::SUCCESS )
@@ -1424,6 +2797,19 @@ Result ResourceGroup::ResourceGroupImpl::CreatePatch( const PatchCreateParams& p
 		return setMaxInputChunkSizeResult;
 	}
 
+	if( params.chunkingMode == PatchChunkingMode::CONTENT_DEFINED )
+	{
+		ResourceTools::ContentDefinedChunkSizes chunkSizes;
+		chunkSizes.minimum = params.contentDefinedChunkMinimumSize;
+		chunkSizes.average = params.contentDefinedChunkAverageSize;
+		chunkSizes.maximum = params.contentDefinedChunkMaximumSize;
+
+		if( !ResourceTools::IsValidContentDefinedChunkSizes( chunkSizes ) )
+		{
+			return Result{ ResultType::INVALID_CHUNK_SIZE };
+		}
+	}
+
 	// Created resource groups
 
 	std::shared_ptr<ResourceGroupImpl> resourceGroupSubtractionPrevious;
@@ -1474,303 +2860,86 @@ Result ResourceGroup::ResourceGroupImpl::CreatePatch( const PatchCreateParams& p
 
 	int patchId = 0;
 
+	StoredPatchData storedPatchData;
+
 	// Update status
     {
 		StatusSettings resourceStatusSettings;
 		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 40, 20, "Generating Patches", &resourceStatusSettings );
 
-		for( int i = 0; i < resourceGroupSubtractionNext->m_resourcesParameter.GetSize(); i++ )
-		{
-
-			ResourceInfo* resourcePrevious = resourceGroupSubtractionPrevious->m_resourcesParameter.At( i );
-
-			ResourceInfo* resourceNext = resourceGroupSubtractionNext->m_resourcesParameter.At( i );
-
-			if( resourceStatusSettings.RequiresStatusUpdates() )
-			{
-				float step = static_cast<float>( 100.0 / resourceGroupSubtractionNext->m_resourcesParameter.GetSize() );
-				float percentageComplete = static_cast<float>( step * i );
-
-				std::filesystem::path relativePath;
-
-				Result getRelativePathResult = resourcePrevious->GetRelativePath( relativePath );
-
-				if( getRelativePathResult.type != ResultType::SUCCESS )
-				{
-					return getRelativePathResult;
-				}
-
-				std::string message = "Creating patch for: " + relativePath.string();
-
-				resourceStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentageComplete, step, message );
-			}
-
-			size_t patchSourceOffset{ 0 };
-			uint64_t patchSourceOffsetDelta{ 0 };
-
-			// Check to see if previous entry contains dummy information
-			// Suggesting that this is a new entry in latest
-			// In which case there is no reason to create a patch
-			// The new entry will be stored with the ResourceGroup related to the PatchResourceGroup
-			uintmax_t previousUncompressedSize;
-
-			Result getResourcePreviousCompressedSizeResult = resourcePrevious->GetUncompressedSize( previousUncompressedSize );
-
-			if( getResourcePreviousCompressedSizeResult.type != ResultType::SUCCESS )
-			{
-				return getResourcePreviousCompressedSizeResult;
-			}
-
+		unsigned int threadCount = params.threadCount;
 
+		if( threadCount == 0 )
+		{
+			threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+		}
 
-			uintmax_t nextUncompressedSize;
+		threadCount = static_cast<unsigned int>( std::min<size_t>( threadCount, resourceGroupSubtractionNext->m_resourcesParameter.GetSize() ) );
 
-			Result getResourceNextCompressedSizeResult = resourceNext->GetUncompressedSize( nextUncompressedSize );
+		if( threadCount > 1 )
+		{
+			Result createPatchesResult = CreatePatchesParallel( params, *resourceGroupSubtractionPrevious, *resourceGroupSubtractionNext, threadCount, patchResourceGroup, storedPatchData, resourceStatusSettings );
 
-			if( getResourceNextCompressedSizeResult.type != ResultType::SUCCESS )
+			if( createPatchesResult.type != ResultType::SUCCESS )
 			{
-				return getResourceNextCompressedSizeResult;
+				return createPatchesResult;
 			}
-
-
-			// If previous size is 0 this suggests that this is a new entry in latest
-			// In which case there is no reason to create a patch
-			if( previousUncompressedSize != 0 )
+		}
+		else
+		{
+			for( int i = 0; i < resourceGroupSubtractionNext->m_resourcesParameter.GetSize(); i++ )
 			{
-				// Get resource data previous
-				auto previousFileDataStream = std::make_shared<ResourceTools::FileDataStreamIn>( params.maxInputFileChunkSize );
-
-				ResourceGetDataStreamParams previousResourceGetDataStreamParams;
-
-				previousResourceGetDataStreamParams.resourceSourceSettings = params.resourceSourceSettingsPrevious;
 
-				previousResourceGetDataStreamParams.downloadRetrySeconds = params.downloadRetrySeconds;
+				ResourceInfo* resourcePrevious = resourceGroupSubtractionPrevious->m_resourcesParameter.At( i );
 
-				previousResourceGetDataStreamParams.dataStream = previousFileDataStream;
+				ResourceInfo* resourceNext = resourceGroupSubtractionNext->m_resourcesParameter.At( i );
 
-				Result getPreviousDataStreamResult = resourcePrevious->GetDataStream( previousResourceGetDataStreamParams );
-
-				if( getPreviousDataStreamResult.type != ResultType::SUCCESS )
+				if( resourceStatusSettings.RequiresStatusUpdates() )
 				{
-					return getPreviousDataStreamResult;
-				}
+					float step = static_cast<float>( 100.0 / resourceGroupSubtractionNext->m_resourcesParameter.GetSize() );
+					float percentageComplete = static_cast<float>( step * i );
 
-				// Get resource data next
-				auto nextFileDataStream = std::make_shared<ResourceTools::FileDataStreamIn>( params.maxInputFileChunkSize );
+					std::filesystem::path relativePath;
 
-				ResourceGetDataStreamParams nextResourceGetDataStreamParams;
+					Result getRelativePathResult = resourcePrevious->GetRelativePath( relativePath );
 
-				nextResourceGetDataStreamParams.resourceSourceSettings = params.resourceSourceSettingsNext;
-
-				nextResourceGetDataStreamParams.dataStream = nextFileDataStream;
+					if( getRelativePathResult.type != ResultType::SUCCESS )
+					{
+						return getRelativePathResult;
+					}
 
-				Result getNextDataStreamResult = resourceNext->GetDataStream( nextResourceGetDataStreamParams );
+					std::string message = "Creating patch for: " + relativePath.string();
 
-				if( getNextDataStreamResult.type != ResultType::SUCCESS )
-				{
-					return getNextDataStreamResult;
+					resourceStatusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, percentageComplete, step, message );
 				}
 
-				std::filesystem::path relativePath;
-				Result getRelativePathResult = resourcePrevious->GetRelativePath( relativePath );
-				if( getRelativePathResult.type != ResultType::SUCCESS )
-				{
-					return getRelativePathResult;
-				}
+				// Patches are committed as soon as they are complete so patch data is not held for the whole resource
+				auto commitPatch = [&]( GeneratedPatch& patch ) {
+					return CommitPatch( params, patch, patchResourceGroup, patchId, storedPatchData );
+				};
 
-				ResourceTools::ChunkIndex index( previousFileDataStream->GetPath(), params.maxInputFileChunkSize, params.indexFolder );
+				std::vector<GeneratedPatch> patches;
 
-				index.GenerateChecksumFilter( nextFileDataStream->GetPath() );
+				Result createResourcePatchesResult = CreateResourcePatches( params, resourcePrevious, resourceNext, params.indexFolder, resourceStatusSettings, patches, commitPatch );
 
-				if( !index.Generate() )
+				// Clean up anything generated but not committed due to an error
+				for( GeneratedPatch& patch : patches )
 				{
-					std::string message = "Index generation failed for " + relativePath.string();
-					resourceStatusSettings.Update( StatusProgressType::WARNING, 0, 0, message );
+					delete patch.patchResource;
 				}
 
-				// Process one chunk at a time
-				for( uintmax_t dataOffset = 0; dataOffset < nextUncompressedSize; dataOffset += params.maxInputFileChunkSize )
+				if( createResourcePatchesResult.type != ResultType::SUCCESS )
 				{
-					std::string previousFileData = "";
-
-					if( previousFileDataStream->IsFinished() )
-					{
-						if( previousFileDataStream->Size() > nextFileDataStream->GetCurrentPosition() )
-						{
-							// We ran out of data because we found a chunk match later in the file,
-							// but we can rewind back to where the read stream is in hopes
-							// of getting a good diff, rather than just treating it as new data.
-							previousFileDataStream->StartRead( previousFileDataStream->GetPath() );
-						}
-					}
-
-					// Handling if previous file is smaller than next file
-					// If so then previousFileData will be nothing and
-					// All next data will be used for the patch
-					if( !previousFileDataStream->IsFinished() )
-					{
-						if( !( *previousFileDataStream >> previousFileData ) )
-						{
-							return Result{ ResultType::FAILED_TO_RETRIEVE_CHUNK_DATA };
-						}
-					}
-
-					size_t nextStreamPosition = nextFileDataStream->GetCurrentPosition();
-					// Note: in the case that the next file is smaller than previous
-					// nothing is stored, application of the patch will chop off the extra file data
-					std::string nextFileData;
-
-					if( !nextFileDataStream->IsFinished() )
-					{
-						if( !( *nextFileDataStream >> nextFileData ) )
-						{
-							return Result{ ResultType::FAILED_TO_RETRIEVE_CHUNK_DATA };
-						}
-					}
-
-					// Create a patch
-					// Create a patch from the data
-					std::string patchData;
-
-					bool chunkMatchFound{ false };
-					size_t matchCount{ 0 };
-
-
-					if( previousFileData != "" )
-					{
-						// Here's how this should work:
-						// We find a matching chunk if it exists. If the chunk exists we make a patch with no data, because we'll get
-						// the data from the source file using the patch info. Consecutive patches should be collapsed into one big one.
-						// If we can't find a matching chunk, we will base the current diff off the chunk in the source starting after the final byte
-						// in the chunk from the source file that we last used.
-						// These should keep our patches pretty minimal, even if lots of data gets added early in the file causing offsets.
-						// It should also handle small changes in moved parts of the file pretty well.
-						chunkMatchFound = index.FindMatchingChunk( nextFileData, patchSourceOffset );
-
-						if( chunkMatchFound )
-						{
-							matchCount = 1;
-							matchCount += ResourceTools::CountMatchingChunks(
-								nextFileDataStream->GetPath(),
-								nextFileDataStream->GetCurrentPosition(),
-								previousFileDataStream->GetPath(),
-								patchSourceOffset + params.maxInputFileChunkSize,
-								params.maxInputFileChunkSize );
-
-							size_t matchSize = std::min( params.maxInputFileChunkSize * matchCount, previousFileDataStream->Size() - patchSourceOffset );
-
-							PatchResourceInfo* patchResource{ nullptr };
-
-							ConstructPatchResourceInfo( params, patchId, dataOffset, patchSourceOffset, resourceNext, patchResource );
-
-							if( previousFileDataStream->IsFinished() )
-							{
-								previousFileDataStream->StartRead( previousFileDataStream->GetPath() );
-							}
-
-							previousFileDataStream->Seek( patchSourceOffset );
-
-							patchResource->SetParametersFromSourceStream( *previousFileDataStream, matchSize );
-
-							// Advance the first stream by the size of the matching data,
-							// but move the point we generate patches from for the previous
-							// file data stream to the end of the match.
-							// It's hard to tell if it would be smarter to simply advance
-							// the destination data by the same amount of the source data,
-							// or perhaps even not to move it at all.
-							nextFileDataStream->Seek( std::min( nextFileDataStream->Size(), nextStreamPosition + matchSize ) );
-
-							previousFileDataStream->Seek( std::min( previousFileDataStream->Size(), patchSourceOffset + matchSize ) );
-
-							dataOffset += matchSize - params.maxInputFileChunkSize;
-
-							patchSourceOffset += matchSize;
-
-							if( nextStreamPosition == 0 && patchSourceOffset == 0 )
-							{
-								// This is the beginning of the file and it matches.
-								// There is no need to write patch data.
-								continue;
-							}
-
-							// Add the patch resource to the patchResourceGroup
-							Result addResourceResult = patchResourceGroup.AddResource( patchResource );
-
-							if( addResourceResult.type != ResultType::SUCCESS )
-							{
-								delete patchResource;
-
-								return addResourceResult;
-							}
-
-							patchId++;
-
-							continue;
-						}
-						else
-						{
-							// Previous and next data chunk are different, create a patch
-							if( !ResourceTools::CreatePatch( previousFileData, nextFileData, patchData ) )
-							{
-								return Result{ ResultType::FAILED_TO_CREATE_PATCH };
-							}
-							patchSourceOffsetDelta = previousFileData.size();
-						}
-					}
-					else
-					{
-						// If there is no previous data then just store the data straight from the file
-						// All this data is new
-						if( !ResourceTools::CreatePatch( "", nextFileData, patchData ) )
-						{
-							return Result{ ResultType::FAILED_TO_CREATE_PATCH };
-						}
-						patchSourceOffsetDelta = nextFileData.size();
-					}
-
-					PatchResourceInfo* patchResource{ nullptr };
-					ConstructPatchResourceInfo( params, patchId, dataOffset, patchSourceOffset, resourceNext, patchResource );
-					patchSourceOffset += patchSourceOffsetDelta;
-					if( !patchData.empty() )
-					{
-						Result setParametersFromDataResult = patchResource->SetParametersFromData( patchData, params.calculateCompressions );
-
-						if( setParametersFromDataResult.type != ResultType::SUCCESS )
-						{
-							return setParametersFromDataResult;
-						}
-
-						// Export patch file
-						ResourcePutDataParams resourcePutDataParams;
-
-						resourcePutDataParams.resourceDestinationSettings = params.resourcePatchBinaryDestinationSettings;
-
-						resourcePutDataParams.data = &patchData;
-
-						Result putPatchDataResult = patchResource->PutData( resourcePutDataParams );
-
-						if( putPatchDataResult.type != ResultType::SUCCESS )
-						{
-							delete patchResource;
-
-							return putPatchDataResult;
-						}
-					}
-
-					// Add the patch resource to the patchResourceGroup
-					Result addResourceResult = patchResourceGroup.AddResource( patchResource );
-
-					if( addResourceResult.type != ResultType::SUCCESS )
-					{
-						delete patchResource;
-
-						return addResourceResult;
-					}
-
-					patchId++;
+					return createResourcePatchesResult;
 				}
 			}
 		}
+
+		if( storedPatchData.sharedPatchCount > 0 )
+		{
+			std::string message = "Shared stored data between " + std::to_string( storedPatchData.sharedPatchCount ) + " patches identical to an earlier patch, saving " + std::to_string( storedPatchData.sharedPatchSize ) + " bytes";
+			resourceStatusSettings.Update( StatusProgressType::UNBOUNDED, 0, 0, message );
+		}
     }
 	
 
@@ -1785,7 +2954,7 @@ Result ResourceGroup::ResourceGroupImpl::CreatePatch( const PatchCreateParams& p
 		std::string resourceGroupData;
 
 
-		Result exportResourceGroupSubtractionLatestResult = resourceGroupSubtractionNext->ExportToData( resourceGroupData, exportToDataStatusSettings );
+		Result exportResourceGroupSubtractionLatestResult = resourceGroupSubtractionNext->ExportToData( resourceGroupData, exportToDataStatusSettings, outputDocumentVersion );
 
 		if( exportResourceGroupSubtractionLatestResult.type != ResultType::SUCCESS )
 		{
@@ -1794,7 +2963,7 @@ Result ResourceGroup::ResourceGroupImpl::CreatePatch( const PatchCreateParams& p
 
 		ResourceGroupInfo subtractionResourceGroupInfo( { params.resourceGroupRelativePath } );
 
-		Result setParametersFromDataResult = subtractionResourceGroupInfo.SetParametersFromData( resourceGroupData );
+		Result setParametersFromDataResult = subtractionResourceGroupInfo.SetParametersFromData( resourceGroupData, m_checksumAlgorithm.GetValue() );
 
 		if( setParametersFromDataResult.type != ResultType::SUCCESS )
 		{
@@ -1829,7 +2998,7 @@ Result ResourceGroup::ResourceGroupImpl::CreatePatch( const PatchCreateParams& p
 		statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 80, 20, "Export ResourceGroups.", &exportPatchResourceGroupStatusSettings );
 
 
-		Result exportToDataResult = patchResourceGroup.ExportToData( patchResourceGroupData, exportPatchResourceGroupStatusSettings );
+		Result exportToDataResult = patchResourceGroup.ExportToData( patchResourceGroupData, exportPatchResourceGroupStatusSettings, outputDocumentVersion );
 
 		if( exportToDataResult.type != ResultType::SUCCESS )
 		{
@@ -1838,7 +3007,7 @@ Result ResourceGroup::ResourceGroupImpl::CreatePatch( const PatchCreateParams& p
 
 		PatchResourceGroupInfo patchResourceGroupInfo( { params.resourceGroupPatchRelativePath } );
 
-		Result setPatchParametersFromDataResult = patchResourceGroupInfo.SetParametersFromData( patchResourceGroupData );
+		Result setPatchParametersFromDataResult = patchResourceGroupInfo.SetParametersFromData( patchResourceGroupData, m_checksumAlgorithm.GetValue() );
 
 		if( setPatchParametersFromDataResult.type != ResultType::SUCCESS )
 		{
@@ -2004,6 +3173,13 @@ Result ResourceGroup::ResourceGroupImpl::Merge( const ResourceGroupMergeParams&
 		return Result{ ResultType::RESOURCE_GROUP_NOT_SET };
 	}
 
+	if( params.resourceGroupToMerge->m_impl->GetChecksumAlgorithm() != GetChecksumAlgorithm() )
+	{
+		return Result{ ResultType::CHECKSUM_ALGORITHM_MISMATCH };
+	}
+
+	params.mergedResourceGroup->m_impl->SetChecksumAlgorithm( GetChecksumAlgorithm() );
+
 	DocumentParameterCollection<ResourceInfo*> mergeResources = params.resourceGroupToMerge->m_impl->m_resourcesParameter;
 
 	std::vector<ResourceInfo*> sortedResourcesParameter( m_resourcesParameter.begin(), m_resourcesParameter.end() );
@@ -2150,6 +3326,16 @@ Result ResourceGroup::ResourceGroupImpl::Diff( ResourceGroupSubtractionParams& p
 {
 	statusSettings.Update( CarbonResources::StatusProgressType::PERCENTAGE, 0, 20, "Calculating diff between two resource groups." );
 
+	// Checksums are only comparable if generated with the same algorithm
+	if( params.subtractResourceGroup->GetChecksumAlgorithm() != GetChecksumAlgorithm() )
+	{
+		return Result{ ResultType::CHECKSUM_ALGORITHM_MISMATCH };
+	}
+
+	params.result1->SetChecksumAlgorithm( GetChecksumAlgorithm() );
+
+	params.result2->SetChecksumAlgorithm( GetChecksumAlgorithm() );
+
 	DocumentParameterCollection<ResourceInfo*> subtractionResources = params.subtractResourceGroup->m_resourcesParameter;
 	// Iterate through all resources
 
@@ -2212,7 +3398,7 @@ Result ResourceGroup::ResourceGroupImpl::Diff( ResourceGroupSubtractionParams& p
 			ResourceInfo* resource2 = *std::lower_bound(
 				sortedSubtractionResources.begin(), sortedSubtractionResources.end(), resource, []( const ResourceInfo* a, const ResourceInfo* b ) { return *a < *b; } );
 
-			std::string resource1Checksum;
+			ResourceTools::Digest128 resource1Checksum;
 
 			Result getResource1ChecksumResult = resource->GetChecksum( resource1Checksum );
 
@@ -2221,7 +3407,7 @@ Result ResourceGroup::ResourceGroupImpl::Diff( ResourceGroupSubtractionParams& p
 				return getResource1ChecksumResult;
 			}
 
-			std::string resource2Checksum;
+			ResourceTools::Digest128 resource2Checksum;
 
 			Result getResource2ChecksumResult = resource2->GetChecksum( resource2Checksum );
 
@@ -2385,6 +3571,27 @@ size_t ResourceGroup::ResourceGroupImpl::GetSize() const
 	return m_resourcesParameter.GetSize();
 }
 
+ChecksumAlgorithm ResourceGroup::ResourceGroupImpl::GetChecksumAlgorithm() const
+{
+	return m_checksumAlgorithm.GetValue();
+}
+
+void ResourceGroup::ResourceGroupImpl::SetChecksumAlgorithm( ChecksumAlgorithm checksumAlgorithm )
+{
+	m_checksumAlgorithm = checksumAlgorithm;
+}
+
+VersionInternal ResourceGroup::ResourceGroupImpl::GetDerivedGroupDocumentVersion() const
+{
+	// Default document version unless it is unable to record the checksum algorithm
+	if( m_checksumAlgorithm.GetValue() != ChecksumAlgorithm::MD5 )
+	{
+		return VersionInternal( S_CHECKSUM_ALGORITHM_DOCUMENT_VERSION );
+	}
+
+	return VersionInternal( S_DOCUMENT_VERSION );
+}
+
 Result ResourceGroup::ResourceGroupImpl::GetGroupSpecificResourcesToBundle( std::vector<ResourceInfo*>& toBundle ) const
 {
 	return Result{ ResultType::SUCCESS };
@@ -8,14 +8,23 @@
 #include "ResourceGroup.h"
 #include "ResourceInfo/ResourceInfo.h"
 #include <vector>
+#include <functional>
+#include <unordered_map>
 
 #include "VersionInternal.h"
 #include "ResourceInfo/PatchResourceInfo.h"
 
 #include "BundleResourceGroup.h"
+#include "PatchResourceGroup.h"
 
 #include "StatusSettings.h"
 
+namespace ResourceTools
+{
+class FileDataStreamIn;
+class PatchPipeline;
+}
+
 namespace YAML
 {
 class Emitter;
@@ -25,6 +34,8 @@ class Node;
 namespace CarbonResources
 {
 
+class FileFingerprintCache;
+
 struct ResourceGroupSubtractionParams
 {
 	ResourceGroup::ResourceGroupImpl* subtractResourceGroup = nullptr;
@@ -37,6 +48,45 @@ struct ResourceGroupSubtractionParams
 
 };
 
+// State shared by files processed in ResourceGroupImpl::CreateFromDirectory
+struct DirectoryProcessingContext
+{
+	FileFingerprintCache* fingerprintCache = nullptr;
+
+	std::unordered_map<std::string, const ResourceInfo*> previousResources;
+};
+
+// Patch generated for a resource in ResourceGroupImpl::CreatePatch
+// Patch ids are assigned and data saved when patches are committed to the PatchResourceGroup in resource order
+struct GeneratedPatch
+{
+	static constexpr size_t NOT_QUEUED = SIZE_MAX;
+
+	PatchResourceInfo* patchResource = nullptr;
+
+	// Empty for patches that reference data in the previous resource
+	std::string data;
+
+	// Index in the PatchPipeline creating the patch data, data is empty until it is collected
+	size_t queuedIndex = NOT_QUEUED;
+};
+
+// Receives the patches of a resource in order as soon as each is complete
+// Setting patchResource to nullptr takes ownership, patches left with a patchResource are deleted by the creator
+using GeneratedPatchCallback = std::function<Result( GeneratedPatch& patch )>;
+
+// Patch data stored so far while creating a patch, patches with identical data share the stored copy
+struct StoredPatchData
+{
+	// Location of stored patch data keyed on its checksum and size
+	std::unordered_map<std::string, std::string> locations;
+
+	// Patches which share data stored for an earlier patch, and the size of data not stored again as a result
+	size_t sharedPatchCount = 0;
+
+	uintmax_t sharedPatchSize = 0;
+};
+
 enum class DocumentType
 {
 	CSV,
@@ -64,6 +114,8 @@ public:
 
 	Result ConstructPatchResourceInfo( const PatchCreateParams& params, int patchId, uintmax_t dataOffset, uint64_t patchSourceOffset, ResourceInfo* resourceNext, PatchResourceInfo*& patchResource ) const;
 
+	Result CreateContentDefinedPatches( const PatchCreateParams& params, ResourceInfo* resourceNext, ResourceTools::FileDataStreamIn& previousFileDataStream, ResourceTools::FileDataStreamIn& nextFileDataStream, std::vector<GeneratedPatch>& patches, const GeneratedPatchCallback& patchGenerated ) const;
+
 	Result CreatePatch( const PatchCreateParams& params, StatusSettings& statusSettings ) const;
 
 	Result AddResource( ResourceInfo* resource );
@@ -94,6 +146,10 @@ public:
 
 	size_t GetSize() const;
 
+	ChecksumAlgorithm GetChecksumAlgorithm() const;
+
+	void SetChecksumAlgorithm( ChecksumAlgorithm checksumAlgorithm );
+
 	Result ImportFromYamlString( const std::string& data, StatusSettings& statusSettings );
 
 	Result ImportFromYaml( YAML::Node& data, StatusSettings& statusSettings );
@@ -121,6 +177,33 @@ private:
 
 	Result RemoveResource( ResourceInfo& relativePath );
 
+	// Document version used to export groups derived from this one, such as bundles and patches
+	VersionInternal GetDerivedGroupDocumentVersion() const;
+
+	Result CreateResourceFromFile( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, DirectoryProcessingContext& context, StatusSettings& statusSettings, ResourceInfo*& resourceOut ) const;
+
+	Result CreateResourceFromPreviousResourceGroup( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, const std::filesystem::path& relativePath, const DirectoryProcessingContext& context, ResourceInfo*& resourceOut ) const;
+
+	Result CreateResourceFromKnownParameters( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, uintmax_t uncompressedSize, const ResourceTools::Digest128& checksum, uintmax_t compressedSize, const std::string& location, ResourceInfo*& resourceOut ) const;
+
+	Result CreateResourceFromFileData( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, StatusSettings& statusSettings, ResourceInfo*& resourceOut ) const;
+
+	Result ExportResourceFromFile( const CreateResourceGroupFromDirectoryParams& params, const std::filesystem::directory_entry& entry, const ResourceInfo& resource ) const;
+
+	Result CreateResourcesFromFilesParallel( const CreateResourceGroupFromDirectoryParams& params, const std::vector<std::filesystem::directory_entry>& entries, DirectoryProcessingContext& context, unsigned int threadCount, StatusSettings& statusSettings );
+
+	std::filesystem::path GetPatchRelativePath( const PatchCreateParams& params, int patchId ) const;
+
+	Result CreateResourcePatches( const PatchCreateParams& params, ResourceInfo* resourcePrevious, ResourceInfo* resourceNext, const std::filesystem::path& indexFolder, StatusSettings& statusSettings, std::vector<GeneratedPatch>& patches, const GeneratedPatchCallback& patchGenerated ) const;
+
+	Result QueuePatch( const PatchCreateParams& params, std::string previousData, std::string nextData, PatchResourceInfo* patchResource, ResourceTools::PatchPipeline& pipeline, std::vector<GeneratedPatch>& patches ) const;
+
+	Result ReleaseGeneratedPatches( ResourceTools::PatchPipeline& pipeline, std::vector<GeneratedPatch>& patches, bool waitForPipeline, const GeneratedPatchCallback& patchGenerated ) const;
+
+	Result CommitPatch( const PatchCreateParams& params, GeneratedPatch& patch, PatchResourceGroup::PatchResourceGroupImpl& patchResourceGroup, int& patchId, StoredPatchData& storedPatchData ) const;
+
+	Result CreatePatchesParallel( const PatchCreateParams& params, ResourceGroupImpl& resourceGroupPrevious, ResourceGroupImpl& resourceGroupNext, unsigned int threadCount, PatchResourceGroup::PatchResourceGroupImpl& patchResourceGroup, StoredPatchData& storedPatchData, StatusSettings& statusSettings ) const;
+
 protected:
 	// Document Parameters
 	DocumentParameter<VersionInternal> m_versionParameter = DocumentParameter<VersionInternal>( VERSION, TypeId() );
@@ -133,6 +216,8 @@ protected:
 
 	DocumentParameter<uintmax_t> m_totalResourcesSizeUncompressed = DocumentParameter<uintmax_t>( TOTAL_RESOURCE_SIZE_UNCOMPRESSED, TypeId() );
 
+	DocumentParameter<ChecksumAlgorithm> m_checksumAlgorithm = DocumentParameter<ChecksumAlgorithm>( CHECKSUM_ALGORITHM, TypeId() );
+
 	DocumentParameterCollection<ResourceInfo*> m_resourcesParameter = DocumentParameterCollection<ResourceInfo*>( RESOURCE, TypeId() );
 };
 
@@ -2,7 +2,7 @@
 
 #include "ResourceInfo.h"
 
-#include "Md5ChecksumStream.h"
+#include "ChecksumStream.h"
 
 #include <sstream>
 
@@ -21,6 +21,20 @@
 namespace CarbonResources
 {
 
+ResourceTools::ChecksumAlgorithm GetResourceToolsChecksumAlgorithm( ChecksumAlgorithm checksumAlgorithm )
+{
+	switch( checksumAlgorithm )
+	{
+	case ChecksumAlgorithm::BLAKE2B_128:
+		return ResourceTools::ChecksumAlgorithm::BLAKE2B_128;
+	case ChecksumAlgorithm::XXH3_128:
+		return ResourceTools::ChecksumAlgorithm::XXH3_128;
+	case ChecksumAlgorithm::MD5:
+	default:
+		return ResourceTools::ChecksumAlgorithm::MD5;
+	}
+}
+
 std::string Location::CalculateLocationFromChecksums( const std::string& relativePathChecksum, const std::string& dataChecksum ) const
 {
 	std::stringstream ss;
@@ -47,6 +61,11 @@ Result Location::SetFromRelativePathAndDataChecksum( const std::filesystem::path
 	return Result{ ResultType::SUCCESS };
 }
 
+Result Location::SetFromRelativePathAndDataChecksum( const std::filesystem::path& relativePath, const ResourceTools::Digest128& dataChecksum )
+{
+	return SetFromRelativePathAndDataChecksum( relativePath, dataChecksum.ToHexString() );
+}
+
 
 ResourceInfo::ResourceInfo( const ResourceInfoParams& params )
 {
@@ -56,7 +75,10 @@ ResourceInfo::ResourceInfo( const ResourceInfoParams& params )
 
 	m_type = TypeId();
 
-	m_checksum = params.checksum;
+	if( params.checksum.has_value() )
+	{
+		m_checksum = params.checksum.value();
+	}
 
     if (params.compressedSize > 0)
 	{
@@ -117,6 +139,11 @@ void ResourceInfo::SetRelativePath( const std::filesystem::path& relativePath )
 	m_relativePath = relativePath;
 }
 
+void ResourceInfo::SetLocation( const std::string& location )
+{
+	m_location = location;
+}
+
 Result ResourceInfo::GetLocation( std::string& location ) const
 {
 	if( !m_location.HasValue() )
@@ -160,6 +187,20 @@ Result ResourceInfo::GetPrefix( std::string& prefix ) const
 }
 
 Result ResourceInfo::GetChecksum( std::string& checksum ) const
+{
+	if( !m_checksum.HasValue() )
+	{
+		return Result{ ResultType::RESOURCE_VALUE_NOT_SET };
+	}
+	else
+	{
+		checksum = m_checksum.GetValue().ToHexString();
+
+		return Result{ ResultType::SUCCESS };
+	}
+}
+
+Result ResourceInfo::GetChecksum( ResourceTools::Digest128& checksum ) const
 {
 	if( !m_checksum.HasValue() )
 	{
@@ -263,6 +304,27 @@ Result ResourceInfo::PutData( ResourcePutDataParams& params ) const
 	}
 }
 
+Result ResourceInfo::GetLocalDestinationPath( const ResourceDestinationSettings& resourceDestinationSettings, std::filesystem::path& path ) const
+{
+	switch( resourceDestinationSettings.destinationType )
+	{
+	case ResourceDestinationType::LOCAL_RELATIVE:
+
+		path = resourceDestinationSettings.basePath / m_relativePath.GetValue();
+
+		return Result{ ResultType::SUCCESS };
+
+	case ResourceDestinationType::LOCAL_CDN:
+
+		path = resourceDestinationSettings.basePath / m_location.GetValue().ToString();
+
+		return Result{ ResultType::SUCCESS };
+
+	default:
+		return Result{ ResultType::FAILED_TO_SAVE_FILE };
+	}
+}
+
 Result ResourceInfo::PutDataLocalRelative( ResourcePutDataParams& params ) const
 {
 	std::string& data = *params.data;
@@ -576,7 +638,7 @@ Result ResourceInfo::GetDataRemoteCdn( ResourceGetDataParams& params, const int
 
 	if( std::filesystem::exists( tempPath ) )
 	{
-		if( ResourceTools::Md5ChecksumMatches( tempPath, params.expectedChecksum ) )
+		if( params.expectedChecksum.has_value() && ResourceTools::ChecksumMatches( tempPath, GetResourceToolsChecksumAlgorithm( params.checksumAlgorithm ), params.expectedChecksum.value() ) )
 		{
 			haveFileCached = true;
 		}
@@ -601,7 +663,7 @@ Result ResourceInfo::GetDataRemoteCdn( ResourceGetDataParams& params, const int
 			return Result{ ResultType::FAILED_TO_DOWNLOAD_FILE, ss.str() };
 		}
 
-		if( !params.expectedChecksum.empty() && !ResourceTools::Md5ChecksumMatches( tempPath, params.expectedChecksum ) )
+		if( params.expectedChecksum.has_value() && !ResourceTools::ChecksumMatches( tempPath, GetResourceToolsChecksumAlgorithm( params.checksumAlgorithm ), params.expectedChecksum.value() ) )
 		{
 			return Result{ ResultType::FAILED_TO_DOWNLOAD_FILE, "The downloaded file does not have the expected checksum" };
 		}
@@ -688,7 +750,7 @@ Result ResourceInfo::GetDataStreamRemoteCdn( ResourceGetDataStreamParams& params
 
 	if( std::filesystem::exists( tempPath ) )
 	{
-		if( ResourceTools::Md5ChecksumMatches( tempPath, params.expectedChecksum ) )
+		if( params.expectedChecksum.has_value() && ResourceTools::ChecksumMatches( tempPath, GetResourceToolsChecksumAlgorithm( params.checksumAlgorithm ), params.expectedChecksum.value() ) )
 		{
 			haveFileCached = true;
 		}
@@ -713,7 +775,7 @@ Result ResourceInfo::GetDataStreamRemoteCdn( ResourceGetDataStreamParams& params
 			return Result{ ResultType::FAILED_TO_DOWNLOAD_FILE, ss.str() };
 		}
 
-		if( !params.expectedChecksum.empty() && !ResourceTools::Md5ChecksumMatches( tempPath, params.expectedChecksum ) )
+		if( params.expectedChecksum.has_value() && !ResourceTools::ChecksumMatches( tempPath, GetResourceToolsChecksumAlgorithm( params.checksumAlgorithm ), params.expectedChecksum.value() ) )
 		{
 			return Result{ ResultType::FAILED_TO_DOWNLOAD_FILE, "The downloaded file does not have the expected checksum" };
 		}
@@ -784,7 +846,14 @@ Result ResourceInfo::ImportFromYaml( YAML::Node& resource, const VersionInternal
 	{
 		if( YAML::Node parameter = resource[m_checksum.GetTag()] )
 		{
-			m_checksum = parameter.as<std::string>();
+			ResourceTools::Digest128 checksum;
+
+			if( !checksum.FromHexString( parameter.as<std::string>() ) )
+			{
+				return Result{ ResultType::MALFORMED_RESOURCE_INPUT };
+			}
+
+			m_checksum = checksum;
 		}
 		else
 		{
@@ -871,7 +940,7 @@ Result ResourceInfo::SetParametersFromResource( const ResourceInfo* other, const
 
 	if( m_checksum.IsParameterExpectedInDocumentVersion( documentVersion ) )
 	{
-		std::string checksum;
+		ResourceTools::Digest128 checksum;
 
 		Result getChecksumResult = other->GetChecksum( checksum );
 
@@ -1017,11 +1086,11 @@ Result ResourceInfo::UpdateLocation()
 	return Result( { ResultType::SUCCESS } );
 }
 
-Result ResourceInfo::SetParametersFromData( const std::string& data, bool calculateCompression /* = true */ )
+Result ResourceInfo::SetParametersFromData( const std::string& data, ChecksumAlgorithm checksumAlgorithm, bool calculateCompression /* = true */ )
 {
-	std::string checksum;
+	ResourceTools::Digest128 checksum;
 
-	if( !ResourceTools::GenerateMd5Checksum( data, checksum ) )
+	if( !ResourceTools::GenerateChecksum( data, GetResourceToolsChecksumAlgorithm( checksumAlgorithm ), checksum ) )
 	{
 		return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
 	}
@@ -1058,22 +1127,22 @@ Result ResourceInfo::SetParametersFromData( const std::string& data, bool calcul
 	return Result{ ResultType::SUCCESS };
 }
 
-Result ResourceInfo::SetParametersFromSourceStream( ResourceTools::FileDataStreamIn& stream, size_t matchSize )
+Result ResourceInfo::SetParametersFromSourceStream( ResourceTools::FileDataStreamIn& stream, size_t matchSize, ChecksumAlgorithm checksumAlgorithm )
 {
 	std::string chunk;
-	std::string checksum;
+	ResourceTools::Digest128 checksum;
 
 	m_uncompressedSize = matchSize;
 
 	auto start = stream.GetCurrentPosition();
 
-	ResourceTools::Md5ChecksumStream md5ChecksumStream;
+	ResourceTools::ChecksumStream checksumStream( GetResourceToolsChecksumAlgorithm( checksumAlgorithm ) );
 	while( matchSize )
 	{
 
 		stream >> chunk;
 		size_t chunkSize = chunk.size() > matchSize ? matchSize : chunk.size();
-		md5ChecksumStream << chunk.substr( chunkSize );
+		checksumStream << std::string_view( chunk ).substr( chunkSize );
 		matchSize -= chunkSize;
 		if( !chunkSize )
 		{
@@ -1081,7 +1150,7 @@ Result ResourceInfo::SetParametersFromSourceStream( ResourceTools::FileDataStrea
 		}
 	}
 
-	if( !md5ChecksumStream.FinishAndRetrieve( checksum ) )
+	if( !checksumStream.FinishAndRetrieve( checksum ) )
 	{
 		stream.Seek( start );
 		return Result{ ResultType::FAILED_TO_GENERATE_CHECKSUM };
@@ -1151,7 +1220,7 @@ Result ResourceInfo::ExportToYaml( YAML::Emitter& out, const VersionInternal& do
 		}
 
 		out << YAML::Key << m_checksum.GetTag();
-		out << YAML::Value << m_checksum.GetValue();
+		out << YAML::Value << m_checksum.GetValue().ToHexString();
 	}
 
 	//Uncompressed Size
@@ -1200,7 +1269,7 @@ Result ResourceInfo::ExportToYaml( YAML::Emitter& out, const VersionInternal& do
 	return Result{ ResultType::SUCCESS };
 }
 
-void ResourceInfo::SetDataChecksum( const std::string& checksum )
+void ResourceInfo::SetDataChecksum( const ResourceTools::Digest128& checksum )
 {
 	m_checksum = checksum;
 
@@ -1262,7 +1331,7 @@ Result ResourceInfo::ExportToCsv( std::string& out, const VersionInternal& docum
 		return Result{ ResultType::REQUIRED_RESOURCE_PARAMETER_NOT_SET };
 	}
 
-	result << m_checksum.GetValue() << ",";
+	result << m_checksum.GetValue().ToHexString() << ",";
 
 	if( !m_uncompressedSize.HasValue() )
 	{
@@ -10,6 +10,7 @@
 #include <vector>
 #include <filesystem>
 #include <yaml-cpp/yaml.h>
+#include <Digest128.h>
 #include "Enums.h"
 #include "ResourceGroup.h"
 #include "../VersionInternal.h"
@@ -19,6 +20,7 @@ namespace ResourceTools
 {
 class FileDataStreamIn;
 class FileDataStreamOut;
+enum class ChecksumAlgorithm;
 }
 
 namespace CarbonResources
@@ -201,6 +203,8 @@ public:
 
 	Result SetFromRelativePathAndDataChecksum( const std::filesystem::path& relativePath, const std::string& dataChecksum );
 
+	Result SetFromRelativePathAndDataChecksum( const std::filesystem::path& relativePath, const ResourceTools::Digest128& dataChecksum );
+
 	std::string ToString()
 	{
 		return location;
@@ -214,13 +218,15 @@ private:
 };
 
 
+ResourceTools::ChecksumAlgorithm GetResourceToolsChecksumAlgorithm( ChecksumAlgorithm checksumAlgorithm );
+
 struct ResourceInfoParams
 {
 	std::filesystem::path relativePath;
 
 	std::string location = "";
 
-	std::string checksum = "";
+	std::optional<ResourceTools::Digest128> checksum;
 
 	uintmax_t compressedSize = 0;
 
@@ -239,7 +245,9 @@ struct ResourceGetDataStreamParams
 
 	std::filesystem::path cacheBasePath = "cache";
 
-	std::string expectedChecksum = "";
+	std::optional<ResourceTools::Digest128> expectedChecksum;
+
+	ChecksumAlgorithm checksumAlgorithm = ChecksumAlgorithm::MD5;
 
 	std::chrono::seconds downloadRetrySeconds{ 120 };
 };
@@ -252,7 +260,9 @@ struct ResourceGetDataParams
 
 	std::filesystem::path cacheBasePath = "cache";
 
-	std::string expectedChecksum = "";
+	std::optional<ResourceTools::Digest128> expectedChecksum;
+
+	ChecksumAlgorithm checksumAlgorithm = ChecksumAlgorithm::MD5;
 
 	std::chrono::seconds downloadRetrySeconds{ 120 };
 };
@@ -281,6 +291,10 @@ public:
 
 	void SetRelativePath( const std::filesystem::path& relativePath );
 
+	Result UpdateLocation(); // Regenerate location parameter after changing checksum or relative path.
+
+	void SetLocation( const std::string& location ); // Share data stored at another resource's location, replaced by UpdateLocation.
+
 	Result GetBinaryOperation( unsigned int& binaryOperation ) const;
 
 	Result GetRelativePath( std::filesystem::path& relativePath ) const;
@@ -293,6 +307,8 @@ public:
 
 	Result GetChecksum( std::string& checksum ) const;
 
+	Result GetChecksum( ResourceTools::Digest128& checksum ) const;
+
 	Result GetUncompressedSize( uintmax_t& uncompressedSize ) const;
 
 	Result GetCompressedSize( uintmax_t& compressedSize ) const;
@@ -305,17 +321,20 @@ public:
 
 	Result PutData( ResourcePutDataParams& params ) const;
 
+	// Path a stream put to the destination writes to unmodified, fails for destinations which transform the data such as REMOTE_CDN
+	Result GetLocalDestinationPath( const ResourceDestinationSettings& resourceDestinationSettings, std::filesystem::path& path ) const;
+
 	virtual Result ImportFromYaml( YAML::Node& resource, const VersionInternal& documentVersion );
 
 	virtual Result ExportToYaml( YAML::Emitter& out, const VersionInternal& documentVersion );
 
 	Result ExportToCsv( std::string& out, const VersionInternal& documentVersion );
 
-	Result SetParametersFromData( const std::string& data, bool calculateCompression = true );
+	Result SetParametersFromData( const std::string& data, ChecksumAlgorithm checksumAlgorithm, bool calculateCompression = true );
 
-	Result SetParametersFromSourceStream( ResourceTools::FileDataStreamIn& stream, size_t matchSize );
+	Result SetParametersFromSourceStream( ResourceTools::FileDataStreamIn& stream, size_t matchSize, ChecksumAlgorithm checksumAlgorithm );
 
-	void SetDataChecksum( const std::string& checksum );
+	void SetDataChecksum( const ResourceTools::Digest128& checksum );
 
 	void SetCompressedSize( uintmax_t compressedSize );
 
@@ -354,8 +373,6 @@ private:
 
 	Result PutDataRemoteCdn( ResourcePutDataParams& params ) const;
 
-	Result UpdateLocation(); // Regenerate location parameter after changing checksum or relative path.
-
 protected:
 	// Parameters for document version 0.0.0
 	DocumentParameter<std::filesystem::path> m_relativePath = DocumentParameter<std::filesystem::path>( RELATIVE_PATH, TypeId() );
@@ -364,7 +381,8 @@ protected:
 
 	DocumentParameter<std::string> m_type = DocumentParameter<std::string>( TYPE, TypeId() );
 
-	DocumentParameter<std::string> m_checksum = DocumentParameter<std::string>( CHECKSUM, TypeId() );
+	// Held in binary form, converted to hex only on export
+	DocumentParameter<ResourceTools::Digest128> m_checksum = DocumentParameter<ResourceTools::Digest128>( CHECKSUM, TypeId() );
 
 	DocumentParameter<uintmax_t> m_compressedSize = DocumentParameter<uintmax_t>( COMPRESSED_SIZE, TypeId() );
 
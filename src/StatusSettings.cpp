@@ -36,10 +36,15 @@ void StatusSettings::Update( StatusProgressType statusProgressType, float progre
     {
 		// Update last update
 		m_lastUpdate.statusProgressType = statusProgressType;
-		m_lastUpdate.progress = progress;
-		m_lastUpdate.percentageSizeOfJob = percentageSizeOfJob;
 		m_lastUpdate.info = info;
 
+		// Unbounded updates carry no progress, keep reporting the progress of the job in flight
+		if( statusProgressType != StatusProgressType::UNBOUNDED )
+		{
+			m_lastUpdate.progress = progress;
+			m_lastUpdate.percentageSizeOfJob = percentageSizeOfJob;
+		}
+
 		StatusReturn scaledProgressAndScale = CalculateOverallProgress();
 
 		m_callbackSettings.statusCallback( statusProgressType, progress, scaledProgressAndScale.progress, percentageSizeOfJob, m_nestingLevel, info );
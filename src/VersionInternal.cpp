@@ -25,39 +25,35 @@ VersionInternal::VersionInternal( unsigned int major, unsigned int minor, unsign
 
 bool VersionInternal::operator>( const VersionInternal& value ) const
 {
-	if( m_major > value.m_major )
+	// Lower parts only decide the order when the higher parts are equal
+	if( m_major != value.m_major )
 	{
-		return true;
+		return m_major > value.m_major;
+	}
+	else if( m_minor != value.m_minor )
+	{
+		return m_minor > value.m_minor;
 	}
 	else
 	{
-		if( m_minor > value.m_minor )
-		{
-			return true;
-		}
-		else
-		{
-			return m_patch > value.m_patch;
-		}
+		return m_patch > value.m_patch;
 	}
 }
 
 bool VersionInternal::operator<( const VersionInternal& value ) const
 {
-	if( m_major < value.m_major )
+	// Lower parts only decide the order when the higher parts are equal
+	if( m_major != value.m_major )
 	{
-		return true;
+		return m_major < value.m_major;
+	}
+	else if( m_minor != value.m_minor )
+	{
+		return m_minor < value.m_minor;
 	}
 	else
 	{
-		if( m_minor < value.m_minor )
-		{
-			return true;
-		}
-		else
-		{
-			return m_patch < value.m_patch;
-		}
+		return m_patch < value.m_patch;
 	}
 }
 
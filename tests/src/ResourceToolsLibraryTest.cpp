@@ -6,18 +6,31 @@
 #include <ResourceTools.h>
 #include <BundleStreamOut.h>
 #include <BundleStreamIn.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <unordered_set>
 
 #include <gtest/gtest.h>
 
 #include "ResourcesTestFixture.h"
+#include "ChecksumFilter.h"
 #include "ChunkIndex.h"
+#include "ChunkIndexCache.h"
 #include "FileDataStreamIn.h"
 #include "FileDataStreamOut.h"
+#include "FileRollbackJournal.h"
 #include "CompressedFileDataStreamOut.h"
+#include "ContentDefinedChunking.h"
 #include "GzipCompressionStream.h"
 #include "GzipDecompressionStream.h"
 #include "Md5ChecksumStream.h"
+#include "PatchPipeline.h"
 #include "Patching.h"
 #include "RollingChecksum.h"
 
@@ -25,6 +38,82 @@ struct ResourceToolsTest : public ResourcesTestFixture
 {
 };
 
+// Original scalar implementation, used to verify the optimised version gives identical results
+static ResourceTools::RollingChecksum GenerateReferenceRollingAdlerChecksum( const std::string& input, uint32_t start, uint32_t end )
+{
+	constexpr uint32_t modulo{ 2 << 15 };
+
+	uint32_t alpha = 0;
+	auto substring = input.substr( start, end - start );
+	for( auto c : substring )
+	{
+		alpha += c;
+	}
+	alpha %= modulo;
+
+	uint32_t beta = 0;
+	for( uint32_t i = start; i < end; ++i )
+	{
+		beta += ( end - i ) * substring[i - start];
+	}
+	beta %= modulo;
+
+	return ResourceTools::RollingChecksum{ alpha, beta, alpha + ( beta * modulo ) };
+}
+
+static std::string GenerateRandomData( size_t size, unsigned int seed )
+{
+	std::mt19937 generator( seed );
+
+	std::uniform_int_distribution<int> distribution( 0, 255 );
+
+	std::string data( size, '\0' );
+
+	for( char& c : data )
+	{
+		c = static_cast<char>( distribution( generator ) );
+	}
+
+	return data;
+}
+
+// Index file lookup as originally implemented, a seek and read on the index file for every probe
+static void FindReferenceChunkOffsetsInIndexFile( uint32_t chunk, const std::filesystem::path& indexPath, std::vector<size_t>& offsets )
+{
+	using IndexEntry = std::pair<uint32_t, uint32_t>;
+
+	std::ifstream indexFile( indexPath, std::ifstream::binary );
+
+	size_t beginning = 0;
+	size_t end = std::filesystem::file_size( indexPath ) / sizeof( IndexEntry );
+	IndexEntry entry;
+
+	while( beginning < end )
+	{
+		size_t pos = ( beginning + end ) / 2;
+		indexFile.seekg( pos * sizeof( IndexEntry ) );
+		indexFile.read( reinterpret_cast<char*>( &entry ), sizeof( entry ) );
+		if( entry.first < chunk )
+		{
+			beginning = pos + 1;
+		}
+		else
+		{
+			end = pos;
+		}
+	}
+
+	for( size_t pos = beginning;; ++pos )
+	{
+		indexFile.seekg( pos * sizeof( IndexEntry ) );
+		if( !indexFile.read( reinterpret_cast<char*>( &entry ), sizeof( entry ) ) || entry.first != chunk )
+		{
+			break;
+		}
+		offsets.push_back( entry.second );
+	}
+}
+
 TEST_F( ResourceToolsTest, Md5ChecksumGeneration )
 {
 	std::string input = "Dummy";
@@ -77,6 +166,153 @@ TEST_F( ResourceToolsTest, FileMd5ChecksumMatches )
 	EXPECT_FALSE( ResourceTools::Md5ChecksumMatches( sourcePath2, expectedChecksum ) );
 }
 
+TEST_F( ResourceToolsTest, Blake2b128ChecksumGeneration )
+{
+	std::string input = "Dummy";
+	std::string output = "";
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( input, ResourceTools::ChecksumAlgorithm::BLAKE2B_128, output ) );
+
+	EXPECT_EQ( output, "f1301396a11b170618930cf3322ecbf8" );
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( input, ResourceTools::ChecksumAlgorithm::MD5, output ) );
+
+	EXPECT_EQ( output, "bcf036b6f33e182d4705f4f5b1af13ac" );
+}
+
+TEST_F( ResourceToolsTest, FileBlake2b128ChecksumMatches )
+{
+	const char* testDataPathStr = TEST_DATA_BASE_PATH;
+
+	ASSERT_TRUE( testDataPathStr );
+
+	std::filesystem::path testDataPath( testDataPathStr );
+
+	std::filesystem::path sourcePath = testDataPath / "resourcesOnBranch" / "introMovie.txt";
+
+	std::string output;
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( sourcePath, ResourceTools::ChecksumAlgorithm::BLAKE2B_128, output ) );
+
+	EXPECT_EQ( output, "33115c83db77093579c69f28d035a8e5" );
+
+	EXPECT_TRUE( ResourceTools::ChecksumMatches( sourcePath, ResourceTools::ChecksumAlgorithm::BLAKE2B_128, "33115c83db77093579c69f28d035a8e5" ) );
+
+	EXPECT_FALSE( ResourceTools::ChecksumMatches( sourcePath, ResourceTools::ChecksumAlgorithm::BLAKE2B_128, "e9fadf6f2d386a0a0786bc863f20fa34" ) );
+}
+
+TEST_F( ResourceToolsTest, Xxh3128ChecksumGeneration )
+{
+	std::string output = "";
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( std::string( "Dummy" ), ResourceTools::ChecksumAlgorithm::XXH3_128, output ) );
+
+	EXPECT_EQ( output, "d6b4e5fc7c11c0fcab0efc290b5a20f5" );
+
+	// Published XXH3 128 bit hash of empty input
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( std::string( "" ), ResourceTools::ChecksumAlgorithm::XXH3_128, output ) );
+
+	EXPECT_EQ( output, "99aa06d3014798d86001c324468d497f" );
+
+	// Streamed in parts matches a single update
+	ResourceTools::ChecksumStream checksumStream( ResourceTools::ChecksumAlgorithm::XXH3_128 );
+
+	EXPECT_TRUE( checksumStream << std::string_view( "Du" ) );
+
+	EXPECT_TRUE( checksumStream << std::string_view( "mmy" ) );
+
+	EXPECT_TRUE( checksumStream.FinishAndRetrieve( output ) );
+
+	EXPECT_EQ( output, "d6b4e5fc7c11c0fcab0efc290b5a20f5" );
+}
+
+TEST_F( ResourceToolsTest, FileXxh3128ChecksumMatches )
+{
+	const char* testDataPathStr = TEST_DATA_BASE_PATH;
+
+	ASSERT_TRUE( testDataPathStr );
+
+	std::filesystem::path testDataPath( testDataPathStr );
+
+	std::filesystem::path sourcePath = testDataPath / "resourcesOnBranch" / "introMovie.txt";
+
+	std::string output;
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( sourcePath, ResourceTools::ChecksumAlgorithm::XXH3_128, output ) );
+
+	EXPECT_EQ( output, "d0af24b11478669103c3ef39b7b82c1e" );
+
+	EXPECT_TRUE( ResourceTools::ChecksumMatches( sourcePath, ResourceTools::ChecksumAlgorithm::XXH3_128, "d0af24b11478669103c3ef39b7b82c1e" ) );
+
+	EXPECT_FALSE( ResourceTools::ChecksumMatches( sourcePath, ResourceTools::ChecksumAlgorithm::XXH3_128, "33115c83db77093579c69f28d035a8e5" ) );
+}
+
+TEST_F( ResourceToolsTest, Digest128HexConversion )
+{
+	ResourceTools::Digest128 digest;
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( std::string( "Dummy" ), ResourceTools::ChecksumAlgorithm::MD5, digest ) );
+
+	EXPECT_EQ( digest.ToHexString(), "bcf036b6f33e182d4705f4f5b1af13ac" );
+
+	ResourceTools::Digest128 parsedDigest;
+
+	EXPECT_TRUE( parsedDigest.FromHexString( "BCF036B6F33E182D4705F4F5B1AF13AC" ) );
+
+	EXPECT_EQ( parsedDigest, digest );
+
+	// Leading zeros must be retained
+	EXPECT_TRUE( parsedDigest.FromHexString( "000036b6f33e182d4705f4f5b1af1300" ) );
+
+	EXPECT_EQ( parsedDigest.bytes[0], 0x00 );
+
+	EXPECT_EQ( parsedDigest.bytes[2], 0x36 );
+
+	EXPECT_EQ( parsedDigest.ToHexString(), "000036b6f33e182d4705f4f5b1af1300" );
+
+	EXPECT_LT( parsedDigest, digest );
+
+	// Invalid input leaves the digest untouched
+	EXPECT_FALSE( parsedDigest.FromHexString( "bcf036b6f33e182d4705f4f5b1af13a" ) );
+
+	EXPECT_FALSE( parsedDigest.FromHexString( "bcf036b6f33e182d4705f4f5b1af13ag" ) );
+
+	EXPECT_EQ( parsedDigest.ToHexString(), "000036b6f33e182d4705f4f5b1af1300" );
+}
+
+TEST_F( ResourceToolsTest, ChecksumOfStringViewRegion )
+{
+	std::string buffer = "prefix-Dummy-suffix";
+
+	std::string_view region = std::string_view( buffer ).substr( 7, 5 );
+
+	std::string output;
+
+	EXPECT_TRUE( ResourceTools::GenerateMd5Checksum( region, output ) );
+
+	EXPECT_EQ( output, "bcf036b6f33e182d4705f4f5b1af13ac" );
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( region, ResourceTools::ChecksumAlgorithm::BLAKE2B_128, output ) );
+
+	EXPECT_EQ( output, "f1301396a11b170618930cf3322ecbf8" );
+
+	ResourceTools::ChecksumStream checksumStream( ResourceTools::ChecksumAlgorithm::MD5 );
+
+	EXPECT_TRUE( checksumStream << region.substr( 0, 2 ) );
+
+	EXPECT_TRUE( checksumStream << region.substr( 2 ) );
+
+	EXPECT_TRUE( checksumStream.FinishAndRetrieve( output ) );
+
+	EXPECT_EQ( output, "bcf036b6f33e182d4705f4f5b1af13ac" );
+
+	std::string pathBuffer = "res:/intromovie.txt,";
+
+	EXPECT_TRUE( ResourceTools::GenerateFowlerNollVoChecksum( std::string_view( pathBuffer ).substr( 0, pathBuffer.size() - 1 ), output ) );
+
+	EXPECT_EQ( output, "a9d1721dd5cc6d54" );
+}
+
 TEST_F( ResourceToolsTest, FowlerNollVoChecksumGeneration )
 {
 	std::string input = "res:/intromovie.txt";
@@ -224,6 +460,236 @@ TEST_F( ResourceToolsTest, CompressedFileDataStremOut )
 
 	EXPECT_TRUE( FilesMatch( outputPathUncompressed, GetTestFileFileAbsolutePath( "FileStream/FileDataStreamOut.txt" ) ) );
 }
+
+TEST_F( ResourceToolsTest, FileDataStreamOutCopySpan )
+{
+	std::string sourceData = GenerateRandomData( 3 * 1024 * 1024 + 17, 11 );
+
+	std::filesystem::path sourcePath = "CopySpanSource.bin";
+
+	ASSERT_TRUE( ResourceTools::SaveFile( sourcePath, sourceData ) );
+
+	std::filesystem::path secondSourcePath = "CopySpanSecondSource.bin";
+
+	std::string secondSourceData = GenerateRandomData( 64 * 1024, 12 );
+
+	ASSERT_TRUE( ResourceTools::SaveFile( secondSourcePath, secondSourceData ) );
+
+	// Spans are interleaved with buffered writes, which must stay in order
+	std::string expected = "Header" + sourceData.substr( 5, 2 * 1024 * 1024 ) + "Middle" + sourceData.substr( 3 * 1024 * 1024 ) + secondSourceData.substr( 100, 1000 ) + sourceData.substr( 0, 10 ) + "Footer";
+
+	for( bool compressed : { false, true } )
+	{
+		std::unique_ptr<ResourceTools::FileDataStreamOut> out = compressed ? std::make_unique<ResourceTools::CompressedFileDataStreamOut>() : std::make_unique<ResourceTools::FileDataStreamOut>();
+
+		std::filesystem::path outputPath = compressed ? "CopySpanOutput.gz" : "CopySpanOutput.bin";
+
+		ResourceTools::ChecksumStream checksumStream( ResourceTools::ChecksumAlgorithm::MD5 );
+
+		ASSERT_TRUE( out->StartWrite( outputPath ) );
+
+		EXPECT_TRUE( *out << "Header" );
+
+		EXPECT_TRUE( checksumStream << std::string_view( "Header" ) );
+
+		EXPECT_TRUE( out->CopySpan( sourcePath, 5, 2 * 1024 * 1024, checksumStream ) );
+
+		EXPECT_TRUE( *out << "Middle" );
+
+		EXPECT_TRUE( checksumStream << std::string_view( "Middle" ) );
+
+		EXPECT_TRUE( out->CopySpan( sourcePath, 3 * 1024 * 1024, sourceData.size() - 3 * 1024 * 1024, checksumStream ) );
+
+		// Empty spans and spans past the end of the source
+		EXPECT_TRUE( out->CopySpan( sourcePath, sourceData.size(), 0, checksumStream ) );
+
+		EXPECT_FALSE( out->CopySpan( sourcePath, sourceData.size() - 1, 2, checksumStream ) );
+
+		// Switching source and back maps each source again
+		EXPECT_TRUE( out->CopySpan( secondSourcePath, 100, 1000, checksumStream ) );
+
+		EXPECT_TRUE( out->CopySpan( sourcePath, 0, 10, checksumStream ) );
+
+		EXPECT_TRUE( *out << "Footer" );
+
+		EXPECT_TRUE( checksumStream << std::string_view( "Footer" ) );
+
+		EXPECT_EQ( out->GetFileSize(), compressed ? out->GetFileSize() : expected.size() );
+
+		EXPECT_TRUE( out->Finish() );
+
+		std::string outputData;
+
+		ASSERT_TRUE( ResourceTools::GetLocalFileData( outputPath, outputData ) );
+
+		if( compressed )
+		{
+			std::string uncompressedData;
+
+			ASSERT_TRUE( ResourceTools::GZipUncompressData( outputData, uncompressedData ) );
+
+			outputData = std::move( uncompressedData );
+		}
+
+		EXPECT_TRUE( outputData == expected );
+
+		std::string checksum;
+
+		EXPECT_TRUE( checksumStream.FinishAndRetrieve( checksum ) );
+
+		std::string expectedChecksum;
+
+		EXPECT_TRUE( ResourceTools::GenerateMd5Checksum( expected, expectedChecksum ) );
+
+		EXPECT_EQ( checksum, expectedChecksum );
+	}
+}
+
+TEST_F( ResourceToolsTest, FileDataStreamOutCopySpanMatchesChunkedCopy )
+{
+	size_t size = 16 * 1024 * 1024;
+	size_t chunkSize = 1024 * 1024;
+
+	std::filesystem::path sourcePath = "CopySpanChunkedSource.bin";
+
+	ASSERT_TRUE( ResourceTools::SaveFile( sourcePath, GenerateRandomData( size, 13 ) ) );
+
+	// Chunked copy as patch application did before spans were copied directly
+	ResourceTools::ChecksumStream chunkedChecksumStream( ResourceTools::ChecksumAlgorithm::MD5 );
+
+	{
+		ResourceTools::FileDataStreamIn in( chunkSize );
+
+		ResourceTools::FileDataStreamOut out;
+
+		ASSERT_TRUE( in.StartRead( sourcePath ) );
+
+		ASSERT_TRUE( out.StartWrite( "CopySpanChunked.bin" ) );
+
+		while( !in.IsFinished() )
+		{
+			std::string chunk;
+
+			ASSERT_TRUE( in >> chunk );
+
+			ASSERT_TRUE( out << chunk );
+
+			ASSERT_TRUE( chunkedChecksumStream << chunk );
+		}
+
+		ASSERT_TRUE( out.Finish() );
+	}
+
+	ResourceTools::ChecksumStream spanChecksumStream( ResourceTools::ChecksumAlgorithm::MD5 );
+
+	{
+		ResourceTools::FileDataStreamOut out;
+
+		ASSERT_TRUE( out.StartWrite( "CopySpanSpan.bin" ) );
+
+		ASSERT_TRUE( out.CopySpan( sourcePath, 0, size, spanChecksumStream ) );
+
+		ASSERT_TRUE( out.Finish() );
+	}
+
+	std::string chunkedChecksum;
+	std::string spanChecksum;
+
+	EXPECT_TRUE( chunkedChecksumStream.FinishAndRetrieve( chunkedChecksum ) );
+
+	EXPECT_TRUE( spanChecksumStream.FinishAndRetrieve( spanChecksum ) );
+
+	EXPECT_EQ( chunkedChecksum, spanChecksum );
+
+	EXPECT_TRUE( FilesMatch( "CopySpanChunked.bin", "CopySpanSpan.bin" ) );
+}
+
+TEST_F( ResourceToolsTest, FileRollbackJournalRestoresFile )
+{
+	std::filesystem::path filePath = "RollbackJournalFile.bin";
+
+	std::string originalData = GenerateRandomData( 64 * 1024, 17 );
+
+	ASSERT_TRUE( ResourceTools::SaveFile( filePath, originalData ) );
+
+	std::filesystem::path journalPath = ResourceTools::FileRollbackJournal::GetJournalPath( filePath );
+
+	std::filesystem::remove( journalPath );
+
+	// Overwrites a range in the middle and one extending past the end, the second also covers data lost by truncating
+	std::vector<ResourceTools::FileRollbackJournal::Range> ranges = { { 1000, 500 }, { 60 * 1024, 8 * 1024 } };
+
+	auto modifyFile = [&]() {
+		std::fstream file( filePath, std::ios::in | std::ios::out | std::ios::binary );
+
+		std::string changed( 8 * 1024, 'x' );
+
+		file.seekp( 1000 );
+
+		file.write( changed.data(), 500 );
+
+		file.seekp( 60 * 1024 );
+
+		file.write( changed.data(), changed.size() );
+	};
+
+	{
+		ResourceTools::FileRollbackJournal journal( filePath );
+
+		EXPECT_FALSE( journal.Exists() );
+
+		ASSERT_TRUE( journal.Begin( ranges ) );
+
+		EXPECT_TRUE( journal.Exists() );
+
+		modifyFile();
+
+		std::filesystem::resize_file( filePath, 60 * 1024 );
+	}
+
+	// An interrupted modification is found by a new journal for the same file
+	{
+		ResourceTools::FileRollbackJournal journal( filePath );
+
+		ASSERT_TRUE( journal.Exists() );
+
+		EXPECT_TRUE( journal.RollBack() );
+
+		EXPECT_FALSE( journal.Exists() );
+	}
+
+	std::string restoredData;
+
+	ASSERT_TRUE( ResourceTools::GetLocalFileData( filePath, restoredData ) );
+
+	EXPECT_TRUE( restoredData == originalData );
+
+	// A committed modification is kept
+	{
+		ResourceTools::FileRollbackJournal journal( filePath );
+
+		ASSERT_TRUE( journal.Begin( ranges ) );
+
+		modifyFile();
+
+		EXPECT_TRUE( journal.Commit() );
+
+		EXPECT_FALSE( journal.Exists() );
+	}
+
+	std::string committedData;
+
+	ASSERT_TRUE( ResourceTools::GetLocalFileData( filePath, committedData ) );
+
+	ASSERT_EQ( committedData.size(), 68 * 1024 );
+
+	EXPECT_EQ( committedData.substr( 0, 1000 ), originalData.substr( 0, 1000 ) );
+
+	EXPECT_EQ( committedData.substr( 1000, 500 ), std::string( 500, 'x' ) );
+
+	EXPECT_EQ( committedData.substr( 60 * 1024 ), std::string( 8 * 1024, 'x' ) );
+}
+
 TEST_F( ResourceToolsTest, ResourceChunking )
 {
 	uintmax_t chunkSize = 1000;
@@ -461,14 +927,73 @@ TEST_F( ResourceToolsTest, CreateApplyPatch )
 	ASSERT_EQ( patched, after );
 }
 
-TEST_F( ResourceToolsTest, CreateApplyPatchFile )
+TEST_F( ResourceToolsTest, ApplyPatchWithScatteredEdits )
 {
-	const char* testDataPathStr = TEST_DATA_BASE_PATH;
-	ASSERT_TRUE( testDataPathStr );
-	std::filesystem::path testDataPath( testDataPathStr );
-
-	std::filesystem::path before_src = testDataPath / "Patch" / "PreviousBuildResources" / "introMovie.txt";
-	std::filesystem::path after_src = testDataPath / "Patch" / "NextBuildResources" / "introMovie.txt";
+	for( size_t size : { 256 * 1024, 1024 * 1024, 4 * 1024 * 1024 } )
+	{
+		std::string before = GenerateRandomData( size, 7 );
+		std::string after = before;
+
+		// Scattered edits produce many control entries, so the patch is applied through many small reads
+		for( size_t offset = 0; offset < after.size(); offset += 512 )
+		{
+			after[offset] ^= 0x5A;
+		}
+
+		std::string patch;
+		ASSERT_TRUE( ResourceTools::CreatePatch( before, after, patch ) );
+
+		std::string patched;
+		ASSERT_TRUE( ResourceTools::ApplyPatch( before, patch, patched ) );
+
+		ASSERT_EQ( patched, after );
+	}
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+// Apply time should grow linearly with patch size
+TEST_F( ResourceToolsTest, DISABLED_ApplyPatchBenchmark )
+{
+	auto toMicroseconds = []( auto duration ) { return std::chrono::duration_cast<std::chrono::microseconds>( duration ).count(); };
+
+	for( size_t size : { 256 * 1024, 1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024 } )
+	{
+		std::string before = GenerateRandomData( size, 7 );
+		std::string after = before;
+
+		for( size_t offset = 0; offset < after.size(); offset += 512 )
+		{
+			after[offset] ^= 0x5A;
+		}
+
+		std::string patch;
+		ASSERT_TRUE( ResourceTools::CreatePatch( before, after, patch ) );
+
+		// Fastest of several runs, the first also warms up the allocator
+		auto fastest = std::chrono::steady_clock::duration::max();
+
+		for( int run = 0; run < 5; run++ )
+		{
+			std::string patched;
+			auto start = std::chrono::steady_clock::now();
+			ASSERT_TRUE( ResourceTools::ApplyPatch( before, patch, patched ) );
+			fastest = std::min( fastest, std::chrono::steady_clock::now() - start );
+
+			ASSERT_EQ( patched, after );
+		}
+
+		std::cout << "Patch of " << patch.size() << " bytes applied to " << size << " bytes in " << toMicroseconds( fastest ) << "us" << std::endl;
+	}
+}
+
+TEST_F( ResourceToolsTest, CreateApplyPatchFile )
+{
+	const char* testDataPathStr = TEST_DATA_BASE_PATH;
+	ASSERT_TRUE( testDataPathStr );
+	std::filesystem::path testDataPath( testDataPathStr );
+
+	std::filesystem::path before_src = testDataPath / "Patch" / "PreviousBuildResources" / "introMovie.txt";
+	std::filesystem::path after_src = testDataPath / "Patch" / "NextBuildResources" / "introMovie.txt";
 
 	std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "CarbonResources";
 
@@ -547,6 +1072,121 @@ TEST_F( ResourceToolsTest, ApplyPatchFileChunked )
 	ASSERT_EQ( beforeChecksum, afterChecksum );
 }
 
+TEST_F( ResourceToolsTest, ApplyPatchFileStreamed )
+{
+	std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "CarbonResources" / "StreamedPatch";
+	std::filesystem::remove_all( tempDir );
+	std::filesystem::create_directories( tempDir );
+
+	std::filesystem::path next = tempDir / "next.bin";
+	std::filesystem::path patch = tempDir / "next.patch";
+	std::filesystem::path streamedTarget = tempDir / "streamed.bin";
+	std::filesystem::path chunkedTarget = tempDir / "chunked.bin";
+
+	size_t size = 16 * 1024 * 1024;
+
+	std::string patchData;
+	{
+		std::string previousData = GenerateRandomData( size, 3 );
+		std::string nextData = previousData;
+		for( size_t offset = 0; offset < nextData.size(); offset += 4096 )
+		{
+			nextData[offset] ^= 0x5A;
+		}
+		nextData += GenerateRandomData( 1024 * 1024, 4 );
+
+		ASSERT_TRUE( ResourceTools::CreatePatch( previousData, nextData, patchData ) );
+
+		ASSERT_TRUE( ResourceTools::SaveFile( next, nextData ) );
+		ASSERT_TRUE( ResourceTools::SaveFile( patch, patchData ) );
+		ASSERT_TRUE( ResourceTools::SaveFile( streamedTarget, previousData ) );
+		ASSERT_TRUE( ResourceTools::SaveFile( chunkedTarget, previousData ) );
+	}
+
+	std::string nextChecksum;
+	ASSERT_TRUE( ResourceTools::GenerateMd5Checksum( next, nextChecksum ) );
+
+	// Peak memory is checked by ResourceToolsMemoryTest, which counts every heap allocation
+	ASSERT_TRUE( ResourceTools::ApplyPatchFileStreamed( streamedTarget, patch ) );
+
+	std::string streamedChecksum;
+	ASSERT_TRUE( ResourceTools::GenerateMd5Checksum( streamedTarget, streamedChecksum ) );
+	EXPECT_EQ( streamedChecksum, nextChecksum );
+
+	// Patch data comes from memory when chunked, only the output is streamed
+	ResourceTools::BundleStreamIn chunkStream( 128 );
+	EXPECT_TRUE( chunkStream << patchData );
+	ASSERT_TRUE( ResourceTools::ApplyPatchFileChunkedStreamed( chunkedTarget, chunkStream, 4096 ) );
+
+	std::string chunkedChecksum;
+	ASSERT_TRUE( ResourceTools::GenerateMd5Checksum( chunkedTarget, chunkedChecksum ) );
+	EXPECT_EQ( chunkedChecksum, nextChecksum );
+
+	// A truncated patch leaves the target unchanged and no partial output behind
+	ASSERT_TRUE( ResourceTools::SaveFile( patch, patchData.substr( 0, patchData.size() / 2 ) ) );
+	ASSERT_FALSE( ResourceTools::ApplyPatchFileStreamed( streamedTarget, patch ) );
+	ASSERT_TRUE( ResourceTools::GenerateMd5Checksum( streamedTarget, streamedChecksum ) );
+	EXPECT_EQ( streamedChecksum, nextChecksum );
+
+	std::filesystem::path partialOutput = streamedTarget;
+	partialOutput += ".patching";
+	EXPECT_FALSE( std::filesystem::exists( partialOutput ) );
+
+	std::filesystem::remove_all( tempDir );
+}
+
+TEST_F( ResourceToolsTest, BundleStreamInReadsAcrossAppends )
+{
+	std::string data = GenerateRandomData( 4096, 11 );
+
+	ResourceTools::BundleStreamIn stream( 100 );
+
+	// Reads are interleaved with appends so consumed data is dropped part way through
+	std::string read;
+	size_t appended = 0;
+	size_t readSize = 1;
+	while( read.size() < data.size() )
+	{
+		if( appended < data.size() )
+		{
+			EXPECT_TRUE( stream << data.substr( appended, 300 ) );
+			appended = std::min( data.size(), appended + 300 );
+		}
+
+		readSize = std::min<size_t>( readSize * 2, 257 );
+		while( stream.GetCacheSize() >= readSize || ( appended == data.size() && stream.GetCacheSize() > 0 ) )
+		{
+			std::string_view view;
+			size_t toRead = std::min<size_t>( readSize, stream.GetCacheSize() );
+			ASSERT_TRUE( stream.ReadView( toRead, view ) );
+			ASSERT_EQ( view.size(), toRead );
+			read.append( view );
+			ASSERT_EQ( read.size() + stream.GetCacheSize(), appended );
+		}
+	}
+
+	EXPECT_EQ( read, data );
+
+	std::string_view view;
+	EXPECT_FALSE( stream.ReadView( 1, view ) );
+
+	// Files are read back in chunk sized pieces from the same cache
+	EXPECT_TRUE( stream << data );
+	ResourceTools::GetFile file;
+	file.fileSize = 250;
+	std::string fileData;
+	file.data = &fileData;
+	std::string reconstituted;
+	do
+	{
+		ASSERT_TRUE( stream >> file );
+		reconstituted.append( fileData );
+	} while( reconstituted.size() < file.fileSize );
+
+	EXPECT_EQ( reconstituted, data.substr( 0, 250 ) );
+	EXPECT_EQ( stream.GetCacheSize(), data.size() - 250 );
+}
+
 TEST_F( ResourceToolsTest, RollingChecksum )
 {
 	std::string data( "01234asdf567asdf89" );
@@ -578,6 +1218,94 @@ TEST_F( ResourceToolsTest, RollingChecksum )
 	}
 }
 
+TEST_F( ResourceToolsTest, RollingChecksumMatchesReference )
+{
+	// Random data covers bytes above 127 which are negative when char is signed
+	std::string data = GenerateRandomData( 200000, 1 );
+
+	// Sizes either side of the vector block sizes, with unaligned starts
+	for( uint32_t size : { 0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 63u, 64u, 65u, 1000u, 65536u, 65537u, 199000u } )
+	{
+		for( uint32_t start : { 0u, 1u, 7u, 1000u } )
+		{
+			ResourceTools::RollingChecksum expected = GenerateReferenceRollingAdlerChecksum( data, start, start + size );
+			ResourceTools::RollingChecksum result = ResourceTools::GenerateRollingAdlerChecksum( data, start, start + size );
+
+			ASSERT_EQ( expected.alpha, result.alpha );
+			ASSERT_EQ( expected.beta, result.beta );
+			ASSERT_EQ( expected.checksum, result.checksum );
+		}
+	}
+}
+
+TEST_F( ResourceToolsTest, RollingChecksumBatch )
+{
+	std::string data = GenerateRandomData( 100000, 2 );
+
+	const uint32_t windowSize = 1024;
+	const uint32_t start = 3;
+	const uint32_t end = 90000;
+
+	std::vector<uint32_t> checksums;
+
+	ResourceTools::RollingChecksum last = ResourceTools::GenerateRollingAdlerChecksums( data, start, end, windowSize, checksums );
+
+	ASSERT_EQ( checksums.size(), end - start - windowSize + 1 );
+
+	ResourceTools::RollingChecksum previous = ResourceTools::GenerateRollingAdlerChecksum( data, start, start + windowSize );
+
+	EXPECT_EQ( checksums[0], previous.checksum );
+
+	for( uint32_t i = 1; i < checksums.size(); ++i )
+	{
+		previous = ResourceTools::GenerateRollingAdlerChecksum( data, start + i, start + i + windowSize, previous );
+
+		ASSERT_EQ( checksums[i], previous.checksum );
+	}
+
+	EXPECT_EQ( last.alpha, previous.alpha );
+	EXPECT_EQ( last.beta, previous.beta );
+	EXPECT_EQ( last.checksum, previous.checksum );
+
+	// Spot check against the original implementation
+	EXPECT_EQ( checksums[5000], GenerateReferenceRollingAdlerChecksum( data, start + 5000, start + 5000 + windowSize ).checksum );
+
+	// No complete window
+	ResourceTools::GenerateRollingAdlerChecksums( data, 0, windowSize - 1, windowSize, checksums );
+
+	EXPECT_TRUE( checksums.empty() );
+}
+
+TEST_F( ResourceToolsTest, RollingChecksumLargeDataMatchesReference )
+{
+	std::string data = GenerateRandomData( 4 * 1024 * 1024, 3 );
+
+	const uint32_t windowSize = 64 * 1024;
+
+	EXPECT_EQ( GenerateReferenceRollingAdlerChecksum( data, 0, static_cast<uint32_t>( data.size() ) ).checksum, ResourceTools::GenerateRollingAdlerChecksum( data, 0, static_cast<uint32_t>( data.size() ) ).checksum );
+
+	// Per byte rolling calls against a single batch call over the same span
+	const uint32_t end = static_cast<uint32_t>( data.size() );
+
+	ResourceTools::RollingChecksum rolling = ResourceTools::GenerateRollingAdlerChecksum( data, 0, windowSize );
+	uint32_t rollingResult = rolling.checksum;
+	for( uint32_t offset = 1; offset + windowSize <= end; ++offset )
+	{
+		rolling = ResourceTools::GenerateRollingAdlerChecksum( data, offset, offset + windowSize, rolling );
+		rollingResult += rolling.checksum;
+	}
+
+	std::vector<uint32_t> checksums;
+	ResourceTools::GenerateRollingAdlerChecksums( data, 0, end, windowSize, checksums );
+	uint32_t batchResult = 0;
+	for( uint32_t checksum : checksums )
+	{
+		batchResult += checksum;
+	}
+
+	EXPECT_EQ( rollingResult, batchResult );
+}
+
 TEST_F( ResourceToolsTest, FindMatchingChunksEverythingMatches )
 {
 	std::string source( "0123456789" );
@@ -762,6 +1490,564 @@ TEST_F( ResourceToolsTest, GenerateChunkIndexWithFilter )
 	ASSERT_EQ( offset, data.size() - 31 );
 }
 
+TEST_F( ResourceToolsTest, FindMatchingChunkAfterCollisions )
+{
+	std::filesystem::path dataPath = "./FindMatchingChunkAfterCollisions/data.bin";
+	std::filesystem::create_directories( dataPath.parent_path() );
+
+	const uint32_t chunkSize = 16;
+
+	std::string chunk;
+	for( uint32_t i = 0; i < chunkSize; ++i )
+	{
+		chunk += static_cast<char>( 'A' + i );
+	}
+
+	// Adding +m, -2m, +m to consecutive bytes keeps both rolling sums, so every variant collides with the chunk
+	// The chunk itself is placed after all of its collisions
+	const uint32_t variantCount = 200;
+	std::string data;
+	for( uint32_t variant = 0; variant < variantCount; ++variant )
+	{
+		std::string collision = chunk;
+		size_t position = variant % ( chunkSize - 2 );
+		char magnitude = static_cast<char>( 1 + variant / ( chunkSize - 2 ) );
+		collision[position] += magnitude;
+		collision[position + 1] -= 2 * magnitude;
+		collision[position + 2] += magnitude;
+		ASSERT_EQ( ResourceTools::GenerateRollingAdlerChecksum( collision, 0, chunkSize ).checksum, ResourceTools::GenerateRollingAdlerChecksum( chunk, 0, chunkSize ).checksum );
+		data += collision;
+	}
+	size_t chunkPosition = data.size();
+	data += chunk;
+	std::ofstream( dataPath, std::ios::binary ).write( data.data(), data.size() );
+
+	for( uintmax_t memoryBudget : { uintmax_t{ 0 }, uintmax_t{ 1024 * 1024 } } )
+	{
+		std::filesystem::path indexFolder = dataPath.parent_path() / ( "Indexes" + std::to_string( memoryBudget ) );
+		ResourceTools::ChunkIndex index( dataPath, chunkSize, indexFolder, memoryBudget );
+		ASSERT_TRUE( index.Generate() );
+
+		size_t offset;
+		ASSERT_TRUE( index.FindMatchingChunk( chunk, offset ) );
+		EXPECT_EQ( offset, chunkPosition );
+
+		const ResourceTools::ChunkIndex::MatchStatistics& statistics = index.GetMatchStatistics();
+		EXPECT_EQ( statistics.queries, 1 );
+		EXPECT_GE( statistics.collisions, variantCount );
+		EXPECT_EQ( statistics.candidates, statistics.collisions + 1 );
+		EXPECT_EQ( statistics.strongChecksumsGenerated, statistics.candidates );
+		EXPECT_EQ( statistics.strongChecksumCacheHits, 0 );
+
+		// Candidates were hashed by the first query and are reused by the second, memoised checksums are charged to the memory budget
+		uint64_t strongChecksumsGenerated = statistics.strongChecksumsGenerated;
+		ASSERT_TRUE( index.FindMatchingChunk( chunk, offset ) );
+		EXPECT_EQ( offset, chunkPosition );
+		if( memoryBudget == 0 )
+		{
+			EXPECT_EQ( statistics.strongChecksumsGenerated, 2 * strongChecksumsGenerated );
+			EXPECT_EQ( statistics.strongChecksumCacheHits, 0 );
+		}
+		else
+		{
+			EXPECT_EQ( statistics.strongChecksumsGenerated, strongChecksumsGenerated );
+			EXPECT_EQ( statistics.strongChecksumCacheHits, strongChecksumsGenerated );
+		}
+
+		std::string notInFile = chunk;
+		std::swap( notInFile[0], notInFile[chunkSize - 1] );
+		EXPECT_FALSE( index.FindMatchingChunk( notInFile, offset ) );
+	}
+}
+
+TEST_F( ResourceToolsTest, ChecksumFilterFalsePositiveRate )
+{
+	std::mt19937 generator( 11 );
+
+	std::unordered_set<uint32_t> inserted;
+	while( inserted.size() < 1024 * 1024 )
+	{
+		inserted.insert( static_cast<uint32_t>( generator() ) );
+	}
+
+	std::vector<uint32_t> queries;
+	while( queries.size() < 4 * 1024 * 1024 )
+	{
+		uint32_t checksum = static_cast<uint32_t>( generator() );
+		if( inserted.find( checksum ) == inserted.end() )
+		{
+			queries.push_back( checksum );
+		}
+	}
+
+	size_t previousSize = 0;
+	for( double falsePositiveRate : { 0.05, 0.01, 0.001 } )
+	{
+		ResourceTools::ChecksumFilter filter;
+		filter.Reset( inserted.size(), falsePositiveRate );
+		for( uint32_t checksum : inserted )
+		{
+			filter.Insert( checksum );
+		}
+
+		for( uint32_t checksum : inserted )
+		{
+			ASSERT_TRUE( filter.MayContain( checksum ) );
+		}
+
+		size_t falsePositives = std::count_if( queries.begin(), queries.end(), [&filter]( uint32_t checksum ) { return filter.MayContain( checksum ); } );
+		double measuredRate = static_cast<double>( falsePositives ) / queries.size();
+		EXPECT_LT( measuredRate, falsePositiveRate * 1.25 );
+
+		// Lower rates need more bits per checksum
+		EXPECT_GT( filter.GetSizeInBytes(), previousSize );
+		previousSize = filter.GetSizeInBytes();
+	}
+}
+
+TEST_F( ResourceToolsTest, ChunkIndexFilterCounters )
+{
+	const char* testDataPathStr = TEST_DATA_BASE_PATH;
+	ASSERT_TRUE( testDataPathStr );
+	std::filesystem::path testDataPath( testDataPathStr );
+	std::filesystem::path introMovieFilePath = testDataPath / "ResourcesOnBranch" / "introMovie.txt";
+	std::string data;
+	ResourceTools::GetLocalFileData( introMovieFilePath, data );
+
+	const uint32_t chunkSize = 20;
+
+	std::filesystem::path targetPath = "./ChunkIndexFilterCounters/target.txt";
+	std::filesystem::create_directories( targetPath.parent_path() );
+	std::string target = data.substr( data.size() / 3, data.size() / 3 );
+	std::ofstream( targetPath, std::ios::binary ).write( target.data(), target.size() );
+
+	ResourceTools::ChunkIndex unfilteredIndex( introMovieFilePath, chunkSize, "./ChunkIndexFilterCounters/Unfiltered", 1024 * 1024 );
+	ASSERT_TRUE( unfilteredIndex.Generate() );
+	EXPECT_EQ( unfilteredIndex.GetFilterHitCount(), 0 );
+	EXPECT_EQ( unfilteredIndex.GetFilterMissCount(), 0 );
+
+	ResourceTools::ChunkIndex filteredIndex( introMovieFilePath, chunkSize, "./ChunkIndexFilterCounters/Filtered", 1024 * 1024 );
+	ASSERT_TRUE( filteredIndex.GenerateChecksumFilter( targetPath ) );
+	ASSERT_TRUE( filteredIndex.Generate() );
+
+	std::unordered_set<uint32_t> targetChecksums;
+	for( size_t offset = 0; offset < target.size(); offset += chunkSize )
+	{
+		std::string chunk = target.substr( offset, chunkSize );
+		targetChecksums.insert( ResourceTools::GenerateRollingAdlerChecksum( chunk, 0, static_cast<uint32_t>( chunk.size() ) ).checksum );
+	}
+
+	std::vector<uint32_t> checksums;
+	ResourceTools::GenerateRollingAdlerChecksums( data, 0, static_cast<uint32_t>( data.size() ), chunkSize, checksums );
+	uint64_t relevantWindows = std::count_if( checksums.begin(), checksums.end(), [&targetChecksums]( uint32_t checksum ) { return targetChecksums.find( checksum ) != targetChecksums.end(); } );
+
+	// Every window is counted once, the filter never rejects a relevant window and lets through few others
+	EXPECT_EQ( filteredIndex.GetFilterHitCount() + filteredIndex.GetFilterMissCount(), checksums.size() );
+	EXPECT_GE( filteredIndex.GetFilterHitCount(), relevantWindows );
+	EXPECT_LT( filteredIndex.GetFilterHitCount() - relevantWindows, ( checksums.size() - relevantWindows ) / 20 );
+
+	for( uint32_t checksum : targetChecksums )
+	{
+		std::vector<size_t> expectedOffsets;
+		ASSERT_TRUE( unfilteredIndex.FindChunkOffsets( checksum, expectedOffsets ) );
+
+		std::vector<size_t> filteredOffsets;
+		ASSERT_TRUE( filteredIndex.FindChunkOffsets( checksum, filteredOffsets ) );
+		EXPECT_EQ( filteredOffsets, expectedOffsets );
+	}
+}
+
+TEST_F( ResourceToolsTest, GenerateChunkIndexInMemory )
+{
+	const char* testDataPathStr = TEST_DATA_BASE_PATH;
+	ASSERT_TRUE( testDataPathStr );
+	std::filesystem::path testDataPath( testDataPathStr );
+	std::filesystem::path introMovieFilePath = testDataPath / "ResourcesOnBranch" / "introMovie.txt";
+	std::string data;
+	ResourceTools::GetLocalFileData( introMovieFilePath, data );
+
+	// Index file names are derived from the indexed file so each on disk index needs its own folder
+	std::filesystem::path indexFolder = "./GenerateChunkIndexInMemory/Indexes";
+	std::filesystem::path overBudgetIndexFolder = "./GenerateChunkIndexInMemory/OverBudgetIndexes";
+
+	const uint32_t chunkSize = 20;
+
+	ResourceTools::ChunkIndex onDiskIndex( introMovieFilePath, chunkSize, indexFolder, 0 );
+	ASSERT_TRUE( onDiskIndex.Generate() );
+	EXPECT_FALSE( onDiskIndex.IsInMemory() );
+
+	ResourceTools::ChunkIndex inMemoryIndex( introMovieFilePath, chunkSize, indexFolder, 1024 * 1024 );
+	ASSERT_TRUE( inMemoryIndex.Generate() );
+	EXPECT_TRUE( inMemoryIndex.IsInMemory() );
+
+	// Filtered index starts in memory and falls back to index files once the budget is exceeded
+	ResourceTools::ChunkIndex overBudgetIndex( introMovieFilePath, chunkSize, overBudgetIndexFolder, 1024 );
+	ASSERT_TRUE( overBudgetIndex.GenerateChecksumFilter( introMovieFilePath ) );
+	ASSERT_TRUE( overBudgetIndex.Generate() );
+	EXPECT_FALSE( overBudgetIndex.IsInMemory() );
+
+	ResourceTools::ChunkIndex filteredInMemoryIndex( introMovieFilePath, chunkSize, overBudgetIndexFolder, 1024 * 1024 );
+	ASSERT_TRUE( filteredInMemoryIndex.GenerateChecksumFilter( introMovieFilePath ) );
+	ASSERT_TRUE( filteredInMemoryIndex.Generate() );
+	EXPECT_TRUE( filteredInMemoryIndex.IsInMemory() );
+
+	// Windows must be found at the same offsets regardless of where the index is held
+	for( size_t windowOffset = 0; windowOffset + chunkSize <= data.size(); windowOffset += 7 )
+	{
+		uint32_t checksum = ResourceTools::GenerateRollingAdlerChecksum( data, static_cast<uint32_t>( windowOffset ), static_cast<uint32_t>( windowOffset + chunkSize ) ).checksum;
+
+		std::vector<size_t> onDiskOffsets;
+		ASSERT_TRUE( onDiskIndex.FindChunkOffsets( checksum, onDiskOffsets ) );
+
+		std::vector<size_t> inMemoryOffsets;
+		ASSERT_TRUE( inMemoryIndex.FindChunkOffsets( checksum, inMemoryOffsets ) );
+		EXPECT_TRUE( std::is_sorted( inMemoryOffsets.begin(), inMemoryOffsets.end() ) );
+		EXPECT_EQ( inMemoryOffsets, onDiskOffsets );
+		EXPECT_NE( std::find( inMemoryOffsets.begin(), inMemoryOffsets.end(), windowOffset ), inMemoryOffsets.end() );
+
+		std::vector<size_t> overBudgetOffsets;
+		ASSERT_TRUE( overBudgetIndex.FindChunkOffsets( checksum, overBudgetOffsets ) );
+
+		std::vector<size_t> filteredInMemoryOffsets;
+		ASSERT_TRUE( filteredInMemoryIndex.FindChunkOffsets( checksum, filteredInMemoryOffsets ) );
+		EXPECT_EQ( filteredInMemoryOffsets, overBudgetOffsets );
+	}
+
+	size_t offset;
+
+	std::string startOfFile = data.substr( 0, chunkSize );
+	ASSERT_TRUE( inMemoryIndex.FindMatchingChunk( startOfFile, offset ) );
+	ASSERT_EQ( offset, 0 );
+
+	std::string notInFile = "Once upon a time, in a galaxy far, far away...";
+	ResourceTools::ChunkIndex notInFileIndex( introMovieFilePath, static_cast<uint32_t>( notInFile.size() ), indexFolder, 1024 * 1024 );
+	ASSERT_TRUE( notInFileIndex.Generate() );
+	EXPECT_TRUE( notInFileIndex.IsInMemory() );
+	ASSERT_FALSE( notInFileIndex.FindMatchingChunk( notInFile, offset ) );
+}
+
+TEST_F( ResourceToolsTest, GenerateChunkIndexMultiThreaded )
+{
+	std::filesystem::path dataPath = "./GenerateChunkIndexMultiThreaded/data.bin";
+	std::filesystem::path targetPath = "./GenerateChunkIndexMultiThreaded/target.bin";
+	std::filesystem::create_directories( dataPath.parent_path() );
+
+	// Large enough to be split into several segments, low entropy so checksums repeat across segments
+	std::string data = GenerateRandomData( 9 * 1024 * 1024, 6 );
+	for( char& c : data )
+	{
+		c &= 0x03;
+	}
+	std::ofstream( dataPath, std::ios::binary ).write( data.data(), data.size() );
+
+	std::string target = data.substr( 1000, 3 * 1024 * 1024 );
+	std::ofstream( targetPath, std::ios::binary ).write( target.data(), target.size() );
+
+	const uint32_t chunkSize = 64;
+
+	ResourceTools::ChunkIndex singleThreadedIndex( dataPath, chunkSize, "./GenerateChunkIndexMultiThreaded/SingleThreaded", 0, 1 );
+	ASSERT_TRUE( singleThreadedIndex.Generate() );
+
+	ResourceTools::ChunkIndex onDiskIndex( dataPath, chunkSize, "./GenerateChunkIndexMultiThreaded/OnDisk", 0, 4 );
+	ASSERT_TRUE( onDiskIndex.Generate() );
+	EXPECT_FALSE( onDiskIndex.IsInMemory() );
+
+	ResourceTools::ChunkIndex inMemoryIndex( dataPath, chunkSize, "./GenerateChunkIndexMultiThreaded/InMemory", 1024 * 1024 * 1024, 4 );
+	ASSERT_TRUE( inMemoryIndex.Generate() );
+	EXPECT_TRUE( inMemoryIndex.IsInMemory() );
+
+	ResourceTools::ChunkIndex filteredIndex( dataPath, chunkSize, "./GenerateChunkIndexMultiThreaded/Filtered", 1024 * 1024 * 1024, 1 );
+	ASSERT_TRUE( filteredIndex.GenerateChecksumFilter( targetPath ) );
+	ASSERT_TRUE( filteredIndex.Generate() );
+	EXPECT_TRUE( filteredIndex.IsInMemory() );
+
+	// Some segments are gathered in memory before the budget is exceeded and the rest are written by workers
+	ResourceTools::ChunkIndex overBudgetIndex( dataPath, chunkSize, "./GenerateChunkIndexMultiThreaded/OverBudget", 4 * 1024 * 1024, 4 );
+	ASSERT_TRUE( overBudgetIndex.GenerateChecksumFilter( targetPath ) );
+	ASSERT_TRUE( overBudgetIndex.Generate() );
+	EXPECT_FALSE( overBudgetIndex.IsInMemory() );
+
+	std::mt19937 generator( 7 );
+	std::uniform_int_distribution<size_t> distribution( 0, data.size() - chunkSize );
+	for( int i = 0; i < 5000; ++i )
+	{
+		size_t windowOffset = distribution( generator );
+		uint32_t checksum = ResourceTools::GenerateRollingAdlerChecksum( data, static_cast<uint32_t>( windowOffset ), static_cast<uint32_t>( windowOffset + chunkSize ) ).checksum;
+
+		std::vector<size_t> expectedOffsets;
+		ASSERT_TRUE( singleThreadedIndex.FindChunkOffsets( checksum, expectedOffsets ) );
+		EXPECT_NE( std::find( expectedOffsets.begin(), expectedOffsets.end(), windowOffset ), expectedOffsets.end() );
+
+		std::vector<size_t> onDiskOffsets;
+		ASSERT_TRUE( onDiskIndex.FindChunkOffsets( checksum, onDiskOffsets ) );
+		EXPECT_EQ( onDiskOffsets, expectedOffsets );
+
+		std::vector<size_t> inMemoryOffsets;
+		ASSERT_TRUE( inMemoryIndex.FindChunkOffsets( checksum, inMemoryOffsets ) );
+		EXPECT_EQ( inMemoryOffsets, expectedOffsets );
+
+		std::vector<size_t> filteredOffsets;
+		ASSERT_TRUE( filteredIndex.FindChunkOffsets( checksum, filteredOffsets ) );
+
+		std::vector<size_t> overBudgetOffsets;
+		ASSERT_TRUE( overBudgetIndex.FindChunkOffsets( checksum, overBudgetOffsets ) );
+		EXPECT_EQ( overBudgetOffsets, filteredOffsets );
+	}
+}
+
+TEST_F( ResourceToolsTest, ChunkIndexCacheReuseAndEviction )
+{
+	std::filesystem::path cacheFolder = "./ChunkIndexCacheReuseAndEviction/Cache";
+	std::filesystem::remove_all( cacheFolder );
+	std::filesystem::create_directories( cacheFolder );
+
+	std::vector<std::filesystem::path> dataPaths;
+	std::vector<std::string> keys;
+	for( unsigned int i = 0; i < 3; ++i )
+	{
+		std::filesystem::path dataPath = "./ChunkIndexCacheReuseAndEviction/data" + std::to_string( i ) + ".bin";
+		std::string data = GenerateRandomData( 64 * 1024, 10 + i );
+		std::ofstream( dataPath, std::ios::binary ).write( data.data(), data.size() );
+		dataPaths.push_back( dataPath );
+
+		ResourceTools::Digest128 checksum;
+		ASSERT_TRUE( ResourceTools::GenerateChecksum( data, ResourceTools::ChecksumAlgorithm::MD5, checksum ) );
+		keys.push_back( ResourceTools::ChunkIndexCache::CreateKey( checksum, 32 ) );
+	}
+
+	// Each entry is 8 bytes per window plus a small manifest, room for two entries
+	const uintmax_t maximumSize = 2 * 8 * 64 * 1024 + 4096;
+	ResourceTools::ChunkIndexCache cache( cacheFolder, maximumSize );
+
+	ResourceTools::ChunkIndex missIndex( dataPaths[0], 32, "./ChunkIndexCacheReuseAndEviction/Indexes" );
+	EXPECT_FALSE( cache.Load( keys[0], missIndex ) );
+
+	ResourceTools::ChunkIndex storedIndex( dataPaths[0], 32, "./ChunkIndexCacheReuseAndEviction/Indexes" );
+	ASSERT_TRUE( cache.Store( keys[0], dataPaths[0], 32, 1, storedIndex ) );
+	EXPECT_TRUE( std::filesystem::exists( cacheFolder / keys[0] / ResourceTools::ChunkIndex::MANIFEST_FILENAME ) );
+
+	// Hit maps the stored index without generating, results match a freshly generated index
+	ResourceTools::ChunkIndex generatedIndex( dataPaths[0], 32, "./ChunkIndexCacheReuseAndEviction/Indexes" );
+	ASSERT_TRUE( generatedIndex.Generate() );
+	{
+		ResourceTools::ChunkIndex cachedIndex( dataPaths[0], 32, "./ChunkIndexCacheReuseAndEviction/Indexes" );
+		ASSERT_TRUE( cache.Load( keys[0], cachedIndex ) );
+		EXPECT_FALSE( cachedIndex.IsInMemory() );
+
+		std::string data;
+		ASSERT_TRUE( ResourceTools::GetLocalFileData( dataPaths[0], data ) );
+		for( uint32_t windowOffset = 0; windowOffset + 32 <= data.size(); windowOffset += 97 )
+		{
+			uint32_t checksum = ResourceTools::GenerateRollingAdlerChecksum( data, windowOffset, windowOffset + 32 ).checksum;
+
+			std::vector<size_t> expectedOffsets;
+			ASSERT_TRUE( generatedIndex.FindChunkOffsets( checksum, expectedOffsets ) );
+
+			std::vector<size_t> cachedOffsets;
+			ASSERT_TRUE( cachedIndex.FindChunkOffsets( checksum, cachedOffsets ) );
+			EXPECT_EQ( cachedOffsets, expectedOffsets );
+		}
+	}
+
+	// Entry persists once the index using it is destroyed
+	EXPECT_TRUE( std::filesystem::exists( cacheFolder / keys[0] / ResourceTools::ChunkIndex::MANIFEST_FILENAME ) );
+
+	// Entry for a different chunk size is not loaded
+	ResourceTools::ChunkIndex otherChunkSizeIndex( dataPaths[0], 64, "./ChunkIndexCacheReuseAndEviction/Indexes" );
+	EXPECT_FALSE( otherChunkSizeIndex.Load( cacheFolder / keys[0] ) );
+
+	// Make the first entry the oldest, then use it so the second entry becomes least recently used
+	{
+		// Released before eviction as mapped files cannot be removed on all platforms
+		ResourceTools::ChunkIndex secondIndex( dataPaths[1], 32, "./ChunkIndexCacheReuseAndEviction/Indexes" );
+		ASSERT_TRUE( cache.Store( keys[1], dataPaths[1], 32, 1, secondIndex ) );
+	}
+	auto now = std::filesystem::file_time_type::clock::now();
+	std::filesystem::last_write_time( cacheFolder / keys[0] / ResourceTools::ChunkIndex::MANIFEST_FILENAME, now - std::chrono::hours( 2 ) );
+	std::filesystem::last_write_time( cacheFolder / keys[1] / ResourceTools::ChunkIndex::MANIFEST_FILENAME, now - std::chrono::hours( 1 ) );
+
+	ResourceTools::ChunkIndex reusedIndex( dataPaths[0], 32, "./ChunkIndexCacheReuseAndEviction/Indexes" );
+	ASSERT_TRUE( cache.Load( keys[0], reusedIndex ) );
+
+	ResourceTools::ChunkIndex thirdIndex( dataPaths[2], 32, "./ChunkIndexCacheReuseAndEviction/Indexes" );
+	ASSERT_TRUE( cache.Store( keys[2], dataPaths[2], 32, 1, thirdIndex ) );
+
+	EXPECT_TRUE( std::filesystem::exists( cacheFolder / keys[0] ) );
+	EXPECT_FALSE( std::filesystem::exists( cacheFolder / keys[1] ) );
+	EXPECT_TRUE( std::filesystem::exists( cacheFolder / keys[2] ) );
+}
+
+TEST_F( ResourceToolsTest, ChunkIndexOnDiskLookupMatchesReference )
+{
+	std::filesystem::path indexFolder = "./ChunkIndexOnDiskLookupMatchesReference/Indexes";
+	std::filesystem::path dataPath = "./ChunkIndexOnDiskLookupMatchesReference/data.bin";
+	std::filesystem::create_directories( dataPath.parent_path() );
+
+	std::string data = GenerateRandomData( 4 * 1024 * 1024, 4 );
+	std::ofstream( dataPath, std::ios::binary ).write( data.data(), data.size() );
+
+	const uint32_t chunkSize = 64;
+	const int lookups = 2000;
+
+	// Memory budget of 0 forces the index to disk, data fits in a single index file
+	ResourceTools::ChunkIndex index( dataPath, chunkSize, indexFolder, 0 );
+	ASSERT_TRUE( index.Generate() );
+	ASSERT_FALSE( index.IsInMemory() );
+
+	std::filesystem::path indexPath = indexFolder / "data.bin0.index";
+	ASSERT_TRUE( std::filesystem::exists( indexPath ) );
+
+	std::mt19937 generator( 5 );
+	std::uniform_int_distribution<size_t> distribution( 0, data.size() - chunkSize );
+	std::vector<uint32_t> checksums;
+	for( int i = 0; i < lookups; ++i )
+	{
+		size_t windowOffset = distribution( generator );
+		checksums.push_back( ResourceTools::GenerateRollingAdlerChecksum( data, static_cast<uint32_t>( windowOffset ), static_cast<uint32_t>( windowOffset + chunkSize ) ).checksum );
+	}
+
+	std::vector<std::vector<size_t>> referenceOffsets( lookups );
+	for( int i = 0; i < lookups; ++i )
+	{
+		FindReferenceChunkOffsetsInIndexFile( checksums[i], indexPath, referenceOffsets[i] );
+	}
+
+	std::vector<std::vector<size_t>> mappedOffsets( lookups );
+	for( int i = 0; i < lookups; ++i )
+	{
+		ASSERT_TRUE( index.FindChunkOffsets( checksums[i], mappedOffsets[i] ) );
+	}
+
+	EXPECT_EQ( referenceOffsets, mappedOffsets );
+}
+
+TEST_F( ResourceToolsTest, ContentDefinedChunking )
+{
+	std::string data = GenerateRandomData( 4 * 1024 * 1024, 12 );
+
+	ResourceTools::ContentDefinedChunkSizes sizes;
+	sizes.minimum = 2 * 1024;
+	sizes.average = 8 * 1024;
+	sizes.maximum = 32 * 1024;
+	ASSERT_TRUE( ResourceTools::IsValidContentDefinedChunkSizes( sizes ) );
+
+	std::vector<size_t> lengths;
+	ResourceTools::GenerateContentDefinedChunks( data, sizes, lengths );
+
+	size_t total = 0;
+	for( size_t i = 0; i < lengths.size(); ++i )
+	{
+		if( i + 1 < lengths.size() )
+		{
+			EXPECT_GE( lengths[i], sizes.minimum );
+		}
+		EXPECT_LE( lengths[i], sizes.maximum );
+		total += lengths[i];
+	}
+	EXPECT_EQ( total, data.size() );
+
+	// Normalised chunking keeps the mean close to the average
+	double meanLength = static_cast<double>( data.size() ) / lengths.size();
+	EXPECT_GT( meanLength, sizes.average * 0.75 );
+	EXPECT_LT( meanLength, sizes.average * 1.5 );
+
+	// An insertion near the start only changes the chunks around it, boundaries after it realign
+	std::string edited = data.substr( 0, 1000 ) + "inserted near the start" + data.substr( 1000 );
+	std::vector<size_t> editedLengths;
+	ResourceTools::GenerateContentDefinedChunks( edited, sizes, editedLengths );
+
+	auto collectChunks = []( const std::string& source, const std::vector<size_t>& chunkLengths ) {
+		std::set<std::string> chunks;
+		size_t offset = 0;
+		for( size_t length : chunkLengths )
+		{
+			chunks.insert( source.substr( offset, length ) );
+			offset += length;
+		}
+		return chunks;
+	};
+	std::set<std::string> chunks = collectChunks( data, lengths );
+	std::set<std::string> editedChunks = collectChunks( edited, editedLengths );
+
+	size_t sharedChunks = std::count_if( editedChunks.begin(), editedChunks.end(), [&chunks]( const std::string& chunk ) { return chunks.find( chunk ) != chunks.end(); } );
+	EXPECT_GE( sharedChunks + 2, editedChunks.size() );
+
+	ResourceTools::ContentDefinedChunkSizes invalidSizes;
+	invalidSizes.minimum = 0;
+	EXPECT_FALSE( ResourceTools::IsValidContentDefinedChunkSizes( invalidSizes ) );
+	invalidSizes.minimum = 64;
+	invalidSizes.maximum = 32;
+	EXPECT_FALSE( ResourceTools::IsValidContentDefinedChunkSizes( invalidSizes ) );
+}
+
+TEST_F( ResourceToolsTest, PatchPipelineMatchesSerialPatches )
+{
+	const int chunkCount = 32;
+	const size_t chunkSize = 256 * 1024;
+
+	// Each next chunk is its previous chunk with a region replaced
+	std::vector<std::string> previousChunks;
+	std::vector<std::string> nextChunks;
+	for( int i = 0; i < chunkCount; ++i )
+	{
+		std::string previous = GenerateRandomData( chunkSize, i );
+		std::string next = previous;
+		next.replace( i * 4096, 1024, GenerateRandomData( 1024, 100 + i ) );
+		previousChunks.push_back( std::move( previous ) );
+		nextChunks.push_back( std::move( next ) );
+	}
+
+	std::vector<std::string> serialPatches( chunkCount );
+	for( int i = 0; i < chunkCount; ++i )
+	{
+		ASSERT_TRUE( ResourceTools::CreatePatch( previousChunks[i], nextChunks[i], serialPatches[i] ) );
+	}
+
+	std::atomic<int> callbackCount = 0;
+	std::vector<std::string> pipelinePatches( chunkCount );
+	{
+		ResourceTools::PatchPipeline pipeline( 4 );
+		for( int i = 0; i < chunkCount; ++i )
+		{
+			EXPECT_EQ( pipeline.GetQueuedCount(), i );
+			ASSERT_TRUE( pipeline.Queue( previousChunks[i], nextChunks[i], [&callbackCount]( const std::string& patchData ) {
+				callbackCount++;
+				return !patchData.empty();
+			} ) );
+		}
+		ASSERT_TRUE( pipeline.Finish() );
+
+		for( int i = 0; i < chunkCount; ++i )
+		{
+			EXPECT_TRUE( pipeline.IsPatchFinished( i ) );
+			pipeline.TakePatchData( i, pipelinePatches[i] );
+		}
+	}
+
+	EXPECT_EQ( callbackCount, chunkCount );
+
+	// Patches are identical to serial patches and in queued order
+	EXPECT_EQ( serialPatches, pipelinePatches );
+
+	std::string patched;
+	ASSERT_TRUE( ResourceTools::ApplyPatch( previousChunks.back(), pipelinePatches.back(), patched ) );
+	EXPECT_EQ( patched, nextChunks.back() );
+
+	// A failed callback fails the pipeline
+	ResourceTools::PatchPipeline failingPipeline( 4 );
+	ASSERT_TRUE( failingPipeline.Queue( previousChunks[0], nextChunks[0], []( const std::string& ) { return false; } ) );
+	EXPECT_FALSE( failingPipeline.Finish() );
+	EXPECT_FALSE( failingPipeline.IsPatchFinished( 0 ) );
+
+	// With one thread each patch is finished as soon as it is queued
+	ResourceTools::PatchPipeline serialPipeline( 1 );
+	ASSERT_TRUE( serialPipeline.Queue( previousChunks[0], nextChunks[0] ) );
+	EXPECT_TRUE( serialPipeline.IsPatchFinished( 0 ) );
+	std::string serialPipelinePatch;
+	serialPipeline.TakePatchData( 0, serialPipelinePatch );
+	EXPECT_EQ( serialPipelinePatch, serialPatches[0] );
+}
+
 #if __APPLE__
 TEST_F( ResourceToolsTest, CalculateBinaryOperationMacOS )
 {
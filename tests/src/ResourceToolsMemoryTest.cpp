@@ -0,0 +1,257 @@
+// Copyright © 2025 CCP ehf.
+
+// Built as a separate test executable as it replaces the global allocation functions of the whole program
+
+#include <ResourceTools.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <new>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ResourcesTestFixture.h"
+#include "Patching.h"
+
+struct ResourceToolsMemoryTest : public ResourcesTestFixture
+{
+};
+
+static std::string GenerateRandomData( size_t size, unsigned int seed )
+{
+	std::mt19937 generator( seed );
+
+	std::uniform_int_distribution<int> distribution( 0, 255 );
+
+	std::string data( size, '\0' );
+
+	for( char& c : data )
+	{
+		c = static_cast<char>( distribution( generator ) );
+	}
+
+	return data;
+}
+
+// Heap usage counted by the replaced global allocation functions below
+// Memory mapped file pages are not allocated so are excluded, the system can reclaim them
+static std::atomic<size_t> s_allocatedBytes = 0;
+static std::atomic<size_t> s_peakAllocatedBytes = 0;
+
+// Every form of operator new and delete is replaced, so all allocations go through these two
+// The size and the address returned by malloc are stored just before the aligned allocation
+static void* CountedAllocate( std::size_t size, std::size_t alignment ) noexcept
+{
+	constexpr std::size_t headerSize = sizeof( std::size_t ) + sizeof( void* );
+
+	void* allocation = std::malloc( size + headerSize + alignment - 1 );
+	if( !allocation )
+	{
+		return nullptr;
+	}
+
+	std::uintptr_t aligned = ( reinterpret_cast<std::uintptr_t>( allocation ) + headerSize + alignment - 1 ) & ~( static_cast<std::uintptr_t>( alignment ) - 1 );
+	reinterpret_cast<std::size_t*>( aligned )[-1] = size;
+	reinterpret_cast<void**>( aligned - sizeof( std::size_t ) )[-1] = allocation;
+
+	size_t allocatedBytes = s_allocatedBytes += size;
+	size_t peakAllocatedBytes = s_peakAllocatedBytes;
+	while( allocatedBytes > peakAllocatedBytes && !s_peakAllocatedBytes.compare_exchange_weak( peakAllocatedBytes, allocatedBytes ) )
+	{
+	}
+
+	return reinterpret_cast<void*>( aligned );
+}
+
+static void CountedFree( void* pointer ) noexcept
+{
+	if( !pointer )
+	{
+		return;
+	}
+
+	std::uintptr_t aligned = reinterpret_cast<std::uintptr_t>( pointer );
+	s_allocatedBytes -= reinterpret_cast<std::size_t*>( aligned )[-1];
+	std::free( reinterpret_cast<void**>( aligned - sizeof( std::size_t ) )[-1] );
+}
+
+static void* CountedAllocateOrThrow( std::size_t size, std::size_t alignment )
+{
+	void* allocation = CountedAllocate( size, alignment );
+	if( !allocation )
+	{
+		throw std::bad_alloc();
+	}
+
+	return allocation;
+}
+
+void* operator new( std::size_t size )
+{
+	return CountedAllocateOrThrow( size, alignof( std::max_align_t ) );
+}
+
+void* operator new[]( std::size_t size )
+{
+	return CountedAllocateOrThrow( size, alignof( std::max_align_t ) );
+}
+
+void* operator new( std::size_t size, std::align_val_t alignment )
+{
+	return CountedAllocateOrThrow( size, static_cast<std::size_t>( alignment ) );
+}
+
+void* operator new[]( std::size_t size, std::align_val_t alignment )
+{
+	return CountedAllocateOrThrow( size, static_cast<std::size_t>( alignment ) );
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	return CountedAllocate( size, alignof( std::max_align_t ) );
+}
+
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	return CountedAllocate( size, alignof( std::max_align_t ) );
+}
+
+void* operator new( std::size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+	return CountedAllocate( size, static_cast<std::size_t>( alignment ) );
+}
+
+void* operator new[]( std::size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+	return CountedAllocate( size, static_cast<std::size_t>( alignment ) );
+}
+
+void operator delete( void* pointer ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete[]( void* pointer ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete( void* pointer, std::size_t ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete[]( void* pointer, std::size_t ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete( void* pointer, std::align_val_t ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete[]( void* pointer, std::align_val_t ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete( void* pointer, std::size_t, std::align_val_t ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete[]( void* pointer, std::size_t, std::align_val_t ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete( void* pointer, const std::nothrow_t& ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete[]( void* pointer, const std::nothrow_t& ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete( void* pointer, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+	CountedFree( pointer );
+}
+
+void operator delete[]( void* pointer, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+	CountedFree( pointer );
+}
+
+// Returns the peak increase in heap usage while operation runs over the usage before it started
+static size_t MeasurePeakMemoryIncrease( const std::function<void()>& operation )
+{
+	size_t baseline = s_allocatedBytes;
+	s_peakAllocatedBytes = baseline;
+
+	operation();
+
+	return s_peakAllocatedBytes - baseline;
+}
+
+TEST_F( ResourceToolsMemoryTest, ApplyPatchFileStreamedBoundedMemory )
+{
+	std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "CarbonResources" / "StreamedPatchMemory";
+	std::filesystem::remove_all( tempDir );
+	std::filesystem::create_directories( tempDir );
+
+	std::filesystem::path next = tempDir / "next.bin";
+	std::filesystem::path patch = tempDir / "next.patch";
+	std::filesystem::path streamedTarget = tempDir / "streamed.bin";
+	std::filesystem::path inMemoryTarget = tempDir / "inMemory.bin";
+
+	size_t size = 16 * 1024 * 1024;
+
+	{
+		std::string previousData = GenerateRandomData( size, 3 );
+		std::string nextData = previousData;
+		for( size_t offset = 0; offset < nextData.size(); offset += 4096 )
+		{
+			nextData[offset] ^= 0x5A;
+		}
+		nextData += GenerateRandomData( 1024 * 1024, 4 );
+
+		std::string patchData;
+		ASSERT_TRUE( ResourceTools::CreatePatch( previousData, nextData, patchData ) );
+
+		ASSERT_TRUE( ResourceTools::SaveFile( next, nextData ) );
+		ASSERT_TRUE( ResourceTools::SaveFile( patch, patchData ) );
+		ASSERT_TRUE( ResourceTools::SaveFile( streamedTarget, previousData ) );
+		ASSERT_TRUE( ResourceTools::SaveFile( inMemoryTarget, previousData ) );
+	}
+
+	bool streamedResult = false;
+	size_t streamedPeak = MeasurePeakMemoryIncrease( [&]() { streamedResult = ResourceTools::ApplyPatchFileStreamed( streamedTarget, patch ); } );
+	ASSERT_TRUE( streamedResult );
+
+	bool inMemoryResult = false;
+	size_t inMemoryPeak = MeasurePeakMemoryIncrease( [&]() { inMemoryResult = ResourceTools::ApplyPatchFile( inMemoryTarget, patch ); } );
+	ASSERT_TRUE( inMemoryResult );
+
+	// Only the output buffer is held, neither the target nor the result
+	EXPECT_LT( streamedPeak, size / 4 );
+
+	// The in memory path holds the target, the patch and the result at once
+	EXPECT_GT( inMemoryPeak, size * 2 );
+
+	std::string nextChecksum;
+	ASSERT_TRUE( ResourceTools::GenerateMd5Checksum( next, nextChecksum ) );
+
+	std::string streamedChecksum;
+	ASSERT_TRUE( ResourceTools::GenerateMd5Checksum( streamedTarget, streamedChecksum ) );
+	EXPECT_EQ( streamedChecksum, nextChecksum );
+
+	std::filesystem::remove_all( tempDir );
+}
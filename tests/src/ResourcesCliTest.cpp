@@ -2,6 +2,8 @@
 
 #include "CliTestFixture.h"
 
+#include <ResourceTools.h>
+
 struct ResourcesCliTest : public CliTestFixture
 {
 };
@@ -158,6 +160,77 @@ TEST_F( ResourcesCliTest, CreateResourceGroupFromDirectory )
 	EXPECT_TRUE( FilesMatch( goldFile, outputFile ) );
 }
 
+TEST_F( ResourcesCliTest, CreateResourceGroupFromDirectoryMultiThreaded )
+{
+	std::string output;
+
+	std::vector<std::string> arguments;
+
+	arguments.push_back( "create-group" );
+
+	arguments.push_back( "--verbosity-level" );
+	arguments.push_back( "-1" );
+
+	std::filesystem::path inputDirectory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+	arguments.push_back( inputDirectory.string() );
+
+	arguments.push_back( "--output-file" );
+	std::filesystem::path outputFile = "GroupOut/ResourceGroup.yaml";
+	arguments.push_back( outputFile.string() );
+
+	arguments.push_back( "--threads" );
+	arguments.push_back( "0" );
+
+	int res = RunCli( arguments, output );
+
+	ASSERT_EQ( res, 0 );
+
+#if _WIN64
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupWindows.yaml" );
+#elif __APPLE__
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupMacOS.yaml" );
+#else
+#error Unsupported platform
+#endif
+	EXPECT_TRUE( FilesMatch( goldFile, outputFile ) );
+}
+
+TEST_F( ResourcesCliTest, CreateResourceGroupFromDirectoryBlake2bChecksums )
+{
+	std::string output;
+
+	std::vector<std::string> arguments;
+
+	arguments.push_back( "create-group" );
+
+	arguments.push_back( "--verbosity-level" );
+	arguments.push_back( "-1" );
+
+	std::filesystem::path inputDirectory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+	arguments.push_back( inputDirectory.string() );
+
+	arguments.push_back( "--output-file" );
+	std::filesystem::path outputFile = "GroupOut/ResourceGroupBlake2b.yaml";
+	arguments.push_back( outputFile.string() );
+
+	arguments.push_back( "--checksum-algorithm" );
+	arguments.push_back( "BLAKE2B_128" );
+
+	// Requires a document version able to record the algorithm
+	ASSERT_NE( RunCli( arguments, output ), 0 );
+
+	arguments.push_back( "--document-version" );
+	arguments.push_back( "1.0.0" );
+
+	ASSERT_EQ( RunCli( arguments, output ), 0 );
+
+	std::string data;
+
+	EXPECT_TRUE( ResourceTools::GetLocalFileData( outputFile, data ) );
+
+	EXPECT_NE( data.find( "ChecksumAlgorithm: BLAKE2B_128" ), std::string::npos );
+}
+
 TEST_F( ResourcesCliTest, CreateResourceGroupFromDirectoryExportResources )
 {
 	std::string output;
@@ -10,6 +10,15 @@
 
 #include <FileDataStreamOut.h>
 
+#include <FileRollbackJournal.h>
+
+#include <ResourceTools.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <sstream>
+
 struct ResourcesLibraryTest : public ResourcesTestFixture
 {
 };
@@ -951,110 +960,1669 @@ TEST_F( ResourcesLibraryTest, ApplyPatchWithChunking )
 	EXPECT_TRUE( FilesMatch( nextTestResource, patchApplyParams.resourcesToPatchDestinationSettings.basePath / "testresource2.txt" ) );
 }
 
-TEST_F( ResourcesLibraryTest, CreatePatchWithChunking )
+TEST_F( ResourcesLibraryTest, ApplyPatchWithChunkingMultiThreaded )
 {
-	// Previous ResourceGroup
-	CarbonResources::ResourceGroup resourceGroupPrevious;
+	// Load the patch file
+	CarbonResources::PatchResourceGroup patchResourceGroup;
 
 	CarbonResources::ResourceGroupImportFromFileParams importParamsPrevious;
 
-	importParamsPrevious.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_previous.txt" );
+	importParamsPrevious.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/PatchResourceGroup_previousBuild_latestBuild.yaml" );
 
-    importParamsPrevious.callbackSettings.statusCallback = StatusUpdate;
+	importParamsPrevious.callbackSettings.statusCallback = StatusUpdate;
 
-	EXPECT_EQ( resourceGroupPrevious.ImportFromFile( importParamsPrevious ).type, CarbonResources::ResultType::SUCCESS );
+	EXPECT_EQ( patchResourceGroup.ImportFromFile( importParamsPrevious ).type, CarbonResources::ResultType::SUCCESS );
 
-    EXPECT_TRUE( StatusIsValid() );
+	EXPECT_TRUE( StatusIsValid() );
 
-	// Latest ResourceGroup
-	CarbonResources::ResourceGroup resourceGroupLatest;
 
-	CarbonResources::ResourceGroupImportFromFileParams importParamsLatest;
+	// Apply the patch with a worker per resource
+	CarbonResources::PatchApplyParams patchApplyParams;
 
-	importParamsLatest.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_next.txt" );
+	patchApplyParams.nextBuildResourcesSourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
 
-    importParamsLatest.callbackSettings.statusCallback = StatusUpdate;
+	patchApplyParams.nextBuildResourcesSourceSettings.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/" ) };
 
-	EXPECT_EQ( resourceGroupLatest.ImportFromFile( importParamsLatest ).type, CarbonResources::ResultType::SUCCESS );
+	patchApplyParams.patchBinarySourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_CDN;
 
-    EXPECT_TRUE( StatusIsValid() );
+	patchApplyParams.patchBinarySourceSettings.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/LocalCDNPatches/" ) };
 
+	patchApplyParams.resourcesToPatchSourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
 
+	patchApplyParams.resourcesToPatchSourceSettings.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources/" ) };
 
-	// Create a patch from the subtraction index
-	CarbonResources::PatchCreateParams patchCreateParams;
+	patchApplyParams.resourcesToPatchDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
 
-	patchCreateParams.resourceGroupRelativePath = "ResourceGroup_previousBuild_latestBuild.yaml";
+	patchApplyParams.resourcesToPatchDestinationSettings.basePath = "ApplyPatchWithChunkingMultiThreadedOut";
 
-	patchCreateParams.resourceGroupPatchRelativePath = "PatchResourceGroup_previousBuild_latestBuild.yaml";
+	patchApplyParams.temporaryFilePath = "tempFileMultiThreaded.resource";
 
-	patchCreateParams.resourceSourceSettingsPrevious.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+	patchApplyParams.threadCount = 4;
 
-	patchCreateParams.resourceSourceSettingsPrevious.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources" ) };
+	patchApplyParams.callbackSettings.statusCallback = StatusUpdate;
 
-	patchCreateParams.resourceSourceSettingsNext.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+	EXPECT_EQ( patchResourceGroup.Apply( patchApplyParams ).type, CarbonResources::ResultType::SUCCESS );
 
-	patchCreateParams.resourceSourceSettingsNext.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources" ) };
+	EXPECT_TRUE( StatusIsValid() );
+
+	std::filesystem::path nextIntroMovie = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/introMovie.txt" );
+	EXPECT_TRUE( FilesMatch( nextIntroMovie, patchApplyParams.resourcesToPatchDestinationSettings.basePath / "introMovie.txt" ) );
+	std::filesystem::path nextIntroMoviePrefixed = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/introMoviePrefixed.txt" );
+	EXPECT_TRUE( FilesMatch( nextIntroMoviePrefixed, patchApplyParams.resourcesToPatchDestinationSettings.basePath / "introMoviePrefixed.txt" ) );
+	std::filesystem::path nextTestResource = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/testresource2.txt" );
+	EXPECT_TRUE( FilesMatch( nextTestResource, patchApplyParams.resourcesToPatchDestinationSettings.basePath / "testresource2.txt" ) );
+
+	// Worker temporary files are removed once patching completes
+	for( int i = 0; i < 4; i++ )
+	{
+		std::filesystem::path workerTemporaryFilePath = patchApplyParams.temporaryFilePath;
+		workerTemporaryFilePath += "." + std::to_string( i );
+		EXPECT_FALSE( std::filesystem::exists( workerTemporaryFilePath ) );
+	}
+}
+
+TEST_F( ResourcesLibraryTest, ApplyPatchWithChunkingDirectlyToDestinationInPlace )
+{
+	// Resources are patched where they are, so work on a copy of the previous build
+	std::filesystem::path resourcesPath = "ApplyPatchDirectlyToDestinationOut";
+
+	std::filesystem::remove_all( resourcesPath );
+
+	std::filesystem::copy( GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources" ), resourcesPath, std::filesystem::copy_options::recursive );
+
+	// Load the patch file
+	CarbonResources::PatchResourceGroup patchResourceGroup;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPrevious;
+
+	importParamsPrevious.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/PatchResourceGroup_previousBuild_latestBuild.yaml" );
+
+	importParamsPrevious.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( patchResourceGroup.ImportFromFile( importParamsPrevious ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( StatusIsValid() );
+
+
+	// Apply the patch over the resources being patched
+	CarbonResources::PatchApplyParams patchApplyParams;
+
+	patchApplyParams.nextBuildResourcesSourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchApplyParams.nextBuildResourcesSourceSettings.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/" ) };
+
+	patchApplyParams.patchBinarySourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_CDN;
+
+	patchApplyParams.patchBinarySourceSettings.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/LocalCDNPatches/" ) };
+
+	patchApplyParams.resourcesToPatchSourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchApplyParams.resourcesToPatchSourceSettings.basePaths = { resourcesPath };
+
+	patchApplyParams.resourcesToPatchDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	patchApplyParams.resourcesToPatchDestinationSettings.basePath = resourcesPath;
+
+	// The temporary file is placed under a regular file so it cannot be created, apply only succeeds if it is never used
+	std::filesystem::path temporaryFileParent = "tempFileDirectlyToDestinationParent.txt";
+
+	ASSERT_TRUE( ResourceTools::SaveFile( temporaryFileParent, "Not a directory" ) );
+
+	patchApplyParams.temporaryFilePath = temporaryFileParent / "tempFile.resource";
+
+	patchApplyParams.applyDirectlyToDestination = true;
+
+	patchApplyParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( patchResourceGroup.Apply( patchApplyParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( StatusIsValid() );
+
+	std::filesystem::path nextIntroMovie = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/introMovie.txt" );
+	EXPECT_TRUE( FilesMatch( nextIntroMovie, resourcesPath / "introMovie.txt" ) );
+	std::filesystem::path nextIntroMoviePrefixed = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/introMoviePrefixed.txt" );
+	EXPECT_TRUE( FilesMatch( nextIntroMoviePrefixed, resourcesPath / "introMoviePrefixed.txt" ) );
+	std::filesystem::path nextTestResource = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/testresource2.txt" );
+	EXPECT_TRUE( FilesMatch( nextTestResource, resourcesPath / "testresource2.txt" ) );
+
+	// No partially patched resources remain
+	for( const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator( resourcesPath ) )
+	{
+		EXPECT_NE( entry.path().extension(), ".patching" );
+	}
+}
+
+TEST_F( ResourcesLibraryTest, ApplyPatchInPlaceToTailModifiedResources )
+{
+	std::filesystem::path basePath = "ApplyPatchInPlace";
+
+	std::filesystem::remove_all( basePath );
+
+	std::filesystem::path previousPath = basePath / "PreviousBuildResources";
+
+	std::filesystem::path nextPath = basePath / "NextBuildResources";
+
+	std::mt19937 generator( 23 );
+
+	std::uniform_int_distribution<int> distribution( 0, 255 );
+
+	std::string archive( 64 * 1024, '\0' );
+
+	std::generate( archive.begin(), archive.end(), [&]() { return static_cast<char>( distribution( generator ) ); } );
+
+	// An archive that grows, one changed near its end and one that shrinks
+	std::string grown = archive + "Appended data";
+
+	std::string tailModified = archive;
+
+	tailModified.replace( tailModified.size() - 100, 5, "Patch" );
+
+	std::string shrunk = archive.substr( 0, archive.size() - 3000 );
+
+	ASSERT_TRUE( ResourceTools::SaveFile( previousPath / "grown.dat", archive ) );
+	ASSERT_TRUE( ResourceTools::SaveFile( previousPath / "tailModified.dat", archive ) );
+	ASSERT_TRUE( ResourceTools::SaveFile( previousPath / "shrunk.dat", archive ) );
+
+	ASSERT_TRUE( ResourceTools::SaveFile( nextPath / "grown.dat", grown ) );
+	ASSERT_TRUE( ResourceTools::SaveFile( nextPath / "tailModified.dat", tailModified ) );
+	ASSERT_TRUE( ResourceTools::SaveFile( nextPath / "shrunk.dat", shrunk ) );
+
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroup resourceGroupNext;
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = previousPath;
+
+	ASSERT_EQ( resourceGroupPrevious.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	createResourceGroupParams.directory = nextPath;
+
+	ASSERT_EQ( resourceGroupNext.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::PatchCreateParams patchCreateParams;
+
+	patchCreateParams.resourceSourceSettingsPrevious.basePaths = { previousPath };
+
+	patchCreateParams.resourceSourceSettingsNext.basePaths = { nextPath };
 
 	patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
 
-	patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = "SharedCache";
+	patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = basePath / "SharedCache";
 
 	patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
 
-	patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = "resPath";
-
-	patchCreateParams.patchFileRelativePathPrefix = "Patches/Patch1";
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = basePath / "resPath";
 
 	patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
 
-	patchCreateParams.maxInputFileChunkSize = 500;
+	patchCreateParams.maxInputFileChunkSize = 1024;
 
-    patchCreateParams.callbackSettings.statusCallback = StatusUpdate;
+	ASSERT_EQ( resourceGroupNext.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
 
-	EXPECT_EQ( resourceGroupLatest.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+	CarbonResources::PatchResourceGroup patchResourceGroup;
 
-    EXPECT_TRUE( StatusIsValid() );
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPatch;
 
-	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "PatchWithInputChunk/PatchResourceGroup_previousBuild_latestBuild.yaml" );
-	EXPECT_TRUE( FilesMatch( goldFile, patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / "PatchResourceGroup_previousBuild_latestBuild.yaml" ) );
+	importParamsPatch.filename = patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / patchCreateParams.resourceGroupPatchRelativePath;
 
-	std::filesystem::path goldDirectory = GetTestFileFileAbsolutePath( "PatchWithInputChunk/LocalCDNPatches" );
-	EXPECT_TRUE( DirectoryIsSubset( goldDirectory, patchCreateParams.resourcePatchBinaryDestinationSettings.basePath ) );
+	ASSERT_EQ( patchResourceGroup.ImportFromFile( importParamsPatch ).type, CarbonResources::ResultType::SUCCESS );
+
+	// Workers report through the same status settings as the calling thread
+	for( unsigned int threadCount : { 1u, 3u } )
+	{
+		std::filesystem::path resourcesPath = basePath / ( "Resources" + std::to_string( threadCount ) );
+
+		// Resources are patched where they are, so work on a copy of the previous build
+		std::filesystem::copy( previousPath, resourcesPath, std::filesystem::copy_options::recursive );
+
+		// Simulates an apply of grown.dat interrupted after its tail was overwritten, it must be rolled back before patching
+		{
+			ResourceTools::FileRollbackJournal journal( resourcesPath / "grown.dat" );
+
+			ASSERT_TRUE( journal.Begin( { { archive.size() - 1024, 1024 } } ) );
+
+			std::filesystem::resize_file( resourcesPath / "grown.dat", archive.size() - 512 );
+		}
+
+		CarbonResources::PatchApplyParams patchApplyParams;
+
+		patchApplyParams.nextBuildResourcesSourceSettings.basePaths = { nextPath };
+
+		patchApplyParams.patchBinarySourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_CDN;
+
+		patchApplyParams.patchBinarySourceSettings.basePaths = { patchCreateParams.resourcePatchBinaryDestinationSettings.basePath };
+
+		patchApplyParams.resourcesToPatchSourceSettings.basePaths = { resourcesPath };
+
+		patchApplyParams.resourcesToPatchDestinationSettings.basePath = resourcesPath;
+
+		// The temporary file cannot be created under a regular file, so a resource that is rebuilt fails the apply
+		std::filesystem::path temporaryFileParent = basePath / "tempFileParent.txt";
+
+		ASSERT_TRUE( ResourceTools::SaveFile( temporaryFileParent, "Not a directory" ) );
+
+		patchApplyParams.temporaryFilePath = temporaryFileParent / "tempFile.resource";
+
+		patchApplyParams.applyInPlace = true;
+
+		patchApplyParams.threadCount = threadCount;
+
+		std::vector<std::string> statusMessages;
+
+		patchApplyParams.callbackSettings.statusCallback = [&statusMessages]( CarbonResources::StatusProgressType, float, float, float, unsigned int, const std::string& info ) {
+			statusMessages.push_back( info );
+		};
+
+		ASSERT_EQ( patchResourceGroup.Apply( patchApplyParams ).type, CarbonResources::ResultType::SUCCESS );
+
+		for( const char* name : { "grown.dat", "tailModified.dat", "shrunk.dat" } )
+		{
+			EXPECT_TRUE( FilesMatch( nextPath / name, resourcesPath / name ) );
+
+			EXPECT_FALSE( std::filesystem::exists( ResourceTools::FileRollbackJournal::GetJournalPath( resourcesPath / name ) ) );
+
+			EXPECT_NE( std::find( statusMessages.begin(), statusMessages.end(), std::string( "Patched in place: " ) + name ), statusMessages.end() );
+		}
+
+		auto fallbackMessage = std::find_if( statusMessages.begin(), statusMessages.end(), []( const std::string& message ) { return message.find( "Could not patch in place" ) != std::string::npos; } );
+
+		EXPECT_EQ( fallbackMessage, statusMessages.end() );
+	}
 }
 
-TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectory )
+TEST_F( ResourcesLibraryTest, CreateAndApplyPatchWithIdenticalPatchData )
 {
-	CarbonResources::ResourceGroup resourceGroup;
+	std::filesystem::path basePath = "IdenticalPatchData";
+
+	std::filesystem::remove_all( basePath );
+
+	std::filesystem::path previousPath = basePath / "PreviousBuildResources";
+
+	std::filesystem::path nextPath = basePath / "NextBuildResources";
+
+	std::filesystem::path resourcesPath = basePath / "Resources";
+
+	std::mt19937 generator( 25 );
+
+	std::uniform_int_distribution<int> distribution( 0, 255 );
+
+	std::string library( 8 * 1024, '\0' );
+
+	std::generate( library.begin(), library.end(), [&]() { return static_cast<char>( distribution( generator ) ); } );
+
+	std::string editedLibrary = library;
+
+	editedLibrary.replace( 100, 5, "Patch" );
+
+	// Copies of the same library receive the same edit, producing identical patches
+	std::vector<std::string> names = { "a/library.dll", "b/library.dll", "c/library.dll", "d/library.dll" };
+
+	for( const std::string& name : names )
+	{
+		ASSERT_TRUE( ResourceTools::SaveFile( previousPath / name, library ) );
+
+		ASSERT_TRUE( ResourceTools::SaveFile( nextPath / name, editedLibrary ) );
+	}
+
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroup resourceGroupNext;
 
 	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
 
-	createResourceGroupParams.directory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+	createResourceGroupParams.directory = previousPath;
 
-    createResourceGroupParams.callbackSettings.statusCallback = StatusUpdate;
+	ASSERT_EQ( resourceGroupPrevious.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
 
-	EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+	createResourceGroupParams.directory = nextPath;
 
-    EXPECT_TRUE( StatusIsValid() );
+	ASSERT_EQ( resourceGroupNext.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
 
-	CarbonResources::ResourceGroupExportToFileParams exportParams;
+	CarbonResources::PatchCreateParams patchCreateParams;
 
-	exportParams.filename = "ResourceGroups/ResourceGroup.yaml";
+	patchCreateParams.resourceSourceSettingsPrevious.basePaths = { previousPath };
 
-    exportParams.callbackSettings.statusCallback = StatusUpdate;
+	patchCreateParams.resourceSourceSettingsNext.basePaths = { nextPath };
 
-	EXPECT_EQ( resourceGroup.ExportToFile( exportParams ).type, CarbonResources::ResultType::SUCCESS );
+	patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
 
-    EXPECT_TRUE( StatusIsValid() );
+	patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = basePath / "SharedCache";
 
-#if _WIN64
-	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupWindows.yaml" );
-#elif __APPLE__
-	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupMacOS.yaml" );
-#else
-#error Unsupported platform
-#endif
-	EXPECT_TRUE( FilesMatch( goldFile, exportParams.filename ) );
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = basePath / "resPath";
+
+	patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
+
+	patchCreateParams.maxInputFileChunkSize = 1024;
+
+	std::vector<std::string> statusMessages;
+
+	patchCreateParams.callbackSettings.statusCallback = [&statusMessages]( CarbonResources::StatusProgressType, float, float, float, unsigned int, const std::string& info ) {
+		statusMessages.push_back( info );
+	};
+
+	ASSERT_EQ( resourceGroupNext.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	// Only the first library's patch is stored, the others share it
+	// The ResourceGroup the patch is based on is stored alongside it
+	size_t storedFileCount = 0;
+
+	for( const auto& entry : std::filesystem::recursive_directory_iterator( patchCreateParams.resourcePatchBinaryDestinationSettings.basePath ) )
+	{
+		if( entry.is_regular_file() )
+		{
+			storedFileCount++;
+		}
+	}
+
+	EXPECT_EQ( storedFileCount, 2 );
+
+	auto sharedMessage = std::find_if( statusMessages.begin(), statusMessages.end(), []( const std::string& message ) { return message.find( "Shared stored data between 3 patches" ) != std::string::npos; } );
+
+	EXPECT_NE( sharedMessage, statusMessages.end() );
+
+	CarbonResources::PatchResourceGroup patchResourceGroup;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPatch;
+
+	importParamsPatch.filename = patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / patchCreateParams.resourceGroupPatchRelativePath;
+
+	ASSERT_EQ( patchResourceGroup.ImportFromFile( importParamsPatch ).type, CarbonResources::ResultType::SUCCESS );
+
+	std::filesystem::copy( previousPath, resourcesPath, std::filesystem::copy_options::recursive );
+
+	CarbonResources::PatchApplyParams patchApplyParams;
+
+	patchApplyParams.nextBuildResourcesSourceSettings.basePaths = { nextPath };
+
+	patchApplyParams.patchBinarySourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_CDN;
+
+	patchApplyParams.patchBinarySourceSettings.basePaths = { patchCreateParams.resourcePatchBinaryDestinationSettings.basePath };
+
+	patchApplyParams.resourcesToPatchSourceSettings.basePaths = { resourcesPath };
+
+	patchApplyParams.resourcesToPatchDestinationSettings.basePath = resourcesPath;
+
+	patchApplyParams.temporaryFilePath = basePath / "tempFile.resource";
+
+	ASSERT_EQ( patchResourceGroup.Apply( patchApplyParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	for( const std::string& name : names )
+	{
+		EXPECT_TRUE( FilesMatch( nextPath / name, resourcesPath / name ) );
+	}
+}
+
+TEST_F( ResourcesLibraryTest, ApplyPatchToLargeResourceGroup )
+{
+	// Every resource changes so there are as many patches as resources
+	const int resourceCount = 5000;
+
+	std::filesystem::path basePath = "LargeResourceGroupPatch";
+
+	std::filesystem::remove_all( basePath );
+
+	std::filesystem::path previousPath = basePath / "PreviousBuildResources";
+
+	std::filesystem::path nextPath = basePath / "NextBuildResources";
+
+	for( int i = 0; i < resourceCount; i++ )
+	{
+		std::filesystem::path relativePath = std::filesystem::path( "folder" + std::to_string( i % 50 ) ) / ( "resource" + std::to_string( i ) + ".txt" );
+
+		ASSERT_TRUE( ResourceTools::SaveFile( previousPath / relativePath, "Previous contents of resource " + std::to_string( i ) ) );
+
+		ASSERT_TRUE( ResourceTools::SaveFile( nextPath / relativePath, "Next contents of resource " + std::to_string( i ) ) );
+	}
+
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroup resourceGroupNext;
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.threadCount = 0;
+
+	createResourceGroupParams.directory = previousPath;
+
+	ASSERT_EQ( resourceGroupPrevious.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	createResourceGroupParams.directory = nextPath;
+
+	ASSERT_EQ( resourceGroupNext.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::PatchCreateParams patchCreateParams;
+
+	patchCreateParams.resourceSourceSettingsPrevious.basePaths = { previousPath };
+
+	patchCreateParams.resourceSourceSettingsNext.basePaths = { nextPath };
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = basePath / "SharedCache";
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = basePath / "resPath";
+
+	patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
+
+	patchCreateParams.maxInputFileChunkSize = 1024;
+
+	patchCreateParams.threadCount = 0;
+
+	ASSERT_EQ( resourceGroupNext.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::PatchResourceGroup patchResourceGroup;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPatch;
+
+	importParamsPatch.filename = patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / patchCreateParams.resourceGroupPatchRelativePath;
+
+	ASSERT_EQ( patchResourceGroup.ImportFromFile( importParamsPatch ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::PatchApplyParams patchApplyParams;
+
+	patchApplyParams.nextBuildResourcesSourceSettings.basePaths = { nextPath };
+
+	patchApplyParams.patchBinarySourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_CDN;
+
+	patchApplyParams.patchBinarySourceSettings.basePaths = { patchCreateParams.resourcePatchBinaryDestinationSettings.basePath };
+
+	patchApplyParams.resourcesToPatchSourceSettings.basePaths = { previousPath };
+
+	patchApplyParams.resourcesToPatchDestinationSettings.basePath = basePath / "ApplyPatchOut";
+
+	patchApplyParams.temporaryFilePath = basePath / "tempFile.resource";
+
+	ASSERT_EQ( patchResourceGroup.Apply( patchApplyParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	for( int i = 0; i < resourceCount; i += 499 )
+	{
+		std::filesystem::path relativePath = std::filesystem::path( "folder" + std::to_string( i % 50 ) ) / ( "resource" + std::to_string( i ) + ".txt" );
+
+		EXPECT_TRUE( FilesMatch( nextPath / relativePath, patchApplyParams.resourcesToPatchDestinationSettings.basePath / relativePath ) );
+	}
+}
+
+TEST_F( ResourcesLibraryTest, CreatePatchWithChunking )
+{
+	// Previous ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPrevious;
+
+	importParamsPrevious.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_previous.txt" );
+
+    importParamsPrevious.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupPrevious.ImportFromFile( importParamsPrevious ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Latest ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupLatest;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsLatest;
+
+	importParamsLatest.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_next.txt" );
+
+    importParamsLatest.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.ImportFromFile( importParamsLatest ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+
+
+	// Create a patch from the subtraction index
+	CarbonResources::PatchCreateParams patchCreateParams;
+
+	patchCreateParams.resourceGroupRelativePath = "ResourceGroup_previousBuild_latestBuild.yaml";
+
+	patchCreateParams.resourceGroupPatchRelativePath = "PatchResourceGroup_previousBuild_latestBuild.yaml";
+
+	patchCreateParams.resourceSourceSettingsPrevious.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourceSourceSettingsPrevious.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources" ) };
+
+	patchCreateParams.resourceSourceSettingsNext.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourceSourceSettingsNext.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources" ) };
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = "SharedCache";
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = "resPath";
+
+	patchCreateParams.patchFileRelativePathPrefix = "Patches/Patch1";
+
+	patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
+
+	patchCreateParams.maxInputFileChunkSize = 500;
+
+    patchCreateParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "PatchWithInputChunk/PatchResourceGroup_previousBuild_latestBuild.yaml" );
+	EXPECT_TRUE( FilesMatch( goldFile, patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / "PatchResourceGroup_previousBuild_latestBuild.yaml" ) );
+
+	std::filesystem::path goldDirectory = GetTestFileFileAbsolutePath( "PatchWithInputChunk/LocalCDNPatches" );
+	EXPECT_TRUE( DirectoryIsSubset( goldDirectory, patchCreateParams.resourcePatchBinaryDestinationSettings.basePath ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreatePatchWithChunkingMultiThreaded )
+{
+	// Previous ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPrevious;
+
+	importParamsPrevious.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_previous.txt" );
+
+    importParamsPrevious.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupPrevious.ImportFromFile( importParamsPrevious ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Latest ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupLatest;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsLatest;
+
+	importParamsLatest.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_next.txt" );
+
+    importParamsLatest.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.ImportFromFile( importParamsLatest ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+
+
+	// With no budget workers wait for each earlier resource to be committed before handing over patch data
+	for( uintmax_t pendingPatchDataMemoryBudget : { CarbonResources::PatchCreateParams().pendingPatchDataMemoryBudget, uintmax_t( 0 ) } )
+	{
+		// Create a patch from the subtraction index
+		CarbonResources::PatchCreateParams patchCreateParams;
+
+		patchCreateParams.resourceGroupRelativePath = "ResourceGroup_previousBuild_latestBuild.yaml";
+
+		patchCreateParams.resourceGroupPatchRelativePath = "PatchResourceGroup_previousBuild_latestBuild.yaml";
+
+		patchCreateParams.resourceSourceSettingsPrevious.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+		patchCreateParams.resourceSourceSettingsPrevious.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources" ) };
+
+		patchCreateParams.resourceSourceSettingsNext.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+		patchCreateParams.resourceSourceSettingsNext.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources" ) };
+
+		patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
+
+		patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = "SharedCacheMultiThreaded" + std::to_string( pendingPatchDataMemoryBudget );
+
+		patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+		patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = "resPathMultiThreaded" + std::to_string( pendingPatchDataMemoryBudget );
+
+		patchCreateParams.patchFileRelativePathPrefix = "Patches/Patch1";
+
+		patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
+
+		patchCreateParams.maxInputFileChunkSize = 500;
+
+		patchCreateParams.threadCount = 4;
+
+		patchCreateParams.pendingPatchDataMemoryBudget = pendingPatchDataMemoryBudget;
+
+		patchCreateParams.callbackSettings.statusCallback = StatusUpdate;
+
+		EXPECT_EQ( resourceGroupLatest.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+
+		EXPECT_TRUE( StatusIsValid() );
+
+		// Output must match single threaded output exactly, including patch ids and order
+		std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "PatchWithInputChunk/PatchResourceGroup_previousBuild_latestBuild.yaml" );
+		EXPECT_TRUE( FilesMatch( goldFile, patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / "PatchResourceGroup_previousBuild_latestBuild.yaml" ) );
+
+		std::filesystem::path goldDirectory = GetTestFileFileAbsolutePath( "PatchWithInputChunk/LocalCDNPatches" );
+		EXPECT_TRUE( DirectoryIsSubset( goldDirectory, patchCreateParams.resourcePatchBinaryDestinationSettings.basePath ) );
+	}
+}
+
+TEST_F( ResourcesLibraryTest, CreatePatchWithChunkingPipelinedDiffs )
+{
+	// Previous ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPrevious;
+
+	importParamsPrevious.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_previous.txt" );
+
+    importParamsPrevious.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupPrevious.ImportFromFile( importParamsPrevious ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Latest ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupLatest;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsLatest;
+
+	importParamsLatest.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_next.txt" );
+
+    importParamsLatest.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.ImportFromFile( importParamsLatest ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+
+
+	// Create a patch from the subtraction index
+	CarbonResources::PatchCreateParams patchCreateParams;
+
+	patchCreateParams.resourceGroupRelativePath = "ResourceGroup_previousBuild_latestBuild.yaml";
+
+	patchCreateParams.resourceGroupPatchRelativePath = "PatchResourceGroup_previousBuild_latestBuild.yaml";
+
+	patchCreateParams.resourceSourceSettingsPrevious.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourceSourceSettingsPrevious.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources" ) };
+
+	patchCreateParams.resourceSourceSettingsNext.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourceSourceSettingsNext.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources" ) };
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = "SharedCachePipelinedDiffs";
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = "resPathPipelinedDiffs";
+
+	patchCreateParams.patchFileRelativePathPrefix = "Patches/Patch1";
+
+	patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
+
+	patchCreateParams.maxInputFileChunkSize = 500;
+
+	patchCreateParams.diffThreadCount = 4;
+
+    patchCreateParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Output must match output with diffs created serially exactly, including patch ids and order
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "PatchWithInputChunk/PatchResourceGroup_previousBuild_latestBuild.yaml" );
+	EXPECT_TRUE( FilesMatch( goldFile, patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / "PatchResourceGroup_previousBuild_latestBuild.yaml" ) );
+
+	std::filesystem::path goldDirectory = GetTestFileFileAbsolutePath( "PatchWithInputChunk/LocalCDNPatches" );
+	EXPECT_TRUE( DirectoryIsSubset( goldDirectory, patchCreateParams.resourcePatchBinaryDestinationSettings.basePath ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateAndApplyPatchWithContentDefinedChunking )
+{
+	// Previous ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPrevious;
+
+	importParamsPrevious.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_previous.txt" );
+
+    importParamsPrevious.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupPrevious.ImportFromFile( importParamsPrevious ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Latest ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupLatest;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsLatest;
+
+	importParamsLatest.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_next.txt" );
+
+    importParamsLatest.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.ImportFromFile( importParamsLatest ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Create a patch using content defined chunking
+	CarbonResources::PatchCreateParams patchCreateParams;
+
+	patchCreateParams.resourceGroupRelativePath = "ResourceGroup_contentDefined.yaml";
+
+	patchCreateParams.resourceGroupPatchRelativePath = "PatchResourceGroup_contentDefined.yaml";
+
+	patchCreateParams.resourceSourceSettingsPrevious.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourceSourceSettingsPrevious.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources" ) };
+
+	patchCreateParams.resourceSourceSettingsNext.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourceSourceSettingsNext.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources" ) };
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = "SharedCacheContentDefined";
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = "resPathContentDefined";
+
+	patchCreateParams.patchFileRelativePathPrefix = "Patches/PatchContentDefined";
+
+	patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
+
+	patchCreateParams.maxInputFileChunkSize = 500;
+
+	patchCreateParams.chunkingMode = CarbonResources::PatchChunkingMode::CONTENT_DEFINED;
+
+	patchCreateParams.contentDefinedChunkMinimumSize = 64;
+
+	patchCreateParams.contentDefinedChunkAverageSize = 256;
+
+	patchCreateParams.contentDefinedChunkMaximumSize = 1024;
+
+    patchCreateParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Load the created patch file
+	CarbonResources::PatchResourceGroup patchResourceGroup;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPatch;
+
+	importParamsPatch.filename = patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / patchCreateParams.resourceGroupPatchRelativePath;
+
+    importParamsPatch.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( patchResourceGroup.ImportFromFile( importParamsPatch ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Apply the patch, the format is the same as for fixed size chunking
+	CarbonResources::PatchApplyParams patchApplyParams;
+
+	patchApplyParams.nextBuildResourcesSourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchApplyParams.nextBuildResourcesSourceSettings.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/" ) };
+
+	patchApplyParams.patchBinarySourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_CDN;
+
+	patchApplyParams.patchBinarySourceSettings.basePaths = { patchCreateParams.resourcePatchBinaryDestinationSettings.basePath };
+
+	patchApplyParams.resourcesToPatchSourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchApplyParams.resourcesToPatchSourceSettings.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources/" ) };
+
+	patchApplyParams.resourcesToPatchDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	patchApplyParams.resourcesToPatchDestinationSettings.basePath = "ApplyPatchWithContentDefinedChunkingOut";
+
+	patchApplyParams.temporaryFilePath = "tempFileContentDefined.resource";
+
+    patchApplyParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( patchResourceGroup.Apply( patchApplyParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	std::filesystem::path nextIntroMovie = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/introMovie.txt" );
+	EXPECT_TRUE( FilesMatch( nextIntroMovie, patchApplyParams.resourcesToPatchDestinationSettings.basePath / "introMovie.txt" ) );
+	std::filesystem::path nextIntroMoviePrefixed = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/introMoviePrefixed.txt" );
+	EXPECT_TRUE( FilesMatch( nextIntroMoviePrefixed, patchApplyParams.resourcesToPatchDestinationSettings.basePath / "introMoviePrefixed.txt" ) );
+	std::filesystem::path nextTestResource = GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources/testresource2.txt" );
+	EXPECT_TRUE( FilesMatch( nextTestResource, patchApplyParams.resourcesToPatchDestinationSettings.basePath / "testresource2.txt" ) );
+}
+
+TEST_F( ResourcesLibraryTest, ContentDefinedChunkingStoresLessPatchDataThanFixedSize )
+{
+	std::filesystem::path basePath = "ContentDefinedAgainstFixedSize";
+
+	std::filesystem::remove_all( basePath );
+
+	std::filesystem::path previousPath = basePath / "PreviousBuildResources";
+
+	std::filesystem::path nextPath = basePath / "NextBuildResources";
+
+	std::mt19937 generator( 27 );
+
+	// Text like data so that unmatched chunks diff against shifted previous data
+	auto generateText = [&generator]( size_t size ) {
+		const char* words[] = { "ship", "station", "module", "cargo", "pilot", "warp", "gate", "asteroid", "drone", "shield" };
+		std::string text;
+		while( text.size() < size )
+		{
+			text += words[generator() % 10];
+			text += ' ';
+			text += std::to_string( generator() % 1000 );
+			text += generator() % 8 == 0 ? '\n' : ' ';
+		}
+		text.resize( size );
+		return text;
+	};
+
+	std::string previous = generateText( 512 * 1024 );
+
+	// Insertions and removals shift all data after them
+	std::string next = previous;
+
+	for( int edit = 0; edit < 10; ++edit )
+	{
+		size_t position = generator() % next.size();
+
+		size_t length = 1 + generator() % 200;
+
+		if( edit % 2 == 0 )
+		{
+			next.insert( position, generateText( length ) );
+		}
+		else
+		{
+			next.erase( position, length );
+		}
+	}
+
+	ASSERT_TRUE( ResourceTools::SaveFile( previousPath / "resource.txt", previous ) );
+
+	ASSERT_TRUE( ResourceTools::SaveFile( nextPath / "resource.txt", next ) );
+
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroup resourceGroupNext;
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = previousPath;
+
+	ASSERT_EQ( resourceGroupPrevious.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	createResourceGroupParams.directory = nextPath;
+
+	ASSERT_EQ( resourceGroupNext.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	uintmax_t fixedSizePatchSize = 0;
+
+	uintmax_t contentDefinedPatchSize = 0;
+
+	for( CarbonResources::PatchChunkingMode chunkingMode : { CarbonResources::PatchChunkingMode::FIXED_SIZE, CarbonResources::PatchChunkingMode::CONTENT_DEFINED } )
+	{
+		bool fixedSize = chunkingMode == CarbonResources::PatchChunkingMode::FIXED_SIZE;
+
+		std::filesystem::path modePath = basePath / ( fixedSize ? "FixedSize" : "ContentDefined" );
+
+		uintmax_t& storedPatchSize = fixedSize ? fixedSizePatchSize : contentDefinedPatchSize;
+
+		CarbonResources::PatchCreateParams patchCreateParams;
+
+		patchCreateParams.resourceSourceSettingsPrevious.basePaths = { previousPath };
+
+		patchCreateParams.resourceSourceSettingsNext.basePaths = { nextPath };
+
+		patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
+
+		patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = modePath / "SharedCache";
+
+		patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+		patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = modePath / "resPath";
+
+		patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
+
+		patchCreateParams.maxInputFileChunkSize = 16 * 1024;
+
+		// Content defined chunks average a quarter of the fixed chunk size, unmatched chunks are still combined up to the fixed size
+		patchCreateParams.chunkingMode = chunkingMode;
+
+		patchCreateParams.contentDefinedChunkMinimumSize = 1024;
+
+		patchCreateParams.contentDefinedChunkAverageSize = 4 * 1024;
+
+		patchCreateParams.contentDefinedChunkMaximumSize = 16 * 1024;
+
+		ASSERT_EQ( resourceGroupNext.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+
+		for( const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator( patchCreateParams.resourcePatchBinaryDestinationSettings.basePath ) )
+		{
+			if( entry.is_regular_file() )
+			{
+				storedPatchSize += entry.file_size();
+			}
+		}
+
+		CarbonResources::PatchResourceGroup patchResourceGroup;
+
+		CarbonResources::ResourceGroupImportFromFileParams importParamsPatch;
+
+		importParamsPatch.filename = patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath / patchCreateParams.resourceGroupPatchRelativePath;
+
+		ASSERT_EQ( patchResourceGroup.ImportFromFile( importParamsPatch ).type, CarbonResources::ResultType::SUCCESS );
+
+		CarbonResources::PatchApplyParams patchApplyParams;
+
+		patchApplyParams.nextBuildResourcesSourceSettings.basePaths = { nextPath };
+
+		patchApplyParams.patchBinarySourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_CDN;
+
+		patchApplyParams.patchBinarySourceSettings.basePaths = { patchCreateParams.resourcePatchBinaryDestinationSettings.basePath };
+
+		patchApplyParams.resourcesToPatchSourceSettings.basePaths = { previousPath };
+
+		patchApplyParams.resourcesToPatchDestinationSettings.basePath = modePath / "Resources";
+
+		patchApplyParams.temporaryFilePath = modePath / "tempFile.resource";
+
+		ASSERT_EQ( patchResourceGroup.Apply( patchApplyParams ).type, CarbonResources::ResultType::SUCCESS );
+
+		EXPECT_TRUE( FilesMatch( nextPath / "resource.txt", patchApplyParams.resourcesToPatchDestinationSettings.basePath / "resource.txt" ) );
+	}
+
+	// Chunks after an edit line up with the previous data again sooner, so less of the next resource is stored in patches
+	EXPECT_LT( contentDefinedPatchSize, fixedSizePatchSize );
+}
+
+TEST_F( ResourcesLibraryTest, CreatePatchWithInvalidContentDefinedChunkSizes )
+{
+	// Previous ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupPrevious;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsPrevious;
+
+	importParamsPrevious.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_previous.txt" );
+
+    importParamsPrevious.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupPrevious.ImportFromFile( importParamsPrevious ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Latest ResourceGroup
+	CarbonResources::ResourceGroup resourceGroupLatest;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParamsLatest;
+
+	importParamsLatest.filename = GetTestFileFileAbsolutePath( "PatchWithInputChunk/resfileindexShort_build_next.txt" );
+
+    importParamsLatest.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.ImportFromFile( importParamsLatest ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Create a patch using content defined chunking
+	CarbonResources::PatchCreateParams patchCreateParams;
+
+	patchCreateParams.resourceGroupRelativePath = "ResourceGroup_contentDefined.yaml";
+
+	patchCreateParams.resourceGroupPatchRelativePath = "PatchResourceGroup_contentDefined.yaml";
+
+	patchCreateParams.resourceSourceSettingsPrevious.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourceSourceSettingsPrevious.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/PreviousBuildResources" ) };
+
+	patchCreateParams.resourceSourceSettingsNext.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourceSourceSettingsNext.basePaths = { GetTestFileFileAbsolutePath( "PatchWithInputChunk/NextBuildResources" ) };
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
+
+	patchCreateParams.resourcePatchBinaryDestinationSettings.basePath = "SharedCacheContentDefined";
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	patchCreateParams.resourcePatchResourceGroupDestinationSettings.basePath = "resPathContentDefined";
+
+	patchCreateParams.patchFileRelativePathPrefix = "Patches/PatchContentDefined";
+
+	patchCreateParams.previousResourceGroup = &resourceGroupPrevious;
+
+	patchCreateParams.maxInputFileChunkSize = 500;
+
+	patchCreateParams.chunkingMode = CarbonResources::PatchChunkingMode::CONTENT_DEFINED;
+
+	// Minimum larger than average
+	patchCreateParams.contentDefinedChunkMinimumSize = 4096;
+
+	patchCreateParams.contentDefinedChunkAverageSize = 1024;
+
+	patchCreateParams.contentDefinedChunkMaximumSize = 8192;
+
+    patchCreateParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroupLatest.CreatePatch( patchCreateParams ).type, CarbonResources::ResultType::INVALID_CHUNK_SIZE );
+
+    EXPECT_TRUE( StatusIsValid() );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectory )
+{
+	CarbonResources::ResourceGroup resourceGroup;
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+
+    createResourceGroupParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	CarbonResources::ResourceGroupExportToFileParams exportParams;
+
+	exportParams.filename = "ResourceGroups/ResourceGroup.yaml";
+
+    exportParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroup.ExportToFile( exportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+#if _WIN64
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupWindows.yaml" );
+#elif __APPLE__
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupMacOS.yaml" );
+#else
+#error Unsupported platform
+#endif
+	EXPECT_TRUE( FilesMatch( goldFile, exportParams.filename ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryMultiThreaded )
+{
+	CarbonResources::ResourceGroup resourceGroup;
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+
+	createResourceGroupParams.threadCount = 4;
+
+    createResourceGroupParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	CarbonResources::ResourceGroupExportToFileParams exportParams;
+
+	exportParams.filename = "ResourceGroups/ResourceGroup.yaml";
+
+    exportParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroup.ExportToFile( exportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	// Output must match single threaded output exactly, including resource order
+#if _WIN64
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupWindows.yaml" );
+#elif __APPLE__
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupMacOS.yaml" );
+#else
+#error Unsupported platform
+#endif
+	EXPECT_TRUE( FilesMatch( goldFile, exportParams.filename ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryWithFingerprintCache )
+{
+	std::filesystem::path fingerprintCachePath = "FingerprintCache/FileFingerprintCache.txt";
+
+	std::filesystem::remove_all( fingerprintCachePath.parent_path() );
+
+#if _WIN64
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupWindows.yaml" );
+#elif __APPLE__
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupMacOS.yaml" );
+#else
+#error Unsupported platform
+#endif
+
+	// First pass populates the cache, second pass is served from it
+	for( int i = 0; i < 2; i++ )
+	{
+		CarbonResources::ResourceGroup resourceGroup;
+
+		CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+		createResourceGroupParams.directory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+
+		createResourceGroupParams.fileFingerprintCachePath = fingerprintCachePath;
+
+		createResourceGroupParams.callbackSettings.statusCallback = StatusUpdate;
+
+		EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+		EXPECT_TRUE( StatusIsValid() );
+
+		EXPECT_TRUE( FileExists( fingerprintCachePath ) );
+
+		CarbonResources::ResourceGroupExportToFileParams exportParams;
+
+		exportParams.filename = "ResourceGroups/ResourceGroup.yaml";
+
+		EXPECT_EQ( resourceGroup.ExportToFile( exportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+		EXPECT_TRUE( FilesMatch( goldFile, exportParams.filename ) );
+	}
+
+	// Entries are saved sorted by relative path, which is the last field of each line after the header and timestamp
+	std::string cacheData;
+
+	ASSERT_TRUE( ResourceTools::GetLocalFileData( fingerprintCachePath, cacheData ) );
+
+	std::stringstream cacheStream( cacheData );
+
+	std::string line;
+
+	std::vector<std::string> relativePaths;
+
+	for( int lineIndex = 0; std::getline( cacheStream, line ); lineIndex++ )
+	{
+		if( lineIndex < 2 || line.empty() )
+		{
+			continue;
+		}
+
+		size_t fieldStart = 0;
+
+		for( int field = 0; field < 6; field++ )
+		{
+			fieldStart = line.find( ',', fieldStart ) + 1;
+		}
+
+		relativePaths.push_back( line.substr( fieldStart ) );
+	}
+
+	EXPECT_FALSE( relativePaths.empty() );
+
+	EXPECT_TRUE( std::is_sorted( relativePaths.begin(), relativePaths.end() ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryWithFingerprintCacheRacyModification )
+{
+	std::filesystem::path fingerprintCachePath = "FingerprintCacheRacy/FileFingerprintCache.txt";
+
+	std::filesystem::path resourceDirectory = "FingerprintCacheRacy/ResourceFiles";
+
+	std::filesystem::remove_all( fingerprintCachePath.parent_path() );
+
+	std::filesystem::create_directories( resourceDirectory );
+
+	std::filesystem::path filePath = resourceDirectory / "FileA.txt";
+
+	EXPECT_TRUE( ResourceTools::SaveFile( filePath, "Original contents" ) );
+
+	// Modification time after the cache starts to be populated, as for a file written in the same clock tick it is fingerprinted
+	std::filesystem::file_time_type modificationTime = std::filesystem::file_time_type::clock::now() + std::chrono::hours( 1 );
+
+	std::filesystem::last_write_time( filePath, modificationTime );
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = resourceDirectory;
+
+	createResourceGroupParams.fileFingerprintCachePath = fingerprintCachePath;
+
+	{
+		CarbonResources::ResourceGroup resourceGroup;
+
+		EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+	}
+
+	// Same size and modification time, only the contents differ
+	EXPECT_TRUE( ResourceTools::SaveFile( filePath, "Modified contents" ) );
+
+	std::filesystem::last_write_time( filePath, modificationTime );
+
+	CarbonResources::ResourceGroup cachedResourceGroup;
+
+	EXPECT_EQ( cachedResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams cachedExportParams;
+
+	cachedExportParams.filename = "FingerprintCacheRacy/ResourceGroupCached.yaml";
+
+	EXPECT_EQ( cachedResourceGroup.ExportToFile( cachedExportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	// Compare against a group created without the cache
+	createResourceGroupParams.fileFingerprintCachePath = "";
+
+	CarbonResources::ResourceGroup uncachedResourceGroup;
+
+	EXPECT_EQ( uncachedResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams uncachedExportParams;
+
+	uncachedExportParams.filename = "FingerprintCacheRacy/ResourceGroupUncached.yaml";
+
+	EXPECT_EQ( uncachedResourceGroup.ExportToFile( uncachedExportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( FilesMatch( cachedExportParams.filename, uncachedExportParams.filename ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryWithFingerprintCacheMismatch )
+{
+	std::filesystem::path fingerprintCachePath = "FingerprintCacheMismatch/FileFingerprintCache.txt";
+
+	std::filesystem::path resourceDirectory = "FingerprintCacheMismatch/ResourceFiles";
+
+	std::filesystem::remove_all( fingerprintCachePath.parent_path() );
+
+	std::filesystem::create_directories( resourceDirectory );
+
+	std::filesystem::copy( GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" ), resourceDirectory, std::filesystem::copy_options::recursive );
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = resourceDirectory;
+
+	createResourceGroupParams.fileFingerprintCachePath = fingerprintCachePath;
+
+	{
+		CarbonResources::ResourceGroup resourceGroup;
+
+		EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+	}
+
+	// Change a file after the cache has been populated
+	EXPECT_TRUE( ResourceTools::SaveFile( resourceDirectory / "FileA.txt", "Modified after fingerprint cache was created" ) );
+
+	CarbonResources::ResourceGroup cachedResourceGroup;
+
+	EXPECT_EQ( cachedResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams cachedExportParams;
+
+	cachedExportParams.filename = "FingerprintCacheMismatch/ResourceGroupCached.yaml";
+
+	EXPECT_EQ( cachedResourceGroup.ExportToFile( cachedExportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	// Compare against a group created without the cache
+	createResourceGroupParams.fileFingerprintCachePath = "";
+
+	CarbonResources::ResourceGroup uncachedResourceGroup;
+
+	EXPECT_EQ( uncachedResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams uncachedExportParams;
+
+	uncachedExportParams.filename = "FingerprintCacheMismatch/ResourceGroupUncached.yaml";
+
+	EXPECT_EQ( uncachedResourceGroup.ExportToFile( uncachedExportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( FilesMatch( cachedExportParams.filename, uncachedExportParams.filename ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryWithPreviousResourceGroup )
+{
+	CarbonResources::ResourceGroup previousResourceGroup;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParams;
+
+	importParams.filename = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupWindows.yaml" );
+
+	EXPECT_EQ( previousResourceGroup.ImportFromFile( importParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroup resourceGroup;
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+
+	createResourceGroupParams.previousResourceGroup = &previousResourceGroup;
+
+	createResourceGroupParams.previousResourceGroupTrustPolicy = CarbonResources::PreviousResourceGroupTrustPolicy::SIZE;
+
+    createResourceGroupParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+    EXPECT_TRUE( StatusIsValid() );
+
+	CarbonResources::ResourceGroupExportToFileParams exportParams;
+
+	exportParams.filename = "ResourceGroups/ResourceGroup.yaml";
+
+	EXPECT_EQ( resourceGroup.ExportToFile( exportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+#if _WIN64
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupWindows.yaml" );
+#elif __APPLE__
+	std::filesystem::path goldFile = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceGroupMacOS.yaml" );
+#else
+#error Unsupported platform
+#endif
+	EXPECT_TRUE( FilesMatch( goldFile, exportParams.filename ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryPreviousResourceGroupTrustPolicy )
+{
+	std::filesystem::path resourceDirectory = "PreviousResourceGroupTrust/ResourceFiles";
+
+	std::filesystem::remove_all( resourceDirectory.parent_path() );
+
+	std::filesystem::create_directories( resourceDirectory );
+
+	std::filesystem::copy( GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" ), resourceDirectory, std::filesystem::copy_options::recursive );
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = resourceDirectory;
+
+	CarbonResources::ResourceGroup previousResourceGroup;
+
+	EXPECT_EQ( previousResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams previousExportParams;
+
+	previousExportParams.filename = "PreviousResourceGroupTrust/ResourceGroupPrevious.yaml";
+
+	EXPECT_EQ( previousResourceGroup.ExportToFile( previousExportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	// Previous group is treated as created after every file was last written
+	std::filesystem::file_time_type previousResourceGroupTimestamp = std::filesystem::file_time_type::min();
+
+	for( const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator( resourceDirectory ) )
+	{
+		if( entry.is_regular_file() )
+		{
+			previousResourceGroupTimestamp = std::max( previousResourceGroupTimestamp, entry.last_write_time() );
+		}
+	}
+
+	previousResourceGroupTimestamp += std::chrono::seconds( 1 );
+
+	// Change contents of a file without changing its size, modified in the same clock tick as the previous group was created
+	std::filesystem::path modifiedFile = resourceDirectory / "FileA.txt";
+
+	std::string data;
+
+	EXPECT_TRUE( ResourceTools::GetLocalFileData( modifiedFile, data ) );
+
+	std::reverse( data.begin(), data.end() );
+
+	data.front() = data.front() == 'X' ? 'Y' : 'X';
+
+	EXPECT_TRUE( ResourceTools::SaveFile( modifiedFile, data ) );
+
+	std::filesystem::last_write_time( modifiedFile, previousResourceGroupTimestamp );
+
+	createResourceGroupParams.previousResourceGroup = &previousResourceGroup;
+
+	createResourceGroupParams.previousResourceGroupTimestamp = previousResourceGroupTimestamp;
+
+	// Size only trusts the stale entry
+	createResourceGroupParams.previousResourceGroupTrustPolicy = CarbonResources::PreviousResourceGroupTrustPolicy::SIZE;
+
+	CarbonResources::ResourceGroup sizeTrustedResourceGroup;
+
+	EXPECT_EQ( sizeTrustedResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams sizeTrustedExportParams;
+
+	sizeTrustedExportParams.filename = "PreviousResourceGroupTrust/ResourceGroupSizeTrusted.yaml";
+
+	EXPECT_EQ( sizeTrustedResourceGroup.ExportToFile( sizeTrustedExportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( FilesMatch( previousExportParams.filename, sizeTrustedExportParams.filename ) );
+
+	// Size and modification time detects the change
+	createResourceGroupParams.previousResourceGroupTrustPolicy = CarbonResources::PreviousResourceGroupTrustPolicy::SIZE_AND_MODIFICATION_TIME;
+
+	CarbonResources::ResourceGroup timeTrustedResourceGroup;
+
+	EXPECT_EQ( timeTrustedResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams timeTrustedExportParams;
+
+	timeTrustedExportParams.filename = "PreviousResourceGroupTrust/ResourceGroupTimeTrusted.yaml";
+
+	EXPECT_EQ( timeTrustedResourceGroup.ExportToFile( timeTrustedExportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	createResourceGroupParams.previousResourceGroup = nullptr;
+
+	CarbonResources::ResourceGroup fullResourceGroup;
+
+	EXPECT_EQ( fullResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams fullExportParams;
+
+	fullExportParams.filename = "PreviousResourceGroupTrust/ResourceGroupFull.yaml";
+
+	EXPECT_EQ( fullResourceGroup.ExportToFile( fullExportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( FilesMatch( fullExportParams.filename, timeTrustedExportParams.filename ) );
+
+	EXPECT_FALSE( FilesMatch( previousExportParams.filename, timeTrustedExportParams.filename ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryBlake2bChecksums )
+{
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+
+	createResourceGroupParams.checksumAlgorithm = CarbonResources::ChecksumAlgorithm::BLAKE2B_128;
+
+	createResourceGroupParams.callbackSettings.statusCallback = StatusUpdate;
+
+	// Checksum algorithm cannot be recorded in 0.x documents
+	CarbonResources::ResourceGroup legacyResourceGroup;
+
+	EXPECT_EQ( legacyResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::CHECKSUM_ALGORITHM_UNSUPPORTED_BY_DOCUMENT_VERSION );
+
+	createResourceGroupParams.outputDocumentVersion = CarbonResources::Version{ 1, 0, 0 };
+
+	CarbonResources::ResourceGroup resourceGroup;
+
+	EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( StatusIsValid() );
+
+	CarbonResources::ResourceGroupExportToFileParams exportParams;
+
+	exportParams.filename = "Blake2bChecksums/ResourceGroup.yaml";
+
+	EXPECT_EQ( resourceGroup.ExportToFile( exportParams ).type, CarbonResources::ResultType::CHECKSUM_ALGORITHM_UNSUPPORTED_BY_DOCUMENT_VERSION );
+
+	exportParams.outputDocumentVersion = CarbonResources::Version{ 1, 0, 0 };
+
+	EXPECT_EQ( resourceGroup.ExportToFile( exportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	std::string exportedData;
+
+	EXPECT_TRUE( ResourceTools::GetLocalFileData( exportParams.filename, exportedData ) );
+
+	EXPECT_NE( exportedData.find( "ChecksumAlgorithm: BLAKE2B_128" ), std::string::npos );
+
+	std::string fileChecksum;
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( createResourceGroupParams.directory / "FileA.txt", ResourceTools::ChecksumAlgorithm::BLAKE2B_128, fileChecksum ) );
+
+	EXPECT_NE( exportedData.find( fileChecksum ), std::string::npos );
+
+	// Algorithm survives a round trip
+	CarbonResources::ResourceGroup importedResourceGroup;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParams;
+
+	importParams.filename = exportParams.filename;
+
+	EXPECT_EQ( importedResourceGroup.ImportFromFile( importParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams reexportParams;
+
+	reexportParams.filename = "Blake2bChecksums/ResourceGroupReexported.yaml";
+
+	reexportParams.outputDocumentVersion = CarbonResources::Version{ 1, 0, 0 };
+
+	EXPECT_EQ( importedResourceGroup.ExportToFile( reexportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( FilesMatch( exportParams.filename, reexportParams.filename ) );
+
+	// Checksums of different algorithms are not comparable
+	CarbonResources::ResourceGroup md5ResourceGroup;
+
+	createResourceGroupParams.checksumAlgorithm = CarbonResources::ChecksumAlgorithm::MD5;
+
+	EXPECT_EQ( md5ResourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	std::vector<std::filesystem::path> additions;
+
+	std::vector<std::filesystem::path> subtractions;
+
+	CarbonResources::ResourceGroupDiffAgainstGroupParams diffParams;
+
+	diffParams.resourceGroupToDiffAgainst = &md5ResourceGroup;
+
+	diffParams.additions = &additions;
+
+	diffParams.subtractions = &subtractions;
+
+	EXPECT_EQ( resourceGroup.DiffAgainstGroup( diffParams ).type, CarbonResources::ResultType::CHECKSUM_ALGORITHM_MISMATCH );
+}
+
+TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryXxh3Checksums )
+{
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+
+	createResourceGroupParams.checksumAlgorithm = CarbonResources::ChecksumAlgorithm::XXH3_128;
+
+	createResourceGroupParams.outputDocumentVersion = CarbonResources::Version{ 1, 0, 0 };
+
+	createResourceGroupParams.callbackSettings.statusCallback = StatusUpdate;
+
+	CarbonResources::ResourceGroup resourceGroup;
+
+	EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( StatusIsValid() );
+
+	CarbonResources::ResourceGroupExportToFileParams exportParams;
+
+	exportParams.filename = "Xxh3Checksums/ResourceGroup.yaml";
+
+	exportParams.outputDocumentVersion = CarbonResources::Version{ 1, 0, 0 };
+
+	EXPECT_EQ( resourceGroup.ExportToFile( exportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	std::string exportedData;
+
+	EXPECT_TRUE( ResourceTools::GetLocalFileData( exportParams.filename, exportedData ) );
+
+	EXPECT_NE( exportedData.find( "ChecksumAlgorithm: XXH3_128" ), std::string::npos );
+
+	std::string fileChecksum;
+
+	EXPECT_TRUE( ResourceTools::GenerateChecksum( createResourceGroupParams.directory / "FileA.txt", ResourceTools::ChecksumAlgorithm::XXH3_128, fileChecksum ) );
+
+	EXPECT_NE( exportedData.find( fileChecksum ), std::string::npos );
+
+	// Algorithm survives a round trip
+	CarbonResources::ResourceGroup importedResourceGroup;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParams;
+
+	importParams.filename = exportParams.filename;
+
+	EXPECT_EQ( importedResourceGroup.ImportFromFile( importParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::ResourceGroupExportToFileParams reexportParams;
+
+	reexportParams.filename = "Xxh3Checksums/ResourceGroupReexported.yaml";
+
+	reexportParams.outputDocumentVersion = CarbonResources::Version{ 1, 0, 0 };
+
+	EXPECT_EQ( importedResourceGroup.ExportToFile( reexportParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( FilesMatch( exportParams.filename, reexportParams.filename ) );
+}
+
+TEST_F( ResourcesLibraryTest, CreateAndUnpackBundleBlake2bChecksums )
+{
+	CarbonResources::ResourceGroup resourceGroup;
+
+	CarbonResources::CreateResourceGroupFromDirectoryParams createResourceGroupParams;
+
+	createResourceGroupParams.directory = GetTestFileFileAbsolutePath( "CreateResourceFiles/ResourceFiles" );
+
+	createResourceGroupParams.checksumAlgorithm = CarbonResources::ChecksumAlgorithm::BLAKE2B_128;
+
+	createResourceGroupParams.outputDocumentVersion = CarbonResources::Version{ 1, 0, 0 };
+
+	EXPECT_EQ( resourceGroup.CreateFromDirectory( createResourceGroupParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::BundleCreateParams bundleCreateParams;
+
+	bundleCreateParams.resourceSourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_RELATIVE;
+
+	bundleCreateParams.resourceSourceSettings.basePaths = { createResourceGroupParams.directory };
+
+	bundleCreateParams.chunkDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_CDN;
+
+	bundleCreateParams.chunkDestinationSettings.basePath = "Blake2bBundleOut/Chunks";
+
+	bundleCreateParams.resourceBundleResourceGroupDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	bundleCreateParams.resourceBundleResourceGroupDestinationSettings.basePath = "Blake2bBundleOut";
+
+	bundleCreateParams.chunkSize = 1000;
+
+	bundleCreateParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( resourceGroup.CreateBundle( bundleCreateParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( StatusIsValid() );
+
+	CarbonResources::BundleResourceGroup bundleResourceGroup;
+
+	CarbonResources::ResourceGroupImportFromFileParams importParams;
+
+	importParams.filename = bundleCreateParams.resourceBundleResourceGroupDestinationSettings.basePath / bundleCreateParams.resourceGroupBundleRelativePath;
+
+	EXPECT_EQ( bundleResourceGroup.ImportFromFile( importParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	CarbonResources::BundleUnpackParams bundleUnpackParams;
+
+	bundleUnpackParams.chunkSourceSettings.sourceType = CarbonResources::ResourceSourceType::LOCAL_CDN;
+
+	bundleUnpackParams.chunkSourceSettings.basePaths = { bundleCreateParams.chunkDestinationSettings.basePath };
+
+	bundleUnpackParams.resourceDestinationSettings.destinationType = CarbonResources::ResourceDestinationType::LOCAL_RELATIVE;
+
+	bundleUnpackParams.resourceDestinationSettings.basePath = "Blake2bBundleUnpackOut/";
+
+	bundleUnpackParams.callbackSettings.statusCallback = StatusUpdate;
+
+	EXPECT_EQ( bundleResourceGroup.Unpack( bundleUnpackParams ).type, CarbonResources::ResultType::SUCCESS );
+
+	EXPECT_TRUE( StatusIsValid() );
+
+	EXPECT_TRUE( DirectoryIsSubset( createResourceGroupParams.directory, "Blake2bBundleUnpackOut" ) );
 }
 
 TEST_F( ResourcesLibraryTest, CreateResourceGroupFromDirectoryExportResources )
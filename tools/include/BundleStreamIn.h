@@ -5,6 +5,7 @@
 #define BundleStreamIn_H
 
 #include <string>
+#include <string_view>
 
 namespace ResourceTools
 {
@@ -29,16 +30,25 @@ public:
 
 	bool ReadBytes( size_t n, std::string& data );
 
+	// Reads n bytes without copying them, data views the internal cache and is valid until the stream is next read or written
+	bool ReadView( size_t n, std::string_view& data );
+
 	bool operator<<( const std::string& chunkData );
 
 	bool operator>>( GetFile& fileData );
 
 
 private:
+	// Consumes n bytes from the front of the cache and returns a view of them
+	std::string_view Consume( size_t n );
+
 	uintmax_t m_chunkSize;
 
+	// Data before the read position has been consumed, it is dropped when data is appended rather than on every read
 	std::string m_cache;
 
+	size_t m_readPosition;
+
 	uintmax_t m_dataReadOfCurrentFile;
 };
 
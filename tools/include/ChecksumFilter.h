@@ -0,0 +1,54 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef ChecksumFilter_H
+#define ChecksumFilter_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace ResourceTools
+{
+
+// Blocked Bloom filter over 32 bit checksums
+// All bits for a checksum are in one cache line sized block so a query touches a single line
+// MayContain never returns false for an inserted checksum and returns true for others at roughly the false positive rate
+class ChecksumFilter
+{
+public:
+	static constexpr double DEFAULT_FALSE_POSITIVE_RATE = 0.01;
+
+	ChecksumFilter();
+
+	// Clears the filter and sizes it to hold expectedCount checksums at falsePositiveRate
+	void Reset( size_t expectedCount, double falsePositiveRate = DEFAULT_FALSE_POSITIVE_RATE );
+
+	// Releases the filter, an empty filter contains nothing
+	void Clear();
+
+	bool IsEmpty() const;
+
+	void Insert( uint32_t checksum );
+
+	bool MayContain( uint32_t checksum ) const;
+
+	size_t GetSizeInBytes() const;
+
+private:
+	static constexpr size_t BLOCK_BITS = 512;
+
+	struct alignas( 64 ) Block
+	{
+		uint64_t words[BLOCK_BITS / 64] = {};
+	};
+
+	std::vector<Block> m_blocks;
+
+	uint32_t m_hashCount;
+};
+
+}
+
+#endif // ChecksumFilter_H
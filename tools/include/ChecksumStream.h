@@ -0,0 +1,57 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef ChecksumStream_H
+#define ChecksumStream_H
+
+#include <string>
+#include <string_view>
+
+#include "Digest128.h"
+
+namespace CryptoPP
+{
+class HashTransformation;
+}
+
+struct XXH3_state_s;
+
+namespace ResourceTools
+{
+
+enum class ChecksumAlgorithm
+{
+	MD5,
+	BLAKE2B_128,
+	XXH3_128
+};
+
+// Streams data into a checksum of the requested algorithm
+// All supported algorithms produce a 128 bit digest, retrieved either in binary form or as 32 lower case hex characters
+class ChecksumStream
+{
+public:
+	ChecksumStream( ChecksumAlgorithm algorithm );
+
+	~ChecksumStream();
+
+	bool FinishAndRetrieve( Digest128& checksum );
+
+	bool FinishAndRetrieve( std::string& checksum );
+
+	bool operator<<( std::string_view data );
+
+private:
+	void Finish();
+
+private:
+	CryptoPP::HashTransformation* m_hash;
+
+	// XXH3 is not a CryptoPP hash so is held separately, only one of the two is set
+	XXH3_state_s* m_xxh3State;
+};
+
+
+}
+
+#endif // ChecksumStream_H
@@ -2,34 +2,116 @@
 
 #pragma once
 
+#include <atomic>
 #include <filesystem>
 #include <map>
-#include <unordered_set>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "ChecksumFilter.h"
+#include "Digest128.h"
+#include "MemoryMappedFile.h"
+
 namespace ResourceTools
 {
 class ChunkIndex
 {
 public:
-	ChunkIndex( std::filesystem::path fileToIndex, uint32_t chunkSize, const std::filesystem::path& indexFolder );
+	// Accumulated over every FindMatchingChunk call for the lifetime of the index
+	// A collision is a candidate whose rolling checksum matched but whose data did not
+	struct MatchStatistics
+	{
+		uint64_t queries = 0;
+		uint64_t candidates = 0;
+		uint64_t collisions = 0;
+		uint64_t strongChecksumsGenerated = 0;
+		uint64_t strongChecksumCacheHits = 0;
+	};
+
+	// Written to indexFolder by Persist, lists the index files and what they were generated from
+	static constexpr const char* MANIFEST_FILENAME = "manifest";
+
+	// memoryBudget is the maximum number of bytes the index may occupy in memory
+	// Index is kept in memory when it fits within the budget, otherwise it is written to index files in indexFolder
+	// Strong checksums of candidate windows are memoised in whatever the index leaves of the budget
+	// A budget of 0 always writes index files and memoises nothing
+	// threadCount is the number of workers generating the index over segments of the file, 0 uses all hardware threads
+	ChunkIndex( std::filesystem::path fileToIndex, uint32_t chunkSize, const std::filesystem::path& indexFolder, uintmax_t memoryBudget = 0, unsigned int threadCount = 1 );
 	~ChunkIndex();
 	bool Generate();
 	bool FindChunkOffsets( uint32_t chunk, std::vector<size_t>& offsets );
-	bool FindMatchingChunk( const std::string& chunk, size_t& chunkOffset );
-	bool GenerateChecksumFilter( const std::filesystem::path& targetFile );
+	bool FindMatchingChunk( std::string_view chunk, size_t& chunkOffset );
+	// Only windows whose checksum may match a chunk of targetFile are indexed
+	// A higher falsePositiveRate makes the filter smaller at the cost of indexing more irrelevant windows
+	bool GenerateChecksumFilter( const std::filesystem::path& targetFile, double falsePositiveRate = ChecksumFilter::DEFAULT_FALSE_POSITIVE_RATE );
+	bool IsInMemory() const;
+
+	// Windows of the file passed or rejected by the checksum filter during Generate
+	// Both are 0 when no filter was generated
+	uint64_t GetFilterHitCount() const;
+	uint64_t GetFilterMissCount() const;
+
+	const MatchStatistics& GetMatchStatistics() const;
+
+	// Writes a manifest describing the generated index files to indexFolder and leaves the files in place on destruction
+	// Index must have been generated to disk
+	bool Persist();
+
+	// Maps the index files of a persisted index in directory instead of generating
+	// Fails if the index was persisted for a different chunk size or file size
+	bool Load( const std::filesystem::path& directory );
 
 private:
-	std::filesystem::path GenerateIndexPath();
-	bool Flush( std::vector<std::pair<uint32_t, uint32_t>>& index );
-	bool IsRelevant( uint32_t checksum );
+	// Slot in the open addressing in memory index, one per distinct checksum, unused slots have a count of 0
+	// Offsets for the checksum are m_inMemoryOffsets[first, first + count) in file order
+	struct InMemoryEntry
+	{
+		uint32_t checksum = 0;
+		uint32_t count = 0;
+		uint64_t first = 0;
+	};
+
+	// Sorted index file covering one segment of the file, offsets in the file are relative to baseOffset
+	struct IndexFile
+	{
+		std::filesystem::path path;
+		MemoryMappedFile mapping;
+		uint64_t baseOffset = 0;
+	};
+
+	std::filesystem::path GenerateIndexPath( size_t segment );
+	bool WriteIndexFile( size_t segment, uint64_t baseOffset, std::vector<std::pair<uint32_t, uint32_t>>& index );
+	bool IsRelevant( uint32_t checksum ) const;
+	void GenerateSegment( std::string_view data, uint64_t segmentStart, uint64_t segmentEnd, std::vector<uint32_t>& checksums, std::vector<std::pair<uint32_t, uint32_t>>& entries );
+	bool FitsInMemory( size_t entryCount ) const;
+	bool CanMemoiseSourceChecksum() const;
+	size_t FindInMemorySlot( uint32_t checksum ) const;
+	void BuildInMemoryIndex( const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& segmentEntries, uint64_t segmentWindows );
+	void FindChunkOffsetsInMemory( uint32_t chunk, std::vector<size_t>& offsets ) const;
+	bool GetSourceChecksum( size_t offset, size_t size, Digest128& checksum );
 
 	std::filesystem::path m_fileToIndex;
 	uint32_t m_chunkSize;
-	std::vector<std::filesystem::path> m_indexFiles;
-	size_t m_currentIndexFile;
+	// Index files stay mapped for the lifetime of the index, ordered by base offset once generated
+	std::vector<IndexFile> m_indexFiles;
+	std::mutex m_indexFilesMutex;
 	std::filesystem::path m_indexFolder;
-	std::unordered_set<uint32_t> m_checksumFilter;
+	ChecksumFilter m_checksumFilter;
+	std::atomic<uint64_t> m_filterHitCount;
+	std::atomic<uint64_t> m_filterMissCount;
+	uintmax_t m_memoryBudget;
+	unsigned int m_threadCount;
+	bool m_ownsIndexFiles;
+	bool m_inMemory;
+	std::vector<InMemoryEntry> m_inMemoryIndex;
+	std::vector<uint64_t> m_inMemoryOffsets;
+	// File being indexed, mapped on the first candidate so matches are verified without seeking
+	MemoryMappedFile m_source;
+	// Strong checksums of chunk sized windows keyed by offset, each window is hashed at most once while within the memory budget
+	std::unordered_map<size_t, Digest128> m_sourceChecksums;
+	MatchStatistics m_matchStatistics;
 };
 
 }
@@ -0,0 +1,44 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef ChunkIndexCache_H
+#define ChunkIndexCache_H
+
+#include <filesystem>
+#include <string>
+
+#include "ChunkIndex.h"
+#include "Digest128.h"
+
+namespace ResourceTools
+{
+
+// Persistent store of ChunkIndex files shared between runs and processes
+// Each entry is a directory in the cache folder holding a persisted index, named by its key
+// Entries are written to a staging directory and renamed into place so a partially written entry is never loaded
+// Least recently used entries are removed once the total size of the cache exceeds the maximum size
+class ChunkIndexCache
+{
+public:
+	ChunkIndexCache( std::filesystem::path cacheFolder, uintmax_t maximumSize );
+
+	// Key identifying the index of a file by its content and the chunk size it was indexed with
+	static std::string CreateKey( const Digest128& checksum, uint32_t chunkSize );
+
+	// Loads the entry for key into index, returns false if there is no usable entry
+	bool Load( const std::string& key, ChunkIndex& index );
+
+	// Generates an unfiltered index of fileToIndex, stores it under key and loads it into index
+	bool Store( const std::string& key, const std::filesystem::path& fileToIndex, uint32_t chunkSize, unsigned int threadCount, ChunkIndex& index );
+
+private:
+	void Evict( const std::filesystem::path& keep );
+
+	std::filesystem::path m_cacheFolder;
+
+	uintmax_t m_maximumSize;
+};
+
+}
+
+#endif // ChunkIndexCache_H
@@ -28,6 +28,10 @@ public:
 
 	bool operator<<( const std::string& data ) override;
 
+protected:
+	// Spans are compressed like any other data, the file size counts the compressed bytes written
+	bool WriteSpan( std::string_view data ) override;
+
 private:
 	std::string m_compressionBuffer;
 
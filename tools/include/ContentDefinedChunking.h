@@ -0,0 +1,38 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef ContentDefinedChunking_H
+#define ContentDefinedChunking_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ResourceTools
+{
+
+// Limits on the size of content defined chunks
+// Average is the expected chunk size and is rounded down to a power of two
+struct ContentDefinedChunkSizes
+{
+	uint32_t minimum = 16 * 1024;
+
+	uint32_t average = 64 * 1024;
+
+	uint32_t maximum = 256 * 1024;
+};
+
+// Minimum must be non zero and no greater than average, which must be no greater than maximum
+bool IsValidContentDefinedChunkSizes( const ContentDefinedChunkSizes& sizes );
+
+// Length of the chunk at the start of data, found with a FastCDC gear hash using normalised chunking
+// Boundaries depend only on the bytes just before them so an edit only moves the boundaries around it
+size_t FindContentDefinedChunkLength( std::string_view data, const ContentDefinedChunkSizes& sizes );
+
+// Splits all of data into consecutive chunks, lengths receives the length of each chunk in order
+void GenerateContentDefinedChunks( std::string_view data, const ContentDefinedChunkSizes& sizes, std::vector<size_t>& lengths );
+
+}
+
+#endif // ContentDefinedChunking_H
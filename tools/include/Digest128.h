@@ -0,0 +1,43 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef Digest128_H
+#define Digest128_H
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ResourceTools
+{
+
+// Fixed size binary form of a 128 bit checksum
+// Used in place of hex strings wherever checksums are stored or compared
+// Conversion to hex is only required when writing to a document
+struct Digest128
+{
+	static constexpr size_t SIZE = 16;
+
+	std::array<uint8_t, SIZE> bytes{};
+
+	bool operator==( const Digest128& other ) const = default;
+
+	std::strong_ordering operator<=>( const Digest128& other ) const = default;
+
+	// Lower case hex, always 32 characters
+	std::string ToHexString() const;
+
+	// Accepts upper or lower case hex, must be exactly 32 characters
+	bool FromHexString( const std::string& hex );
+};
+
+struct Digest128Hash
+{
+	size_t operator()( const Digest128& digest ) const;
+};
+
+}
+
+#endif // Digest128_H
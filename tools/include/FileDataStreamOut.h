@@ -6,11 +6,16 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 #include <fstream>
 
+#include "MemoryMappedFile.h"
+
 namespace ResourceTools
 {
 
+class ChecksumStream;
+
 class FileDataStreamOut
 {
 public:
@@ -28,13 +33,27 @@ public:
 
 	size_t GetFileSize();
 
+	// Appends length bytes of source starting at sourceOffset without reading them into a buffer
+	// The bytes are added to checksum from a memory mapping of source, as operator<< callers do with their data
+	// The mapping is kept for further spans of the same source until Finish, source must not change in that time
+	bool CopySpan( const std::filesystem::path& source, uint64_t sourceOffset, uint64_t length, ChecksumStream& checksum );
+
+protected:
+	// Writes a span of the mapped source
+	virtual bool WriteSpan( std::string_view data );
 
 private:
 	bool m_writeInProgress;
 
 	std::ofstream m_outputStream;
 
+	std::filesystem::path m_path;
+
 	size_t m_fileSize;
+
+	MemoryMappedFile m_spanSource;
+
+	std::filesystem::path m_spanSourcePath;
 };
 
 
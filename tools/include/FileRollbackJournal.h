@@ -0,0 +1,52 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef FileRollbackJournal_H
+#define FileRollbackJournal_H
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace ResourceTools
+{
+
+// Keeps the original contents of ranges of a file that is about to be modified in place
+// The journal is written beside the file and only appears once it is complete and synced,
+// so a file with a journal beside it may be partially modified and is restored by RollBack
+class FileRollbackJournal
+{
+public:
+	struct Range
+	{
+		uint64_t offset;
+
+		uint64_t size;
+	};
+
+	FileRollbackJournal( const std::filesystem::path& filePath );
+
+	static std::filesystem::path GetJournalPath( const std::filesystem::path& filePath );
+
+	// True if a previous modification of the file did not complete
+	bool Exists() const;
+
+	// Saves the size of the file and the current contents of ranges, ranges past the end of the file are clamped to it
+	bool Begin( const std::vector<Range>& ranges );
+
+	// Restores the saved ranges and size, then removes the journal
+	// Safe to repeat if interrupted as the journal is only removed once the file is restored
+	bool RollBack();
+
+	// Syncs the modified file and removes the journal
+	bool Commit();
+
+private:
+	std::filesystem::path m_filePath;
+
+	std::filesystem::path m_journalPath;
+};
+
+}
+
+#endif // FileRollbackJournal_H
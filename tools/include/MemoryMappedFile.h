@@ -0,0 +1,60 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef MemoryMappedFile_H
+#define MemoryMappedFile_H
+
+#include <cstddef>
+#include <filesystem>
+
+
+namespace ResourceTools
+{
+
+// Read only view of a whole file mapped into memory
+// Mapping is held until Close is called or the object is destroyed
+// An empty file opens successfully with no data
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile();
+
+	~MemoryMappedFile();
+
+	MemoryMappedFile( const MemoryMappedFile& ) = delete;
+
+	MemoryMappedFile& operator=( const MemoryMappedFile& ) = delete;
+
+	MemoryMappedFile( MemoryMappedFile&& other ) noexcept;
+
+	MemoryMappedFile& operator=( MemoryMappedFile&& other ) noexcept;
+
+	bool Open( const std::filesystem::path& path );
+
+	void Close();
+
+	bool IsOpen() const;
+
+	const char* GetData() const;
+
+	size_t GetSize() const;
+
+private:
+	void MoveFrom( MemoryMappedFile& other );
+
+	const char* m_data;
+
+	size_t m_size;
+
+	bool m_open;
+
+#if _WIN64
+	void* m_fileHandle;
+
+	void* m_mappingHandle;
+#endif
+};
+
+}
+
+#endif // MemoryMappedFile_H
@@ -0,0 +1,88 @@
+// Copyright © 2025 CCP ehf.
+
+#pragma once
+#ifndef PatchPipeline_H
+#define PatchPipeline_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ResourceTools
+{
+
+// Creates patches between pairs of chunks on a pool of worker threads
+// Chunks are queued in the order their patches are needed and patch data is retrieved by that same order
+// A thread count of 0 uses the number of hardware threads, with one thread each patch is created on the calling thread as it is queued
+class PatchPipeline
+{
+public:
+	// Called on the thread that created the patch, returning false fails the pipeline
+	using PatchCreatedCallback = std::function<bool( const std::string& patchData )>;
+
+	// maximumQueued bounds the chunks queued or being patched, Queue blocks while it is reached
+	// 0 uses twice the number of threads
+	PatchPipeline( unsigned int threadCount, size_t maximumQueued = 0 );
+
+	// Abandons queued chunks and waits for patches in progress
+	~PatchPipeline();
+
+	// Queues a patch from previousData to nextData, returns false if the pipeline has failed
+	bool Queue( std::string previousData, std::string nextData, PatchCreatedCallback callback = nullptr );
+
+	// Waits for all queued patches, returns false if any patch or callback failed
+	bool Finish();
+
+	// Number of patches queued so far, the next patch queued has this index
+	size_t GetQueuedCount() const;
+
+	// Returns true once the patch queued at index and its callback have succeeded
+	bool IsPatchFinished( size_t index );
+
+	// Moves out the patch data of the patch queued at index, valid once the patch is finished
+	void TakePatchData( size_t index, std::string& patchData );
+
+private:
+	struct Task
+	{
+		std::string previousData;
+
+		std::string nextData;
+
+		PatchCreatedCallback callback;
+
+		std::string patchData;
+
+		bool finished = false;
+	};
+
+	static bool RunTask( Task& task );
+
+	void Worker();
+
+	std::deque<Task> m_tasks;
+
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_mutex;
+
+	std::condition_variable m_condition;
+
+	size_t m_maximumQueued;
+
+	size_t m_nextTask;
+
+	size_t m_inProgress;
+
+	bool m_failed;
+
+	bool m_stopping;
+};
+
+}
+
+#endif // PatchPipeline_H
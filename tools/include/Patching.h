@@ -6,6 +6,7 @@
 #define Patching_H
 
 #include <string>
+#include <string_view>
 #include <filesystem>
 #include <BundleStreamIn.h>
 
@@ -17,7 +18,7 @@ namespace ResourceTools
 
 class BundleStreamOut;
 
-bool ApplyPatch( const std::string& data, const std::string& patchData, std::string& out );
+bool ApplyPatch( std::string_view data, std::string_view patchData, std::string& out );
 
 bool CreatePatch( const std::string& data1, const std::string& data2, std::string& patchData );
 
@@ -27,6 +28,16 @@ bool ApplyPatchFile( fs::path target, fs::path patch );
 
 bool ApplyPatchFileChunked( fs::path target, BundleStreamIn& patch );
 
+// Output of the streamed apply functions is held in memory in pieces of at most this size
+constexpr size_t DEFAULT_PATCH_OUTPUT_BUFFER_SIZE = 1024 * 1024;
+
+// Applies a patch without holding the target or result in memory
+// The target is memory mapped, the result is written to a file beside it which is synced and renamed over the target once complete
+// On failure the target is left unchanged
+bool ApplyPatchFileStreamed( fs::path target, fs::path patch, size_t outputBufferSize = DEFAULT_PATCH_OUTPUT_BUFFER_SIZE );
+
+bool ApplyPatchFileChunkedStreamed( fs::path target, BundleStreamIn& patch, size_t outputBufferSize = DEFAULT_PATCH_OUTPUT_BUFFER_SIZE );
+
 class PatchData
 {
 public:
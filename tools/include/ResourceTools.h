@@ -7,7 +7,9 @@
 #include <filesystem>
 #include <list>
 #include <string>
+#include <string_view>
 
+#include "ChecksumStream.h"
 #include "Downloader.h"
 
 namespace CryptoPP
@@ -34,17 +36,50 @@ struct ChunkMatch
 	uint64_t length;
 };
 
+// Metadata used to detect if a file has changed without reading it
+struct FileFingerprint
+{
+	uintmax_t size = 0;
+	int64_t modificationTime = 0;
+	uint64_t fileId = 0;
+
+	bool operator==( const FileFingerprint& other ) const
+	{
+		return size == other.size && modificationTime == other.modificationTime && fileId == other.fileId;
+	}
+};
+
 bool GenerateMd5Checksum( const std::filesystem::path& path, std::string& checksum );
 
 bool GenerateMd5Checksum( const std::string& data, std::string& checksum );
 
+bool GenerateMd5Checksum( std::string_view data, std::string& checksum );
+
 bool Md5ChecksumMatches( const std::filesystem::path& path, std::string& checksum );
 
-bool GenerateFowlerNollVoChecksum( const std::string& input, std::string& checksum );
+bool GenerateChecksum( const std::filesystem::path& path, ChecksumAlgorithm algorithm, Digest128& checksum );
+
+bool GenerateChecksum( const std::filesystem::path& path, ChecksumAlgorithm algorithm, std::string& checksum );
+
+// std::string overloads are kept alongside std::string_view so that passing a std::string does not
+// become ambiguous with the std::filesystem::path overloads
+bool GenerateChecksum( const std::string& data, ChecksumAlgorithm algorithm, Digest128& checksum );
+
+bool GenerateChecksum( std::string_view data, ChecksumAlgorithm algorithm, Digest128& checksum );
+
+bool GenerateChecksum( const std::string& data, ChecksumAlgorithm algorithm, std::string& checksum );
+
+bool GenerateChecksum( std::string_view data, ChecksumAlgorithm algorithm, std::string& checksum );
+
+bool ChecksumMatches( const std::filesystem::path& path, ChecksumAlgorithm algorithm, const Digest128& checksum );
+
+bool ChecksumMatches( const std::filesystem::path& path, ChecksumAlgorithm algorithm, const std::string& checksum );
+
+bool GenerateFowlerNollVoChecksum( std::string_view input, std::string& checksum );
 
 std::list<ChunkMatch> FindMatchingChunks( const std::string& source, std::string& destination );
 
-bool FindMatchingChunk( const std::string& chunk, std::filesystem::path filePath, size_t& chunkOffset );
+bool FindMatchingChunk( std::string_view chunk, std::filesystem::path filePath, size_t& chunkOffset );
 
 size_t CountMatchingChunks( const std::filesystem::path& fileA, size_t offsetA, std::filesystem::path fileB, size_t offsetB, size_t chunkSize );
 
@@ -56,7 +91,12 @@ bool GZipUncompressData( const std::string& dataToUncompress, std::string& uncom
 
 bool SaveFile( const std::filesystem::path& path, const std::string& data );
 
+// Flushes a file to the storage device so it survives power loss, on POSIX platforms a directory can be synced to make renames within it durable
+bool SyncFile( const std::filesystem::path& path );
+
 unsigned int CalculateBinaryOperation( const std::filesystem::path& path );
+
+bool GetFileFingerprint( const std::filesystem::path& path, FileFingerprint& fingerprint );
 }
 
 #endif // ResourceTools_H
\ No newline at end of file
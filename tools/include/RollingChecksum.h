@@ -3,7 +3,8 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
+#include <string_view>
+#include <vector>
 
 namespace ResourceTools
 {
@@ -15,9 +16,14 @@ struct RollingChecksum
 };
 
 // Generate a weak checksum using the rsync algorithm https://rsync.samba.org/tech_report/node3.html
-RollingChecksum GenerateRollingAdlerChecksum( const std::string& input, uint32_t start, uint32_t end );
+RollingChecksum GenerateRollingAdlerChecksum( std::string_view input, uint32_t start, uint32_t end );
 
 // Generate a weak checksum using the rsync algorithm https://rsync.samba.org/tech_report/node3.html
-RollingChecksum GenerateRollingAdlerChecksum( const std::string& input, uint32_t start, uint32_t end, RollingChecksum previous );
+RollingChecksum GenerateRollingAdlerChecksum( std::string_view input, uint32_t start, uint32_t end, RollingChecksum previous );
+
+// Generate the weak checksum of every window of windowSize bytes which fits between start and end
+// checksums[i] is the checksum of the window beginning at start + i, identical to the results of the functions above
+// Returns the final window so that rolling may be continued, checksums is empty if no window fits
+RollingChecksum GenerateRollingAdlerChecksums( std::string_view input, uint32_t start, uint32_t end, uint32_t windowSize, std::vector<uint32_t>& checksums );
 
 }
\ No newline at end of file
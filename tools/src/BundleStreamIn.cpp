@@ -8,6 +8,7 @@ namespace ResourceTools
 
 BundleStreamIn::BundleStreamIn( uintmax_t chunkSize ) :
 	m_chunkSize( chunkSize ),
+	m_readPosition( 0 ),
 	m_dataReadOfCurrentFile( 0 )
 {
 }
@@ -18,11 +19,28 @@ BundleStreamIn ::~BundleStreamIn()
 
 uintmax_t BundleStreamIn::GetCacheSize()
 {
-	return m_cache.size();
+	return m_cache.size() - m_readPosition;
+}
+
+std::string_view BundleStreamIn::Consume( size_t n )
+{
+	std::string_view data = std::string_view( m_cache ).substr( m_readPosition, n );
+
+	m_readPosition += data.size();
+
+	return data;
 }
 
 bool BundleStreamIn::operator<<( const std::string& dataData )
 {
+	// Consumed data is only moved out once it is at least half the cache so each byte is moved at most once on average
+	if( m_readPosition > 0 && m_readPosition >= m_cache.size() - m_readPosition )
+	{
+		m_cache.erase( 0, m_readPosition );
+
+		m_readPosition = 0;
+	}
+
 	m_cache.append( dataData );
 
 	return true;
@@ -30,7 +48,7 @@ bool BundleStreamIn::operator<<( const std::string& dataData )
 
 bool BundleStreamIn::operator>>( GetFile& fileData )
 {
-	size_t cacheSize = m_cache.size();
+	size_t cacheSize = GetCacheSize();
 
 	if( cacheSize == 0 )
 	{
@@ -45,17 +63,13 @@ bool BundleStreamIn::operator>>( GetFile& fileData )
 	{
 		uintmax_t remainingDataSize = fileData.fileSize - m_dataReadOfCurrentFile;
 
-		dataRef = m_cache.substr( 0, remainingDataSize );
-
-		m_cache.erase( 0, remainingDataSize );
+		dataRef = Consume( remainingDataSize );
 
 		m_dataReadOfCurrentFile = 0;
 	}
 	else
 	{
-		dataRef = m_cache.substr( 0, m_chunkSize );
-
-		m_cache.erase( 0, m_chunkSize );
+		dataRef = Consume( m_chunkSize );
 
 		m_dataReadOfCurrentFile += m_chunkSize;
 	}
@@ -70,14 +84,26 @@ uintmax_t BundleStreamIn::GetChunkSize() const
 
 bool BundleStreamIn::ReadBytes( size_t n, std::string& out )
 {
-	if( m_cache.size() < n )
+	std::string_view data;
+
+	if( !ReadView( n, data ) )
 	{
 		return false;
 	}
 
-	out = m_cache.substr( 0, n );
+	out = data;
+
+	return true;
+}
+
+bool BundleStreamIn::ReadView( size_t n, std::string_view& data )
+{
+	if( GetCacheSize() < n )
+	{
+		return false;
+	}
 
-	m_cache.erase( 0, n );
+	data = Consume( n );
 
 	return true;
 }
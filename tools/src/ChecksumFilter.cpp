@@ -0,0 +1,172 @@
+// Copyright © 2025 CCP ehf.
+
+#include "ChecksumFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Bits per checksum are grown in these steps until the blocked false positive rate meets the target.
+constexpr double BITS_PER_CHECKSUM_STEP = 0.5;
+constexpr double MAXIMUM_BITS_PER_CHECKSUM = 64.0;
+
+constexpr uint32_t MAXIMUM_HASH_COUNT = 16;
+
+namespace ResourceTools
+{
+
+// splitmix64 finaliser, rolling checksums are poorly distributed in their low bits
+static uint64_t MixChecksum( uint64_t value )
+{
+	value ^= value >> 30;
+	value *= 0xBF58476D1CE4E5B9ull;
+	value ^= value >> 27;
+	value *= 0x94D049BB133111EBull;
+	value ^= value >> 31;
+	return value;
+}
+
+// Bit positions within a block, each drawn from fresh hash bits
+// Double hashing repeats too few patterns within a block to reach low false positive rates
+class BlockBits
+{
+public:
+	explicit BlockBits( uint64_t hash ) :
+		m_hash( hash ),
+		m_remaining( 0 )
+	{
+	}
+
+	uint32_t Next()
+	{
+		if( m_remaining < BLOCK_BIT_INDEX_BITS )
+		{
+			m_hash = MixChecksum( m_hash );
+			m_bits = m_hash;
+			m_remaining = 64;
+		}
+		auto bit = static_cast<uint32_t>( m_bits & ( ( uint64_t{ 1 } << BLOCK_BIT_INDEX_BITS ) - 1 ) );
+		m_bits >>= BLOCK_BIT_INDEX_BITS;
+		m_remaining -= BLOCK_BIT_INDEX_BITS;
+		return bit;
+	}
+
+private:
+	// Indexes the 512 bits of a block
+	static constexpr uint32_t BLOCK_BIT_INDEX_BITS = 9;
+
+	uint64_t m_hash;
+
+	uint64_t m_bits = 0;
+
+	uint32_t m_remaining;
+};
+
+static uint32_t OptimalHashCount( double bitsPerChecksum )
+{
+	auto hashCount = static_cast<uint32_t>( std::lround( bitsPerChecksum * std::log( 2.0 ) ) );
+	return std::clamp<uint32_t>( hashCount, 1, MAXIMUM_HASH_COUNT );
+}
+
+// Checksums per block are Poisson distributed, crowded blocks raise the rate above the unblocked formula
+static double BlockedFalsePositiveRate( double bitsPerChecksum, uint32_t hashCount, size_t blockBits )
+{
+	double meanPerBlock = blockBits / bitsPerChecksum;
+	double probability = std::exp( -meanPerBlock );
+	double rate = 0.0;
+	auto limit = static_cast<size_t>( meanPerBlock * 4 + 32 );
+	for( size_t count = 0; count < limit; ++count )
+	{
+		double bitSet = 1.0 - std::pow( 1.0 - 1.0 / blockBits, static_cast<double>( hashCount * count ) );
+		rate += probability * std::pow( bitSet, static_cast<double>( hashCount ) );
+		probability *= meanPerBlock / ( count + 1 );
+	}
+	return rate;
+}
+
+ChecksumFilter::ChecksumFilter() :
+	m_hashCount( 0 )
+{
+}
+
+void ChecksumFilter::Reset( size_t expectedCount, double falsePositiveRate /* = DEFAULT_FALSE_POSITIVE_RATE */ )
+{
+	falsePositiveRate = std::clamp( falsePositiveRate, 1e-9, 0.5 );
+
+	// Start from the unblocked optimum and grow until blocking no longer pushes the rate over the target
+	double bitsPerChecksum = -std::log( falsePositiveRate ) / ( std::log( 2.0 ) * std::log( 2.0 ) );
+	uint32_t hashCount = OptimalHashCount( bitsPerChecksum );
+	while( bitsPerChecksum < MAXIMUM_BITS_PER_CHECKSUM && BlockedFalsePositiveRate( bitsPerChecksum, hashCount, BLOCK_BITS ) > falsePositiveRate )
+	{
+		bitsPerChecksum += BITS_PER_CHECKSUM_STEP;
+		hashCount = OptimalHashCount( bitsPerChecksum );
+	}
+
+	double bits = std::max<double>( expectedCount, 1 ) * bitsPerChecksum;
+	auto blockCount = static_cast<size_t>( std::ceil( bits / BLOCK_BITS ) );
+
+	// Blocks are selected with a 32 bit multiply
+	blockCount = std::clamp<size_t>( blockCount, 1, UINT32_MAX );
+
+	m_blocks.assign( blockCount, Block{} );
+	m_hashCount = hashCount;
+}
+
+void ChecksumFilter::Clear()
+{
+	m_blocks.clear();
+	m_blocks.shrink_to_fit();
+	m_hashCount = 0;
+}
+
+bool ChecksumFilter::IsEmpty() const
+{
+	return m_blocks.empty();
+}
+
+void ChecksumFilter::Insert( uint32_t checksum )
+{
+	// Inserting into an unsized filter sizes it for a single checksum
+	if( m_blocks.empty() )
+	{
+		Reset( 1 );
+	}
+
+	uint64_t hash = MixChecksum( checksum );
+	Block& block = m_blocks[( ( hash >> 32 ) * m_blocks.size() ) >> 32];
+
+	BlockBits bits( hash );
+	for( uint32_t i = 0; i < m_hashCount; ++i )
+	{
+		uint32_t bit = bits.Next();
+		block.words[bit / 64] |= uint64_t{ 1 } << ( bit % 64 );
+	}
+}
+
+bool ChecksumFilter::MayContain( uint32_t checksum ) const
+{
+	if( m_blocks.empty() )
+	{
+		return false;
+	}
+
+	uint64_t hash = MixChecksum( checksum );
+	const Block& block = m_blocks[( ( hash >> 32 ) * m_blocks.size() ) >> 32];
+
+	BlockBits bits( hash );
+	for( uint32_t i = 0; i < m_hashCount; ++i )
+	{
+		uint32_t bit = bits.Next();
+		if( ( block.words[bit / 64] & ( uint64_t{ 1 } << ( bit % 64 ) ) ) == 0 )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+size_t ChecksumFilter::GetSizeInBytes() const
+{
+	return m_blocks.size() * sizeof( Block );
+}
+
+}
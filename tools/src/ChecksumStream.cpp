@@ -0,0 +1,121 @@
+// Copyright © 2025 CCP ehf.
+
+#include "ChecksumStream.h"
+
+#define CRYPTOPP_ENABLE_NAMESPACE_WEAK 1
+#include <cryptopp/blake2.h>
+#include <cryptopp/md5.h>
+
+#include <xxhash.h>
+
+#include <cstring>
+
+namespace ResourceTools
+{
+
+ChecksumStream::ChecksumStream( ChecksumAlgorithm algorithm ) :
+	m_hash( nullptr ),
+	m_xxh3State( nullptr )
+{
+	switch( algorithm )
+	{
+	case ChecksumAlgorithm::MD5:
+		m_hash = new CryptoPP::Weak1::MD5();
+		break;
+	case ChecksumAlgorithm::BLAKE2B_128:
+		m_hash = new CryptoPP::BLAKE2b( false, Digest128::SIZE );
+		break;
+	case ChecksumAlgorithm::XXH3_128:
+		m_xxh3State = XXH3_createState();
+		if( m_xxh3State && XXH3_128bits_reset( m_xxh3State ) != XXH_OK )
+		{
+			Finish();
+		}
+		break;
+	}
+}
+
+ChecksumStream::~ChecksumStream()
+{
+	Finish();
+}
+
+void ChecksumStream::Finish()
+{
+	if( m_hash )
+	{
+		delete m_hash;
+
+		m_hash = nullptr;
+	}
+
+	if( m_xxh3State )
+	{
+		XXH3_freeState( m_xxh3State );
+
+		m_xxh3State = nullptr;
+	}
+}
+
+bool ChecksumStream::operator<<( std::string_view data )
+{
+	if( m_xxh3State )
+	{
+		return XXH3_128bits_update( m_xxh3State, data.data(), data.size() ) == XXH_OK;
+	}
+
+	if( !m_hash )
+	{
+		return false;
+	}
+
+	m_hash->Update( (const CryptoPP::byte*)data.data(), data.size() );
+
+	return true;
+}
+
+bool ChecksumStream::FinishAndRetrieve( Digest128& checksum )
+{
+	if( m_xxh3State )
+	{
+		// Canonical form is big endian, matching the hex representation used by xxHash tools
+		XXH128_canonical_t canonical;
+
+		XXH128_canonicalFromHash( &canonical, XXH3_128bits_digest( m_xxh3State ) );
+
+		static_assert( sizeof( canonical.digest ) == Digest128::SIZE );
+
+		std::memcpy( checksum.bytes.data(), canonical.digest, Digest128::SIZE );
+
+		Finish();
+
+		return true;
+	}
+
+	if( !m_hash || m_hash->DigestSize() != Digest128::SIZE )
+	{
+		return false;
+	}
+
+	m_hash->Final( checksum.bytes.data() );
+
+	Finish();
+
+	return true;
+}
+
+bool ChecksumStream::FinishAndRetrieve( std::string& checksum )
+{
+	Digest128 digest;
+
+	if( !FinishAndRetrieve( digest ) )
+	{
+		return false;
+	}
+
+	checksum = digest.ToHexString();
+
+	return true;
+}
+
+}
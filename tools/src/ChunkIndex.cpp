@@ -2,10 +2,15 @@
 
 #include "ChunkIndex.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "FileDataStreamIn.h"
 #include "ResourceTools.h"
@@ -17,57 +22,59 @@ constexpr size_t CHUNK_BLOCK_SIZE = sizeof( uint32_t ) + sizeof( uint32_t );
 constexpr size_t TARGET_FILE_SIZE = 1024 * 1024 * 512; // 512 MB index files, each covering 64 MB of the source file.
 constexpr size_t BLOCKS_PER_FILE = TARGET_FILE_SIZE / CHUNK_BLOCK_SIZE;
 
+// In memory index is kept at most half full so probe sequences stay short.
+constexpr size_t IN_MEMORY_LOAD_FACTOR_INVERSE = 2;
+
+// Segments are handed out to workers dynamically, several per worker balances uneven progress.
+constexpr uint64_t SEGMENTS_PER_THREAD = 4;
+
+// Neighbouring segments overlap by a chunk, segments are kept several chunks long so re-reading the overlap stays cheap.
+constexpr uint64_t MINIMUM_SEGMENT_WINDOWS = 1024 * 1024;
+constexpr uint64_t MINIMUM_SEGMENT_CHUNKS = 4;
+
+// Checksums are generated in batches to bound memory, each batch re-sums its first window.
+constexpr uint64_t MINIMUM_BATCH_WINDOWS = 1024 * 1024;
+
+// Approximate cost of a memoised source checksum, the node with its next pointer and a bucket.
+constexpr size_t SOURCE_CHECKSUM_ENTRY_SIZE = sizeof( std::pair<const size_t, ResourceTools::Digest128> ) + 2 * sizeof( void* );
+
 
 namespace ResourceTools
 {
-ChunkIndex::ChunkIndex( std::filesystem::path fileToIndex, uint32_t chunkSize, const std::filesystem::path& indexFolder ) :
+ChunkIndex::ChunkIndex( std::filesystem::path fileToIndex, uint32_t chunkSize, const std::filesystem::path& indexFolder, uintmax_t memoryBudget /* = 0 */, unsigned int threadCount /* = 1 */ ) :
 	m_fileToIndex( fileToIndex ),
     m_chunkSize( chunkSize ),
-    m_currentIndexFile( 0 ),
-    m_indexFolder( indexFolder )
+    m_indexFolder( indexFolder ),
+    m_filterHitCount( 0 ),
+    m_filterMissCount( 0 ),
+    m_memoryBudget( memoryBudget ),
+    m_threadCount( threadCount ),
+    m_ownsIndexFiles( true ),
+    m_inMemory( false )
 {
 }
 
 ChunkIndex::~ChunkIndex()
 {
-	for( auto path : m_indexFiles )
+	for( IndexFile& indexFile : m_indexFiles )
 	{
-		if( std::filesystem::exists( path ) )
+		// Mapping must be released before the file can be removed
+		indexFile.mapping.Close();
+
+		if( m_ownsIndexFiles && std::filesystem::exists( indexFile.path ) )
 		{
-			std::filesystem::remove( path );
+			std::filesystem::remove( indexFile.path );
 		}
 	}
 }
 
-bool ChunkIndex::Flush( std::vector<std::pair<uint32_t, uint32_t>>& index )
+bool ChunkIndex::WriteIndexFile( size_t segment, uint64_t baseOffset, std::vector<std::pair<uint32_t, uint32_t>>& index )
 {
 	if( index.empty() )
 	{
 		return true;
 	}
-	std::filesystem::path out = GenerateIndexPath();
-	++m_currentIndexFile;
-	std::filesystem::path directory = out.parent_path();
-
-	if( !m_currentIndexFile && directory != "" )
-	{
-		try
-		{
-			if( !std::filesystem::exists( directory ) )
-			{
-				std::filesystem::create_directories( directory );
-			}
-
-			if( !std::filesystem::exists( directory ) )
-			{
-				return false;
-			}
-		}
-		catch( std::filesystem::filesystem_error& )
-		{
-			return false;
-		}
-	}
+	std::filesystem::path out = GenerateIndexPath( segment );
 
 	std::ofstream streamOut;
 	streamOut.open( out, std::ios::out | std::ios::binary );
@@ -75,27 +82,42 @@ bool ChunkIndex::Flush( std::vector<std::pair<uint32_t, uint32_t>>& index )
 	{
 		return false;
 	}
-	m_indexFiles.push_back( out );
 
 	std::sort( index.begin(), index.end() );
 	streamOut.write( reinterpret_cast<char*>( &index[0] ), sizeof( std::pair<uint32_t, uint32_t> ) * index.size() );
 	index.clear();
-	return true;
+	index.shrink_to_fit();
+	streamOut.close();
+
+	IndexFile indexFile;
+	indexFile.path = out;
+	indexFile.baseOffset = baseOffset;
+
+	bool mapped = streamOut && indexFile.mapping.Open( out );
+
+	// Recorded even on failure so the destructor removes the file
+	std::lock_guard<std::mutex> lock( m_indexFilesMutex );
+	m_indexFiles.push_back( std::move( indexFile ) );
+
+	return mapped;
 }
 
-std::filesystem::path ChunkIndex::GenerateIndexPath()
+std::filesystem::path ChunkIndex::GenerateIndexPath( size_t segment )
 {
 	std::stringstream ss;
-	ss << m_currentIndexFile;
+	ss << segment;
 	std::filesystem::path filename = m_fileToIndex.filename();
 	return m_indexFolder / ( filename.string() + ss.str() + ".index" );
 }
 
-bool ChunkIndex::GenerateChecksumFilter( const std::filesystem::path& targetFile )
+bool ChunkIndex::GenerateChecksumFilter( const std::filesystem::path& targetFile, double falsePositiveRate /* = ChecksumFilter::DEFAULT_FALSE_POSITIVE_RATE */ )
 {
 	FileDataStreamIn targetIn( m_chunkSize );
 	targetIn.StartRead( targetFile );
 	size_t targetSize = std::filesystem::file_size( targetFile );
+
+	// One checksum per chunk of the target, repeated chunks only make the filter emptier
+	m_checksumFilter.Reset( ( targetSize + m_chunkSize - 1 ) / m_chunkSize, falsePositiveRate );
 	for( uintmax_t dataOffset = 0; dataOffset < targetSize; dataOffset += m_chunkSize )
 	{
 		std::string nextFileData;
@@ -108,265 +130,548 @@ bool ChunkIndex::GenerateChecksumFilter( const std::filesystem::path& targetFile
 		}
 		auto nextFileDataSize = static_cast<uint32_t>( nextFileData.size() );
 		uint32_t checksum = ResourceTools::GenerateRollingAdlerChecksum( nextFileData, 0, nextFileDataSize ).checksum;
-		m_checksumFilter.insert( checksum );
+		m_checksumFilter.Insert( checksum );
 	}
 	return true;
 }
 
-bool ChunkIndex::IsRelevant( uint32_t checksum )
+bool ChunkIndex::IsRelevant( uint32_t checksum ) const
+{
+	return m_checksumFilter.IsEmpty() || m_checksumFilter.MayContain( checksum );
+}
+
+uint64_t ChunkIndex::GetFilterHitCount() const
+{
+	return m_filterHitCount;
+}
+
+uint64_t ChunkIndex::GetFilterMissCount() const
+{
+	return m_filterMissCount;
+}
+
+static size_t InMemoryIndexCapacity( size_t entryCount )
 {
-	if( m_checksumFilter.empty() )
+	return std::bit_ceil( std::max<size_t>( entryCount * IN_MEMORY_LOAD_FACTOR_INVERSE, 1 ) );
+}
+
+static size_t InMemoryIndexSlot( uint32_t checksum, size_t capacity )
+{
+	// Fibonacci hashing, the low bits of the rolling checksum alone are poorly distributed
+	return static_cast<size_t>( ( checksum * 0x9E3779B97F4A7C15ull ) >> 32 ) & ( capacity - 1 );
+}
+
+bool ChunkIndex::IsInMemory() const
+{
+	return m_inMemory;
+}
+
+bool ChunkIndex::FitsInMemory( size_t entryCount ) const
+{
+	// Entries are gathered before the table is built so both are resident at the peak
+	uintmax_t required = entryCount * ( sizeof( std::pair<uint32_t, uint32_t> ) + sizeof( uint64_t ) ) + InMemoryIndexCapacity( entryCount ) * sizeof( InMemoryEntry );
+	return required <= m_memoryBudget;
+}
+
+bool ChunkIndex::CanMemoiseSourceChecksum() const
+{
+	// Memo shares the memory budget with the in memory index, whatever the index leaves is available
+	uintmax_t indexSize = m_inMemoryIndex.capacity() * sizeof( InMemoryEntry ) + m_inMemoryOffsets.capacity() * sizeof( uint64_t );
+	uintmax_t memoSize = ( m_sourceChecksums.size() + 1 ) * SOURCE_CHECKSUM_ENTRY_SIZE;
+	return indexSize + memoSize <= m_memoryBudget;
+}
+
+size_t ChunkIndex::FindInMemorySlot( uint32_t checksum ) const
+{
+	// Linear probing, stops at the slot holding checksum or the first unused slot
+	size_t capacity = m_inMemoryIndex.size();
+	size_t slot = InMemoryIndexSlot( checksum, capacity );
+	while( m_inMemoryIndex[slot].count != 0 && m_inMemoryIndex[slot].checksum != checksum )
 	{
-		return true;
+		slot = ( slot + 1 ) & ( capacity - 1 );
 	}
-	return m_checksumFilter.find( checksum ) != m_checksumFilter.end();
+	return slot;
 }
 
-bool ChunkIndex::Generate()
+void ChunkIndex::BuildInMemoryIndex( const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& segmentEntries, uint64_t segmentWindows )
 {
-	size_t result{ 0 };
-	FileDataStreamIn streamIn( m_chunkSize );
-	if( !streamIn.StartRead( m_fileToIndex ) )
+	size_t entryCount{ 0 };
+	for( const auto& entries : segmentEntries )
 	{
-		return result;
+		entryCount += entries.size();
 	}
 
-	if( !std::filesystem::exists( m_indexFolder ) )
+	m_inMemoryIndex.assign( InMemoryIndexCapacity( entryCount ), InMemoryEntry{} );
+	m_inMemoryOffsets.resize( entryCount );
+
+	// Repeated checksums share a slot so low entropy data doesn't degrade into long probe sequences
+	for( const auto& entries : segmentEntries )
 	{
-		if( !std::filesystem::create_directories( m_indexFolder ) )
+		for( const auto& entry : entries )
 		{
-			return false;
+			InMemoryEntry& slot = m_inMemoryIndex[FindInMemorySlot( entry.first )];
+			slot.checksum = entry.first;
+			slot.count++;
 		}
 	}
 
-	size_t fileSize = std::filesystem::file_size( m_fileToIndex );
-	size_t indexFileCount = fileSize / BLOCKS_PER_FILE;
+	// Each slot starts at the end of its range, filling backwards leaves first at the start
+	uint64_t end{ 0 };
+	for( InMemoryEntry& slot : m_inMemoryIndex )
+	{
+		end += slot.count;
+		slot.first = end;
+	}
 
-	std::string fileData;
-	std::string backlog;
+	// Entries are generated in file order so walking them in reverse leaves every range in file order
+	for( size_t segment = segmentEntries.size(); segment-- > 0; )
+	{
+		uint64_t baseOffset = segment * segmentWindows;
+		for( auto entry = segmentEntries[segment].rbegin(); entry != segmentEntries[segment].rend(); ++entry )
+		{
+			InMemoryEntry& slot = m_inMemoryIndex[FindInMemorySlot( entry->first )];
+			m_inMemoryOffsets[--slot.first] = baseOffset + entry->second;
+		}
+	}
 
-	uint32_t backlogOffset{ 0 };
-	uint64_t fileOffset{ 0 };
-	RollingChecksum checksum;
+	m_inMemory = true;
+}
+
+void ChunkIndex::FindChunkOffsetsInMemory( uint32_t chunk, std::vector<size_t>& offsets ) const
+{
+	if( m_inMemoryIndex.empty() )
+	{
+		return;
+	}
 
-	std::vector<std::pair<uint32_t, uint32_t>> chunkToOffsets;
-	chunkToOffsets.reserve( BLOCKS_PER_FILE );
-	size_t cachedChunks{ 0 };
+	const InMemoryEntry& slot = m_inMemoryIndex[FindInMemorySlot( chunk )];
+	for( uint64_t i = slot.first; i < slot.first + slot.count; ++i )
+	{
+		offsets.push_back( static_cast<size_t>( m_inMemoryOffsets[i] ) );
+	}
+}
 
-	size_t onePercentOfFileSize = fileSize / 100;
+void ChunkIndex::GenerateSegment( std::string_view data, uint64_t segmentStart, uint64_t segmentEnd, std::vector<uint32_t>& checksums, std::vector<std::pair<uint32_t, uint32_t>>& entries )
+{
+	uint64_t batchWindows = std::max<uint64_t>( MINIMUM_BATCH_WINDOWS, m_chunkSize );
 
-	while( streamIn >> fileData )
+	for( uint64_t batchStart = segmentStart; batchStart < segmentEnd; batchStart += batchWindows )
 	{
-		backlog += fileData;
-		while( backlogOffset + m_chunkSize <= backlog.size() )
-		{
-			if( backlogOffset == 0 )
-			{
-				checksum = GenerateRollingAdlerChecksum( backlog, 0, m_chunkSize );
-			}
-			else
-			{
-				checksum = GenerateRollingAdlerChecksum( backlog, backlogOffset, backlogOffset + m_chunkSize, checksum );
-			}
+		uint64_t batchEnd = std::min( batchStart + batchWindows, segmentEnd );
 
-			if( !IsRelevant( checksum.checksum ) )
-			{
-				++backlogOffset;
-				continue;
-			}
-			auto offset = static_cast<uint32_t>( backlogOffset + fileOffset - m_currentIndexFile * BLOCKS_PER_FILE );
-			chunkToOffsets.emplace_back( std::pair<uint32_t, uint32_t>( checksum.checksum, offset ) );
-			++cachedChunks;
-			++backlogOffset;
-			if( cachedChunks >= BLOCKS_PER_FILE )
-			{
-				Flush( chunkToOffsets );
+		// Batch covers its windows plus the remainder of the final window
+		std::string_view batch = data.substr( batchStart, batchEnd - batchStart + m_chunkSize - 1 );
+
+		GenerateRollingAdlerChecksums( batch, 0, static_cast<uint32_t>( batch.size() ), m_chunkSize, checksums );
 
-				cachedChunks = 0;
+		auto batchOffset = static_cast<uint32_t>( batchStart - segmentStart );
+		size_t entriesBefore = entries.size();
+		for( uint32_t window = 0; window < checksums.size(); ++window )
+		{
+			if( IsRelevant( checksums[window] ) )
+			{
+				entries.emplace_back( checksums[window], batchOffset + window );
 			}
 		}
-		// Shrink fileData every now and then, but beware, we need to access start-1 for the rolling checksum.
-		if( backlogOffset > m_chunkSize + 1 )
+
+		if( !m_checksumFilter.IsEmpty() )
 		{
-			backlogOffset -= m_chunkSize;
-			fileOffset += m_chunkSize;
-			backlog = backlog.substr( m_chunkSize );
+			uint64_t hits = entries.size() - entriesBefore;
+			m_filterHitCount += hits;
+			m_filterMissCount += checksums.size() - hits;
 		}
 	}
-
-	Flush( chunkToOffsets );
-
-	return true;
 }
 
-bool FindMatchingChunksInFile( uint32_t chunk, const std::filesystem::path& path, size_t baseOffset, std::vector<size_t>& offsets )
+bool ChunkIndex::Generate()
 {
-	size_t fileSize = std::filesystem::file_size( path );
-	std::ifstream chunkFile;
-	chunkFile.open( path, std::ifstream::binary );
-	if( !chunkFile )
+	// Workers read their segments directly from the mapped file
+	MemoryMappedFile source;
+	if( !source.Open( m_fileToIndex ) )
 	{
 		return false;
 	}
-	size_t chunkCount = fileSize / CHUNK_BLOCK_SIZE;
+	std::string_view data( source.GetData(), source.GetSize() );
+
+	m_filterHitCount = 0;
+	m_filterMissCount = 0;
+
+	uint64_t windowCount = m_chunkSize && data.size() >= m_chunkSize ? data.size() - m_chunkSize + 1 : 0;
+
+	// Every window is indexed when there is no filter so the final size is known up front.
+	// With a filter the index is gathered in memory until it exceeds the budget.
+	bool inMemory = m_memoryBudget > 0 && ( !m_checksumFilter.IsEmpty() || FitsInMemory( windowCount ) );
+
+	// May be called by several workers at once when the budget is exceeded
+	auto createIndexFolder = [this]() {
+		std::error_code error;
+		std::filesystem::create_directories( m_indexFolder, error );
+		return std::filesystem::is_directory( m_indexFolder, error );
+	};
 
-	size_t beginning = 0;
-	size_t end = chunkCount;
-	uint32_t current;
-	while( beginning <= end )
+	if( !inMemory && !createIndexFolder() )
 	{
-		size_t pos = ( beginning + end ) / 2;
-		chunkFile.seekg( CHUNK_BLOCK_SIZE * pos );
-		chunkFile.read( reinterpret_cast<char*>( &current ), sizeof( current ) );
-		if( current > chunk )
-		{
-			if( beginning == end )
-			{
-				return true;
-			}
-			end = pos;
-		}
-		else if( current < chunk )
+		return false;
+	}
+
+	if( windowCount == 0 )
+	{
+		if( inMemory )
 		{
-			if( beginning == end )
-			{
-				return true;
-			}
-			if( beginning == pos )
-			{
-				beginning = pos + 1;
-			}
-			else
-			{
-				beginning = pos;
-			}
+			BuildInMemoryIndex( {}, 0 );
 		}
-		else
+		return true;
+	}
+
+	unsigned int threadCount = m_threadCount;
+
+	if( threadCount == 0 )
+	{
+		threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+	}
+
+	// File is split into segments of windows, each overlapping the next by the length of a chunk.
+	// Segment size is limited so entries held by all workers at once stay within the size of a single index file,
+	// and so offsets relative to the segment fit in an index entry.
+	uint64_t minimumSegmentWindows = std::min<uint64_t>( std::max<uint64_t>( MINIMUM_SEGMENT_WINDOWS, m_chunkSize * MINIMUM_SEGMENT_CHUNKS ), UINT32_MAX );
+	uint64_t maximumSegmentWindows = std::max<uint64_t>( BLOCKS_PER_FILE / threadCount, minimumSegmentWindows );
+	uint64_t segmentsWanted = threadCount == 1 ? 1 : threadCount * SEGMENTS_PER_THREAD;
+	uint64_t segmentWindows = std::clamp<uint64_t>( ( windowCount + segmentsWanted - 1 ) / segmentsWanted, minimumSegmentWindows, maximumSegmentWindows );
+	size_t segmentCount = static_cast<size_t>( ( windowCount + segmentWindows - 1 ) / segmentWindows );
+
+	threadCount = static_cast<unsigned int>( std::min<size_t>( threadCount, segmentCount ) );
+
+	// Entries are offsets relative to the start of their segment
+	std::vector<std::vector<std::pair<uint32_t, uint32_t>>> segmentEntries( segmentCount );
+
+	std::atomic<size_t> nextSegment = 0;
+
+	std::atomic<size_t> inMemoryEntryCount = 0;
+
+	std::atomic<bool> spilled = !inMemory;
+
+	std::atomic<bool> failed = false;
+
+	auto worker = [&]() {
+		std::vector<uint32_t> checksums;
+
+		while( !failed )
 		{
-			// It's a match!
-			uint32_t relative{ 0 };
-			chunkFile.read( reinterpret_cast<char*>( &relative ), sizeof( relative ) );
-			offsets.push_back( baseOffset + relative );
+			size_t segment = nextSegment++;
 
-			if( pos )
+			if( segment >= segmentCount )
 			{
-				size_t previous = pos - 1;
-				while( true )
-				{
-					chunkFile.seekg( CHUNK_BLOCK_SIZE * previous );
-					chunkFile.read( reinterpret_cast<char*>( &current ), sizeof( current ) );
-					if( current == chunk )
-					{
-						uint32_t relative{ 0 };
-						chunkFile.read( reinterpret_cast<char*>( &relative ), sizeof( relative ) );
-						offsets.push_back( baseOffset + relative );
-					}
-					else
-					{
-						break;
-					}
-					if( !previous )
-					{
-						break;
-					}
-					--previous;
-				}
+				return;
 			}
 
-			size_t next = pos + 1;
-			while( next <= chunkCount )
+			uint64_t segmentStart = segment * segmentWindows;
+			uint64_t segmentEnd = std::min( segmentStart + segmentWindows, windowCount );
+
+			std::vector<std::pair<uint32_t, uint32_t>>& entries = segmentEntries[segment];
+
+			GenerateSegment( data, segmentStart, segmentEnd, checksums, entries );
+
+			if( !spilled )
 			{
-				chunkFile.seekg( CHUNK_BLOCK_SIZE * next );
-				chunkFile.read( reinterpret_cast<char*>( &current ), sizeof( current ) );
-				if( current == chunk )
+				if( FitsInMemory( inMemoryEntryCount += entries.size() ) )
 				{
-					uint32_t relative;
-					chunkFile.read( reinterpret_cast<char*>( &relative ), sizeof( relative ) );
-					offsets.push_back( baseOffset + relative );
+					continue;
 				}
-				else
+
+				// Budget exceeded, this and all following segments are written to index files
+				// segments already held in memory are written once all workers are done
+				if( !createIndexFolder() )
 				{
-					break;
+					failed = true;
+					return;
 				}
-				++next;
+				spilled = true;
 			}
 
-			return true;
+			if( !WriteIndexFile( segment, segmentStart, entries ) )
+			{
+				failed = true;
+			}
+		}
+	};
+
+	if( threadCount > 1 )
+	{
+		std::vector<std::thread> workers;
+
+		for( unsigned int i = 0; i < threadCount; i++ )
+		{
+			workers.emplace_back( worker );
 		}
+
+		for( std::thread& workerThread : workers )
+		{
+			workerThread.join();
+		}
+	}
+	else
+	{
+		worker();
+	}
+
+	if( failed )
+	{
+		return false;
+	}
+
+	if( !spilled )
+	{
+		BuildInMemoryIndex( segmentEntries, segmentWindows );
+		return true;
+	}
+
+	for( size_t segment = 0; segment < segmentCount; ++segment )
+	{
+		if( !segmentEntries[segment].empty() && !WriteIndexFile( segment, segment * segmentWindows, segmentEntries[segment] ) )
+		{
+			return false;
+		}
+	}
+
+	// Workers finish in any order, lookups report offsets in file order
+	std::sort( m_indexFiles.begin(), m_indexFiles.end(), []( const IndexFile& a, const IndexFile& b ) { return a.baseOffset < b.baseOffset; } );
+
+	return true;
+}
+
+bool ChunkIndex::Persist()
+{
+	if( m_inMemory )
+	{
+		return false;
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories( m_indexFolder, error );
+
+	std::ofstream manifest( m_indexFolder / MANIFEST_FILENAME );
+	if( !manifest )
+	{
+		return false;
+	}
+
+	manifest << "chunkSize " << m_chunkSize << "\n";
+	manifest << "fileSize " << std::filesystem::file_size( m_fileToIndex, error ) << "\n";
+
+	for( const IndexFile& indexFile : m_indexFiles )
+	{
+		manifest << indexFile.baseOffset << " " << indexFile.path.filename().string() << "\n";
 	}
+
+	manifest.close();
+	if( !manifest || error )
+	{
+		return false;
+	}
+
+	m_ownsIndexFiles = false;
+
+	return true;
+}
+
+bool ChunkIndex::Load( const std::filesystem::path& directory )
+{
+	std::ifstream manifest( directory / MANIFEST_FILENAME );
+	if( !manifest )
+	{
+		return false;
+	}
+
+	std::string chunkSizeLabel;
+	std::string fileSizeLabel;
+	uint32_t chunkSize{ 0 };
+	uintmax_t fileSize{ 0 };
+
+	if( !( manifest >> chunkSizeLabel >> chunkSize >> fileSizeLabel >> fileSize ) || chunkSizeLabel != "chunkSize" || fileSizeLabel != "fileSize" )
+	{
+		return false;
+	}
+
+	std::error_code error;
+	if( chunkSize != m_chunkSize || fileSize != std::filesystem::file_size( m_fileToIndex, error ) || error )
+	{
+		return false;
+	}
+
+	std::vector<IndexFile> indexFiles;
+
+	uint64_t baseOffset;
+	std::string filename;
+	while( manifest >> baseOffset >> filename )
+	{
+		IndexFile indexFile;
+		indexFile.path = directory / filename;
+		indexFile.baseOffset = baseOffset;
+
+		if( !indexFile.mapping.Open( indexFile.path ) || indexFile.mapping.GetSize() % CHUNK_BLOCK_SIZE != 0 )
+		{
+			return false;
+		}
+
+		indexFiles.push_back( std::move( indexFile ) );
+	}
+
+	if( !manifest.eof() )
+	{
+		return false;
+	}
+
+	m_indexFiles = std::move( indexFiles );
+	m_ownsIndexFiles = false;
+	m_inMemory = false;
+
+	return true;
+}
+
+bool FindMatchingChunksInFile( uint32_t chunk, const MemoryMappedFile& indexFile, size_t baseOffset, std::vector<size_t>& offsets )
+{
+	using IndexEntry = std::pair<uint32_t, uint32_t>;
+	static_assert( sizeof( IndexEntry ) == CHUNK_BLOCK_SIZE );
+
+	// Index files are written as sorted arrays of entries so can be searched in place
+	const IndexEntry* begin = reinterpret_cast<const IndexEntry*>( indexFile.GetData() );
+	const IndexEntry* end = begin + indexFile.GetSize() / CHUNK_BLOCK_SIZE;
+
+	auto lower = std::lower_bound( begin, end, chunk, []( const IndexEntry& entry, uint32_t value ) { return entry.first < value; } );
+
+	for( auto entry = lower; entry != end && entry->first == chunk; ++entry )
+	{
+		offsets.push_back( baseOffset + entry->second );
+	}
+
 	return true;
 }
 
 bool ChunkIndex::FindChunkOffsets( uint32_t chunk, std::vector<size_t>& offsets )
 {
-	size_t baseOffset{ 0 };
-	for( auto path : m_indexFiles )
+	if( m_inMemory )
+	{
+		FindChunkOffsetsInMemory( chunk, offsets );
+		return true;
+	}
+
+	for( const IndexFile& indexFile : m_indexFiles )
 	{
-		if( !FindMatchingChunksInFile( chunk, path, baseOffset, offsets ) )
+		if( !FindMatchingChunksInFile( chunk, indexFile.mapping, indexFile.baseOffset, offsets ) )
 		{
 			return false;
 		}
-		baseOffset += BLOCKS_PER_FILE;
 	}
 	return true;
 }
 
-bool ChunkIndex::FindMatchingChunk( const std::string& chunk, size_t& chunkOffset )
+const ChunkIndex::MatchStatistics& ChunkIndex::GetMatchStatistics() const
 {
-	std::string sourceMD5;
-	bool sourceChecksumGenerated{ false };
+	return m_matchStatistics;
+}
+
+bool ChunkIndex::GetSourceChecksum( size_t offset, size_t size, Digest128& checksum )
+{
+	// Only windows the size of an indexed chunk are memoised, a shorter final chunk of the target is hashed every time
+	// Once the memo has used the memory budget further windows are hashed every time they are a candidate
+	bool memoise = size == m_chunkSize;
+	if( memoise )
+	{
+		auto found = m_sourceChecksums.find( offset );
+		if( found != m_sourceChecksums.end() )
+		{
+			checksum = found->second;
+			m_matchStatistics.strongChecksumCacheHits++;
+			return true;
+		}
+	}
+
+	std::string_view sourceData( m_source.GetData() + offset, size );
+	if( !ResourceTools::GenerateChecksum( sourceData, ChecksumAlgorithm::MD5, checksum ) )
+	{
+		return false;
+	}
+	m_matchStatistics.strongChecksumsGenerated++;
+
+	if( memoise && CanMemoiseSourceChecksum() )
+	{
+		m_sourceChecksums.emplace( offset, checksum );
+	}
+	return true;
+}
+
+bool ChunkIndex::FindMatchingChunk( std::string_view chunk, size_t& chunkOffset )
+{
+	m_matchStatistics.queries++;
+
+	// Chunk is hashed once, only if a candidate is found
+	Digest128 chunkMD5;
+	bool chunkChecksumGenerated{ false };
 
-	size_t baseOffset{ 0 };
 	std::vector<size_t> offsets;
 
 	auto end = static_cast<uint32_t>( chunk.size() );
 	RollingChecksum rollingChecksum = ResourceTools::GenerateRollingAdlerChecksum( chunk, 0, end );
 
-	for( auto path : m_indexFiles )
+	// In memory index is searched in a single pass, otherwise each index file is searched in turn
+	size_t searchCount = m_inMemory ? 1 : m_indexFiles.size();
+
+	for( size_t search = 0; search < searchCount; ++search )
 	{
-		if( !FindMatchingChunksInFile( rollingChecksum.checksum, path, baseOffset, offsets ) )
+		offsets.clear();
+		if( m_inMemory )
+		{
+			FindChunkOffsetsInMemory( rollingChecksum.checksum, offsets );
+		}
+		else if( !FindMatchingChunksInFile( rollingChecksum.checksum, m_indexFiles[search].mapping, m_indexFiles[search].baseOffset, offsets ) )
 		{
 			return false;
 		}
-		if( !offsets.empty() )
+		if( offsets.empty() )
 		{
-			std::ifstream chunkFile;
-			chunkFile.open( m_fileToIndex, std::ifstream::binary );
-			if( !chunkFile )
+			continue;
+		}
+
+		if( !m_source.IsOpen() && !m_source.Open( m_fileToIndex ) )
+		{
+			return false;
+		}
+
+		if( !chunkChecksumGenerated )
+		{
+			if( !ResourceTools::GenerateChecksum( chunk, ChecksumAlgorithm::MD5, chunkMD5 ) )
 			{
 				return false;
 			}
+			chunkChecksumGenerated = true;
+		}
 
-			for( size_t offset : offsets )
+		// Offsets are in file order so candidates are read through the mapping front to back
+		for( size_t offset : offsets )
+		{
+			if( offset + chunk.size() > m_source.GetSize() )
 			{
-				std::string fileData;
-				fileData.resize( chunk.size() );
-				chunkFile.seekg( static_cast<std::streamoff>( offset ) );
-				chunkFile.read( fileData.data(), fileData.size() );
-				if( !sourceChecksumGenerated )
-				{
-					if( !ResourceTools::GenerateMd5Checksum( fileData, sourceMD5 ) )
-					{
-						return false;
-					}
-					sourceChecksumGenerated = true;
-				}
+				continue;
+			}
 
-				std::string matchingChunkMD5;
-				if( !ResourceTools::GenerateMd5Checksum( chunk, matchingChunkMD5 ) )
-				{
-					return false;
-				}
-				if( sourceMD5 == matchingChunkMD5 )
-				{
-					// It's legit!
-					chunkOffset = offset;
-					return true;
-				}
+			m_matchStatistics.candidates++;
+
+			Digest128 sourceMD5;
+			if( !GetSourceChecksum( offset, chunk.size(), sourceMD5 ) )
+			{
+				return false;
+			}
+			if( sourceMD5 == chunkMD5 )
+			{
+				// It's legit!
+				chunkOffset = offset;
+				return true;
 			}
+
+			m_matchStatistics.collisions++;
 		}
 	}
 	return false;
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,141 @@
+// Copyright © 2025 CCP ehf.
+
+#include "ChunkIndexCache.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+constexpr char STAGING_EXTENSION[] = ".staging";
+
+namespace ResourceTools
+{
+
+ChunkIndexCache::ChunkIndexCache( std::filesystem::path cacheFolder, uintmax_t maximumSize ) :
+	m_cacheFolder( cacheFolder ),
+	m_maximumSize( maximumSize )
+{
+}
+
+std::string ChunkIndexCache::CreateKey( const Digest128& checksum, uint32_t chunkSize )
+{
+	std::stringstream ss;
+	ss << checksum.ToHexString() << "_" << chunkSize;
+	return ss.str();
+}
+
+bool ChunkIndexCache::Load( const std::string& key, ChunkIndex& index )
+{
+	std::filesystem::path entry = m_cacheFolder / key;
+
+	std::error_code error;
+	if( !std::filesystem::exists( entry / ChunkIndex::MANIFEST_FILENAME, error ) )
+	{
+		return false;
+	}
+
+	if( !index.Load( entry ) )
+	{
+		// Unusable entry, removed so it is regenerated
+		std::filesystem::remove_all( entry, error );
+		return false;
+	}
+
+	// Manifest modification time records when the entry was last used
+	std::filesystem::last_write_time( entry / ChunkIndex::MANIFEST_FILENAME, std::filesystem::file_time_type::clock::now(), error );
+
+	return true;
+}
+
+bool ChunkIndexCache::Store( const std::string& key, const std::filesystem::path& fileToIndex, uint32_t chunkSize, unsigned int threadCount, ChunkIndex& index )
+{
+	std::random_device randomDevice;
+	std::stringstream stagingName;
+	stagingName << key << "." << std::hex << randomDevice() << randomDevice() << STAGING_EXTENSION;
+
+	std::filesystem::path staging = m_cacheFolder / stagingName.str();
+	std::filesystem::path entry = m_cacheFolder / key;
+
+	std::error_code error;
+
+	{
+		// Memory budget of 0 so the index is written to the staging directory
+		ChunkIndex stagingIndex( fileToIndex, chunkSize, staging, 0, threadCount );
+
+		if( !stagingIndex.Generate() || !stagingIndex.Persist() )
+		{
+			std::filesystem::remove_all( staging, error );
+			return false;
+		}
+	}
+
+	// Another process may have stored the same entry in the meantime, theirs is kept
+	std::filesystem::rename( staging, entry, error );
+	if( error )
+	{
+		std::filesystem::remove_all( staging, error );
+	}
+
+	Evict( entry );
+
+	return Load( key, index );
+}
+
+void ChunkIndexCache::Evict( const std::filesystem::path& keep )
+{
+	struct CacheEntry
+	{
+		std::filesystem::path path;
+		std::filesystem::file_time_type lastUsed;
+		uintmax_t size;
+	};
+
+	std::vector<CacheEntry> entries;
+	uintmax_t totalSize{ 0 };
+
+	std::error_code error;
+	for( const std::filesystem::directory_entry& directory : std::filesystem::directory_iterator( m_cacheFolder, error ) )
+	{
+		std::filesystem::path manifest = directory.path() / ChunkIndex::MANIFEST_FILENAME;
+
+		// Staging directories are still being written
+		if( !directory.is_directory( error ) || directory.path().extension() == STAGING_EXTENSION || !std::filesystem::exists( manifest, error ) )
+		{
+			continue;
+		}
+
+		CacheEntry entry{ directory.path(), std::filesystem::last_write_time( manifest, error ), 0 };
+
+		for( const std::filesystem::directory_entry& file : std::filesystem::directory_iterator( directory.path(), error ) )
+		{
+			entry.size += file.file_size( error );
+		}
+
+		totalSize += entry.size;
+		entries.push_back( entry );
+	}
+
+	std::sort( entries.begin(), entries.end(), []( const CacheEntry& a, const CacheEntry& b ) { return a.lastUsed < b.lastUsed; } );
+
+	// Entry just stored is always kept, even if it alone exceeds the maximum size
+	for( const CacheEntry& entry : entries )
+	{
+		if( totalSize <= m_maximumSize )
+		{
+			break;
+		}
+
+		if( entry.path == keep )
+		{
+			continue;
+		}
+
+		if( std::filesystem::remove_all( entry.path, error ) != static_cast<std::uintmax_t>( -1 ) && !error )
+		{
+			totalSize -= entry.size;
+		}
+	}
+}
+
+}
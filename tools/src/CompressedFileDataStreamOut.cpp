@@ -2,6 +2,11 @@
 
 #include "CompressedFileDataStreamOut.h"
 
+#include <algorithm>
+
+// Spans are passed to the compression stream in pieces so a large span is not copied into one string
+constexpr size_t SPAN_COMPRESSION_PIECE_SIZE = 1024 * 1024;
+
 namespace ResourceTools
 {
 
@@ -83,5 +88,21 @@ bool CompressedFileDataStreamOut::operator<<( const std::string& data )
 	return true;
 }
 
+bool CompressedFileDataStreamOut::WriteSpan( std::string_view data )
+{
+	std::string piece;
+
+	for( size_t offset = 0; offset < data.size(); offset += piece.size() )
+	{
+		piece.assign( data.substr( offset, std::min( data.size() - offset, SPAN_COMPRESSION_PIECE_SIZE ) ) );
+
+		if( !operator<<( piece ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
 
-}
\ No newline at end of file
+}
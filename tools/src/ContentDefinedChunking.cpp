@@ -0,0 +1,108 @@
+// Copyright © 2025 CCP ehf.
+
+#include "ContentDefinedChunking.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+// Mask bits added before the average size and removed after it, concentrates chunk sizes around the average.
+constexpr uint32_t NORMALISATION_LEVEL = 2;
+
+namespace ResourceTools
+{
+
+// Gear table of pseudo random values per byte, fixed so boundaries are identical across builds and platforms
+static constexpr std::array<uint64_t, 256> GenerateGearTable()
+{
+	std::array<uint64_t, 256> table{};
+	uint64_t state = 0x2545F4914F6CDD1Dull;
+	for( uint64_t& value : table )
+	{
+		// splitmix64
+		state += 0x9E3779B97F4A7C15ull;
+		uint64_t mixed = state;
+		mixed = ( mixed ^ ( mixed >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+		mixed = ( mixed ^ ( mixed >> 27 ) ) * 0x94D049BB133111EBull;
+		value = mixed ^ ( mixed >> 31 );
+	}
+	return table;
+}
+
+static constexpr std::array<uint64_t, 256> GEAR_TABLE = GenerateGearTable();
+
+// Gear hash is shifted left each byte so the high bits cover the most bytes, boundary masks use the high bits
+static uint64_t BoundaryMask( uint32_t bits )
+{
+	bits = std::clamp<uint32_t>( bits, 1, 63 );
+	return ~uint64_t{ 0 } << ( 64 - bits );
+}
+
+bool IsValidContentDefinedChunkSizes( const ContentDefinedChunkSizes& sizes )
+{
+	return sizes.minimum > 0 && sizes.minimum <= sizes.average && sizes.average <= sizes.maximum;
+}
+
+size_t FindContentDefinedChunkLength( std::string_view data, const ContentDefinedChunkSizes& sizes )
+{
+	if( data.size() <= sizes.minimum )
+	{
+		return data.size();
+	}
+
+	size_t maximum = std::min<size_t>( data.size(), sizes.maximum );
+	size_t normal = std::min<size_t>( maximum, sizes.average );
+
+	uint32_t averageBits = std::bit_width( sizes.average ) - 1;
+	uint64_t smallMask = BoundaryMask( averageBits + NORMALISATION_LEVEL );
+	uint64_t largeMask = BoundaryMask( averageBits > NORMALISATION_LEVEL ? averageBits - NORMALISATION_LEVEL : 1 );
+
+	const auto* bytes = reinterpret_cast<const uint8_t*>( data.data() );
+	uint64_t hash = 0;
+
+	// Cut points before the minimum are skipped entirely
+	size_t position = sizes.minimum;
+
+	// Harder to cut before the average size and easier after it
+	for( ; position < normal; ++position )
+	{
+		hash = ( hash << 1 ) + GEAR_TABLE[bytes[position]];
+		if( ( hash & smallMask ) == 0 )
+		{
+			return position + 1;
+		}
+	}
+
+	for( ; position < maximum; ++position )
+	{
+		hash = ( hash << 1 ) + GEAR_TABLE[bytes[position]];
+		if( ( hash & largeMask ) == 0 )
+		{
+			return position + 1;
+		}
+	}
+
+	return maximum;
+}
+
+void GenerateContentDefinedChunks( std::string_view data, const ContentDefinedChunkSizes& sizes, std::vector<size_t>& lengths )
+{
+	lengths.clear();
+
+	if( !IsValidContentDefinedChunkSizes( sizes ) )
+	{
+		return;
+	}
+
+	lengths.reserve( data.size() / sizes.average + 1 );
+
+	size_t offset = 0;
+	while( offset < data.size() )
+	{
+		size_t length = FindContentDefinedChunkLength( data.substr( offset ), sizes );
+		lengths.push_back( length );
+		offset += length;
+	}
+}
+
+}
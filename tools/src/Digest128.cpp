@@ -0,0 +1,84 @@
+// Copyright © 2025 CCP ehf.
+
+#include "Digest128.h"
+
+#include <cstring>
+
+namespace ResourceTools
+{
+
+static const char HEX_CHARACTERS[] = "0123456789abcdef";
+
+static int HexCharacterToValue( char c )
+{
+	if( c >= '0' && c <= '9' )
+	{
+		return c - '0';
+	}
+
+	if( c >= 'a' && c <= 'f' )
+	{
+		return c - 'a' + 10;
+	}
+
+	if( c >= 'A' && c <= 'F' )
+	{
+		return c - 'A' + 10;
+	}
+
+	return -1;
+}
+
+std::string Digest128::ToHexString() const
+{
+	std::string hex( SIZE * 2, '0' );
+
+	for( size_t i = 0; i < SIZE; i++ )
+	{
+		hex[i * 2] = HEX_CHARACTERS[bytes[i] >> 4];
+
+		hex[i * 2 + 1] = HEX_CHARACTERS[bytes[i] & 0x0F];
+	}
+
+	return hex;
+}
+
+bool Digest128::FromHexString( const std::string& hex )
+{
+	if( hex.size() != SIZE * 2 )
+	{
+		return false;
+	}
+
+	std::array<uint8_t, SIZE> result;
+
+	for( size_t i = 0; i < SIZE; i++ )
+	{
+		int high = HexCharacterToValue( hex[i * 2] );
+
+		int low = HexCharacterToValue( hex[i * 2 + 1] );
+
+		if( high < 0 || low < 0 )
+		{
+			return false;
+		}
+
+		result[i] = static_cast<uint8_t>( ( high << 4 ) | low );
+	}
+
+	bytes = result;
+
+	return true;
+}
+
+size_t Digest128Hash::operator()( const Digest128& digest ) const
+{
+	// Digest is already uniformly distributed so the leading bytes are a sufficient hash
+	size_t hash;
+
+	std::memcpy( &hash, digest.bytes.data(), sizeof( hash ) );
+
+	return hash;
+}
+
+}
@@ -3,9 +3,12 @@
 #include "Downloader.h"
 
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <thread>
 
+// Downloaders may be created on multiple threads, curl global initialisation and cleanup are not thread safe
+std::mutex s_activeDownloadersMutex;
 int s_activeDownloaders{ 0 };
 std::set<int> s_curl_retry_errors{
 	CURLE_AGAIN,
@@ -47,6 +50,7 @@ namespace ResourceTools
 {
 Downloader::Downloader()
 {
+	std::lock_guard<std::mutex> lock( s_activeDownloadersMutex );
 	if( !s_activeDownloaders++ )
 	{
 		InitializeCurl();
@@ -56,6 +60,7 @@ Downloader::Downloader()
 
 Downloader::~Downloader()
 {
+	std::lock_guard<std::mutex> lock( s_activeDownloadersMutex );
 	curl_easy_cleanup( m_curlHandle );
 	m_curlHandle = nullptr;
 	if( !--s_activeDownloaders )
@@ -2,6 +2,8 @@
 
 #include "FileDataStreamOut.h"
 
+#include "ChecksumStream.h"
+
 namespace ResourceTools
 {
 
@@ -25,6 +27,10 @@ bool FileDataStreamOut::Finish()
 
 	m_outputStream.close();
 
+	m_spanSource.Close();
+
+	m_spanSourcePath.clear();
+
 	return true;
 }
 
@@ -65,6 +71,8 @@ bool FileDataStreamOut::StartWrite( std::filesystem::path filepath )
 		return false;
 	}
 
+	m_path = filepath;
+
 	m_fileSize = 0;
 
 	m_writeInProgress = true;
@@ -94,4 +102,56 @@ size_t FileDataStreamOut::GetFileSize()
 	return m_fileSize;
 }
 
-}
\ No newline at end of file
+bool FileDataStreamOut::CopySpan( const std::filesystem::path& source, uint64_t sourceOffset, uint64_t length, ChecksumStream& checksum )
+{
+	if( !m_writeInProgress )
+	{
+		return false;
+	}
+
+	if( length == 0 )
+	{
+		return true;
+	}
+
+	// Spans are usually copied from the same source many times while writing a file, so its mapping is kept
+	if( !m_spanSource.IsOpen() || m_spanSourcePath != source )
+	{
+		m_spanSourcePath.clear();
+
+		if( !m_spanSource.Open( source ) )
+		{
+			return false;
+		}
+
+		m_spanSourcePath = source;
+	}
+
+	if( sourceOffset > m_spanSource.GetSize() || length > m_spanSource.GetSize() - sourceOffset )
+	{
+		return false;
+	}
+
+	std::string_view data( m_spanSource.GetData() + sourceOffset, length );
+
+	if( !( checksum << data ) )
+	{
+		return false;
+	}
+
+	return WriteSpan( data );
+}
+
+bool FileDataStreamOut::WriteSpan( std::string_view data )
+{
+	if( !m_outputStream.write( data.data(), static_cast<std::streamsize>( data.size() ) ) )
+	{
+		return false;
+	}
+
+	m_fileSize += data.size();
+
+	return true;
+}
+
+}
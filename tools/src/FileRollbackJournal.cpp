@@ -0,0 +1,253 @@
+// Copyright © 2025 CCP ehf.
+
+#include "FileRollbackJournal.h"
+
+#include "ResourceTools.h"
+#include "ScopedFile.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+constexpr char JOURNAL_EXTENSION[] = ".journal";
+
+constexpr char STAGING_EXTENSION[] = ".staging";
+
+// Identifies a journal and its layout: original file size, range count, then each range's offset, size and data
+constexpr char JOURNAL_MAGIC[] = { 'R', 'B', 'J', '1' };
+
+namespace ResourceTools
+{
+
+static bool WriteValue( std::ofstream& out, uint64_t value )
+{
+	return static_cast<bool>( out.write( reinterpret_cast<const char*>( &value ), sizeof( value ) ) );
+}
+
+static bool ReadValue( std::ifstream& in, uint64_t& value )
+{
+	return static_cast<bool>( in.read( reinterpret_cast<char*>( &value ), sizeof( value ) ) );
+}
+
+// Makes a rename in the directory of path durable
+static void SyncDirectory( const std::filesystem::path& path )
+{
+#if !_WIN64
+	SyncFile( path.has_parent_path() ? path.parent_path() : std::filesystem::path( "." ) );
+#endif
+}
+
+FileRollbackJournal::FileRollbackJournal( const std::filesystem::path& filePath ) :
+	m_filePath( filePath ),
+	m_journalPath( GetJournalPath( filePath ) )
+{
+}
+
+std::filesystem::path FileRollbackJournal::GetJournalPath( const std::filesystem::path& filePath )
+{
+	std::filesystem::path journalPath = filePath;
+
+	journalPath += JOURNAL_EXTENSION;
+
+	return journalPath;
+}
+
+bool FileRollbackJournal::Exists() const
+{
+	std::error_code error;
+
+	return std::filesystem::exists( m_journalPath, error );
+}
+
+bool FileRollbackJournal::Begin( const std::vector<Range>& ranges )
+{
+	std::error_code error;
+
+	uint64_t fileSize = std::filesystem::file_size( m_filePath, error );
+
+	if( error )
+	{
+		return false;
+	}
+
+	std::filesystem::path stagingPath = m_journalPath;
+
+	stagingPath += STAGING_EXTENSION;
+
+	// Removes an incomplete journal, the file has not been modified at that point
+	ScopedFile stagingScope( stagingPath );
+
+	{
+		std::ifstream fileIn( m_filePath, std::ios::in | std::ios::binary );
+
+		std::ofstream journalOut( stagingPath, std::ios::out | std::ios::binary | std::ios::trunc );
+
+		if( !fileIn || !journalOut )
+		{
+			return false;
+		}
+
+		journalOut.write( JOURNAL_MAGIC, sizeof( JOURNAL_MAGIC ) );
+
+		if( !WriteValue( journalOut, fileSize ) || !WriteValue( journalOut, ranges.size() ) )
+		{
+			return false;
+		}
+
+		std::string data;
+
+		for( const Range& range : ranges )
+		{
+			uint64_t offset = std::min( range.offset, fileSize );
+
+			data.resize( std::min( range.size, fileSize - offset ) );
+
+			if( !fileIn.seekg( static_cast<std::streamoff>( offset ) ) || !fileIn.read( data.data(), static_cast<std::streamsize>( data.size() ) ) )
+			{
+				return false;
+			}
+
+			if( !WriteValue( journalOut, offset ) || !WriteValue( journalOut, data.size() ) || !journalOut.write( data.data(), static_cast<std::streamsize>( data.size() ) ) )
+			{
+				return false;
+			}
+		}
+
+		if( !journalOut.flush() )
+		{
+			return false;
+		}
+	}
+
+	if( !SyncFile( stagingPath ) )
+	{
+		return false;
+	}
+
+	std::filesystem::rename( stagingPath, m_journalPath, error );
+
+	if( error )
+	{
+		return false;
+	}
+
+	SyncDirectory( m_journalPath );
+
+	return true;
+}
+
+bool FileRollbackJournal::RollBack()
+{
+	std::ifstream journalIn( m_journalPath, std::ios::in | std::ios::binary );
+
+	if( !journalIn )
+	{
+		return false;
+	}
+
+	char magic[sizeof( JOURNAL_MAGIC )];
+
+	uint64_t fileSize{ 0 };
+
+	uint64_t rangeCount{ 0 };
+
+	if( !journalIn.read( magic, sizeof( magic ) ) || !std::equal( std::begin( magic ), std::end( magic ), std::begin( JOURNAL_MAGIC ) ) )
+	{
+		return false;
+	}
+
+	if( !ReadValue( journalIn, fileSize ) || !ReadValue( journalIn, rangeCount ) )
+	{
+		return false;
+	}
+
+	{
+		std::fstream fileOut( m_filePath, std::ios::in | std::ios::out | std::ios::binary );
+
+		if( !fileOut )
+		{
+			return false;
+		}
+
+		std::string data;
+
+		for( uint64_t i = 0; i < rangeCount; i++ )
+		{
+			uint64_t offset{ 0 };
+
+			uint64_t size{ 0 };
+
+			if( !ReadValue( journalIn, offset ) || !ReadValue( journalIn, size ) || offset + size > fileSize )
+			{
+				return false;
+			}
+
+			data.resize( size );
+
+			if( !journalIn.read( data.data(), static_cast<std::streamsize>( size ) ) )
+			{
+				return false;
+			}
+
+			if( !fileOut.seekp( static_cast<std::streamoff>( offset ) ) || !fileOut.write( data.data(), static_cast<std::streamsize>( size ) ) )
+			{
+				return false;
+			}
+		}
+
+		if( !fileOut.flush() )
+		{
+			return false;
+		}
+	}
+
+	journalIn.close();
+
+	std::error_code error;
+
+	std::filesystem::resize_file( m_filePath, fileSize, error );
+
+	if( error )
+	{
+		return false;
+	}
+
+	if( !SyncFile( m_filePath ) )
+	{
+		return false;
+	}
+
+	std::filesystem::remove( m_journalPath, error );
+
+	if( error )
+	{
+		return false;
+	}
+
+	SyncDirectory( m_journalPath );
+
+	return true;
+}
+
+bool FileRollbackJournal::Commit()
+{
+	if( !SyncFile( m_filePath ) )
+	{
+		return false;
+	}
+
+	std::error_code error;
+
+	std::filesystem::remove( m_journalPath, error );
+
+	if( error )
+	{
+		return false;
+	}
+
+	SyncDirectory( m_journalPath );
+
+	return true;
+}
+
+}
@@ -62,8 +62,8 @@ bool GzipCompressionStream::ProcessBuffer( bool finish )
 		ret = deflate( &m_stream, flush );
 		uLong outBytes = m_stream.total_out - alreadyOut;
 		uLong inBytes = m_stream.total_in - alreadyIn;
-		m_out->append( std::string( reinterpret_cast<const char*>( outbuffer ), outBytes ) );
-		m_buffer = m_buffer.substr( inBytes );
+		m_out->append( reinterpret_cast<const char*>( outbuffer ), outBytes );
+		m_buffer.erase( 0, inBytes );
 	}
 
 	if( ret != Z_OK && ret != Z_STREAM_END )
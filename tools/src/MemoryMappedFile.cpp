@@ -0,0 +1,205 @@
+// Copyright © 2025 CCP ehf.
+
+#include "MemoryMappedFile.h"
+
+#if _WIN64
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace ResourceTools
+{
+
+MemoryMappedFile::MemoryMappedFile() :
+	m_data( nullptr ),
+	m_size( 0 ),
+	m_open( false )
+#if _WIN64
+	,
+	m_fileHandle( nullptr ),
+	m_mappingHandle( nullptr )
+#endif
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+MemoryMappedFile::MemoryMappedFile( MemoryMappedFile&& other ) noexcept :
+	MemoryMappedFile()
+{
+	MoveFrom( other );
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=( MemoryMappedFile&& other ) noexcept
+{
+	if( this != &other )
+	{
+		Close();
+
+		MoveFrom( other );
+	}
+
+	return *this;
+}
+
+void MemoryMappedFile::MoveFrom( MemoryMappedFile& other )
+{
+	m_data = other.m_data;
+	m_size = other.m_size;
+	m_open = other.m_open;
+
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_open = false;
+
+#if _WIN64
+	m_fileHandle = other.m_fileHandle;
+	m_mappingHandle = other.m_mappingHandle;
+
+	other.m_fileHandle = nullptr;
+	other.m_mappingHandle = nullptr;
+#endif
+}
+
+bool MemoryMappedFile::Open( const std::filesystem::path& path )
+{
+	Close();
+
+#if _WIN64
+	HANDLE fileHandle = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+	if( fileHandle == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if( !GetFileSizeEx( fileHandle, &fileSize ) )
+	{
+		CloseHandle( fileHandle );
+		return false;
+	}
+
+	// Zero length files cannot be mapped
+	if( fileSize.QuadPart == 0 )
+	{
+		CloseHandle( fileHandle );
+		m_open = true;
+		return true;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingW( fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	if( mappingHandle == nullptr )
+	{
+		CloseHandle( fileHandle );
+		return false;
+	}
+
+	void* view = MapViewOfFile( mappingHandle, FILE_MAP_READ, 0, 0, 0 );
+	if( view == nullptr )
+	{
+		CloseHandle( mappingHandle );
+		CloseHandle( fileHandle );
+		return false;
+	}
+
+	m_fileHandle = fileHandle;
+	m_mappingHandle = mappingHandle;
+	m_data = static_cast<const char*>( view );
+	m_size = static_cast<size_t>( fileSize.QuadPart );
+#else
+	int fileDescriptor = open( path.c_str(), O_RDONLY );
+	if( fileDescriptor < 0 )
+	{
+		return false;
+	}
+
+	struct stat fileStatus;
+	if( fstat( fileDescriptor, &fileStatus ) != 0 )
+	{
+		close( fileDescriptor );
+		return false;
+	}
+
+	// Zero length files cannot be mapped
+	if( fileStatus.st_size == 0 )
+	{
+		close( fileDescriptor );
+		m_open = true;
+		return true;
+	}
+
+	void* view = mmap( nullptr, static_cast<size_t>( fileStatus.st_size ), PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+
+	// Mapping remains valid once the descriptor is closed
+	close( fileDescriptor );
+
+	if( view == MAP_FAILED )
+	{
+		return false;
+	}
+
+	m_data = static_cast<const char*>( view );
+	m_size = static_cast<size_t>( fileStatus.st_size );
+#endif
+
+	m_open = true;
+
+	return true;
+}
+
+void MemoryMappedFile::Close()
+{
+#if _WIN64
+	if( m_data )
+	{
+		UnmapViewOfFile( m_data );
+	}
+
+	if( m_mappingHandle )
+	{
+		CloseHandle( m_mappingHandle );
+	}
+
+	if( m_fileHandle )
+	{
+		CloseHandle( m_fileHandle );
+	}
+
+	m_fileHandle = nullptr;
+	m_mappingHandle = nullptr;
+#else
+	if( m_data )
+	{
+		munmap( const_cast<char*>( m_data ), m_size );
+	}
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+	m_open = false;
+}
+
+bool MemoryMappedFile::IsOpen() const
+{
+	return m_open;
+}
+
+const char* MemoryMappedFile::GetData() const
+{
+	return m_data;
+}
+
+size_t MemoryMappedFile::GetSize() const
+{
+	return m_size;
+}
+
+}
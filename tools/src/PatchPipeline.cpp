@@ -0,0 +1,186 @@
+// Copyright © 2025 CCP ehf.
+
+#include "PatchPipeline.h"
+
+#include "Patching.h"
+
+#include <algorithm>
+
+namespace ResourceTools
+{
+
+PatchPipeline::PatchPipeline( unsigned int threadCount, size_t maximumQueued /* = 0 */ ) :
+	m_maximumQueued( maximumQueued ),
+	m_nextTask( 0 ),
+	m_inProgress( 0 ),
+	m_failed( false ),
+	m_stopping( false )
+{
+	if( threadCount == 0 )
+	{
+		threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+	}
+
+	if( m_maximumQueued == 0 )
+	{
+		m_maximumQueued = static_cast<size_t>( threadCount ) * 2;
+	}
+
+	if( threadCount > 1 )
+	{
+		for( unsigned int i = 0; i < threadCount; i++ )
+		{
+			m_workers.emplace_back( &PatchPipeline::Worker, this );
+		}
+	}
+}
+
+PatchPipeline::~PatchPipeline()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+
+		m_stopping = true;
+	}
+
+	m_condition.notify_all();
+
+	for( std::thread& worker : m_workers )
+	{
+		worker.join();
+	}
+}
+
+bool PatchPipeline::RunTask( Task& task )
+{
+	bool success = CreatePatch( task.previousData, task.nextData, task.patchData );
+
+	// Inputs are released as soon as the patch exists, only patch data is held until retrieved
+	std::string().swap( task.previousData );
+	std::string().swap( task.nextData );
+
+	if( success && task.callback )
+	{
+		success = task.callback( task.patchData );
+	}
+
+	task.callback = nullptr;
+
+	return success;
+}
+
+void PatchPipeline::Worker()
+{
+	std::unique_lock<std::mutex> lock( m_mutex );
+
+	while( true )
+	{
+		m_condition.wait( lock, [this]() { return m_stopping || m_nextTask < m_tasks.size(); } );
+
+		if( m_stopping )
+		{
+			return;
+		}
+
+		// Deque elements are not moved by push_back so the task can be used without the lock
+		Task& task = m_tasks[m_nextTask++];
+
+		m_inProgress++;
+
+		lock.unlock();
+
+		bool success = RunTask( task );
+
+		lock.lock();
+
+		m_inProgress--;
+
+		task.finished = success;
+
+		if( !success )
+		{
+			m_failed = true;
+		}
+
+		m_condition.notify_all();
+	}
+}
+
+bool PatchPipeline::Queue( std::string previousData, std::string nextData, PatchCreatedCallback callback /* = nullptr */ )
+{
+	if( m_workers.empty() )
+	{
+		if( m_failed )
+		{
+			return false;
+		}
+
+		m_tasks.push_back( Task{ std::move( previousData ), std::move( nextData ), std::move( callback ), std::string(), false } );
+
+		m_nextTask++;
+
+		Task& task = m_tasks.back();
+
+		task.finished = RunTask( task );
+
+		m_failed = !task.finished;
+
+		return task.finished;
+	}
+
+	std::unique_lock<std::mutex> lock( m_mutex );
+
+	m_condition.wait( lock, [this]() { return m_failed || ( m_tasks.size() - m_nextTask ) + m_inProgress < m_maximumQueued; } );
+
+	if( m_failed )
+	{
+		return false;
+	}
+
+	m_tasks.push_back( Task{ std::move( previousData ), std::move( nextData ), std::move( callback ), std::string(), false } );
+
+	lock.unlock();
+
+	m_condition.notify_all();
+
+	return true;
+}
+
+bool PatchPipeline::Finish()
+{
+	std::unique_lock<std::mutex> lock( m_mutex );
+
+	m_condition.wait( lock, [this]() { return m_failed || ( m_nextTask == m_tasks.size() && m_inProgress == 0 ); } );
+
+	if( m_failed )
+	{
+		// Queued tasks are abandoned, only those in progress are waited for
+		m_nextTask = m_tasks.size();
+
+		m_condition.wait( lock, [this]() { return m_inProgress == 0; } );
+
+		return false;
+	}
+
+	return true;
+}
+
+size_t PatchPipeline::GetQueuedCount() const
+{
+	return m_tasks.size();
+}
+
+bool PatchPipeline::IsPatchFinished( size_t index )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+
+	return m_tasks[index].finished;
+}
+
+void PatchPipeline::TakePatchData( size_t index, std::string& patchData )
+{
+	// Finished tasks are no longer touched by workers
+	patchData = std::move( m_tasks[index].patchData );
+}
+
+}
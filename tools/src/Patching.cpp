@@ -4,8 +4,13 @@
 
 #include <bsdiff.h>
 #include <bspatch.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
 
 #include "BundleStreamIn.h"
+#include "MemoryMappedFile.h"
 #include "ResourceTools.h"
 
 const char* BSDIFF_HEADER_STR = "ENDSLEY/BSDIFF43";
@@ -35,44 +40,158 @@ int bs_read_chunked( const struct bspatch_stream* stream, void* buffer, size_t l
 	ResourceTools::PatchData* spd = reinterpret_cast<ResourceTools::PatchData*>( stream->opaque );
 	ResourceTools::BundleStreamIn* cs = spd->m_data;
 
-	size_t remaining = length;
-	std::string out;
-	std::string data;
-	size_t chunkSize = cs->GetChunkSize();
-	while( remaining )
-	{
-		size_t toRead = std::min( remaining, chunkSize );
-		if( !cs->ReadBytes( toRead, data ) )
-		{
-			return -1;
-		}
-		out += data;
-		remaining -= toRead;
-	}
-
-	if( out.size() < length )
+	// Copied straight from the stream cache into the bspatch buffer
+	std::string_view data;
+	if( !cs->ReadView( length, data ) )
 	{
 		return -1;
 	}
-	memcpy( buffer, out.c_str(), length );
+	memcpy( buffer, data.data(), length );
 	return 0;
 }
 
+// Patch body is read in order through a view that is advanced past each read, the patch is never copied
 int bs_read( const struct bspatch_stream* stream, void* buffer, size_t length, enum bspatch_stream_type type )
 {
-	std::string* sp = reinterpret_cast<std::string*>( stream->opaque );
-	if( sp->size() < length )
+	std::string_view* cursor = reinterpret_cast<std::string_view*>( stream->opaque );
+	if( cursor->size() < length )
 	{
 		return -1;
 	}
-	memcpy( buffer, sp->c_str(), length );
-	sp->erase( 0, length );
+	memcpy( buffer, cursor->data(), length );
+	cursor->remove_prefix( length );
 	return 0;
 }
 
+// Control entries are sign and magnitude encoded little endian integers
+static int64_t ReadPatchOffset( const uint8_t* buffer )
+{
+	int64_t value = buffer[7] & 0x7F;
+	for( int i = 6; i >= 0; i-- )
+	{
+		value = value * 256 + buffer[i];
+	}
+	return ( buffer[7] & 0x80 ) ? -value : value;
+}
+
+// Same patch application as bspatch but the result is written out in pieces of bufferSize rather than built in memory
+static bool StreamPatch( std::string_view data, uint64_t targetLength, const bspatch_stream& stream, std::ostream& out, size_t bufferSize )
+{
+	std::vector<uint8_t> buffer( std::max<size_t>( bufferSize, 1 ) );
+	const uint8_t* oldData = reinterpret_cast<const uint8_t*>( data.data() );
+	int64_t oldSize = static_cast<int64_t>( data.size() );
+	int64_t oldPosition = 0;
+	uint64_t newPosition = 0;
+
+	while( newPosition < targetLength )
+	{
+		int64_t control[3];
+		for( int64_t& value : control )
+		{
+			uint8_t encoded[8];
+			if( stream.read( &stream, encoded, sizeof( encoded ), BSPATCH_CONTROL ) != 0 )
+			{
+				return false;
+			}
+			value = ReadPatchOffset( encoded );
+		}
+
+		if( control[0] < 0 || control[1] < 0 || static_cast<uint64_t>( control[0] ) + static_cast<uint64_t>( control[1] ) > targetLength - newPosition )
+		{
+			return false;
+		}
+
+		// Diff bytes are added to the old data at the same position
+		for( uint64_t remaining = control[0]; remaining > 0; )
+		{
+			size_t length = static_cast<size_t>( std::min<uint64_t>( remaining, buffer.size() ) );
+			if( stream.read( &stream, buffer.data(), length, BSPATCH_DIFF ) != 0 )
+			{
+				return false;
+			}
+			for( size_t i = 0; i < length; i++ )
+			{
+				int64_t position = oldPosition + static_cast<int64_t>( i );
+				if( position >= 0 && position < oldSize )
+				{
+					buffer[i] += oldData[position];
+				}
+			}
+			if( !out.write( reinterpret_cast<const char*>( buffer.data() ), length ) )
+			{
+				return false;
+			}
+			oldPosition += length;
+			newPosition += length;
+			remaining -= length;
+		}
+
+		// Extra bytes are new data copied as is
+		for( uint64_t remaining = control[1]; remaining > 0; )
+		{
+			size_t length = static_cast<size_t>( std::min<uint64_t>( remaining, buffer.size() ) );
+			if( stream.read( &stream, buffer.data(), length, BSPATCH_EXTRA ) != 0 )
+			{
+				return false;
+			}
+			if( !out.write( reinterpret_cast<const char*>( buffer.data() ), length ) )
+			{
+				return false;
+			}
+			newPosition += length;
+			remaining -= length;
+		}
+
+		oldPosition += control[2];
+	}
+
+	return true;
+}
+
+// Writes the patched target beside it and replaces the target only once the result is complete and synced
+static bool StreamPatchToFile( const std::filesystem::path& target, uint64_t targetLength, const bspatch_stream& stream, size_t bufferSize )
+{
+	ResourceTools::MemoryMappedFile targetFile;
+	if( !targetFile.Open( target ) )
+	{
+		return false;
+	}
+
+	std::filesystem::path temporaryPath = target;
+	temporaryPath += ".patching";
+
+	std::ofstream out( temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc );
+	bool success = out && StreamPatch( std::string_view( targetFile.GetData(), targetFile.GetSize() ), targetLength, stream, out, bufferSize );
+	out.close();
+	success = success && !out.fail() && ResourceTools::SyncFile( temporaryPath );
+
+	// Mapping must be released before the target can be replaced on Windows
+	targetFile.Close();
+
+	std::error_code ec;
+	if( success )
+	{
+		std::filesystem::rename( temporaryPath, target, ec );
+		success = !ec;
+	}
+
+	if( !success )
+	{
+		std::filesystem::remove( temporaryPath, ec );
+		return false;
+	}
+
+#if !_WIN64
+	// Makes the rename itself durable
+	ResourceTools::SyncFile( target.has_parent_path() ? target.parent_path() : std::filesystem::path( "." ) );
+#endif
+
+	return true;
+}
+
 namespace ResourceTools
 {
-bool ApplyPatch( const std::string& data, const std::string& patchData, std::string& out )
+bool ApplyPatch( std::string_view data, std::string_view patchData, std::string& out )
 {
 	if( patchData.size() < BSDIFF_HEADER_SIZE )
 	{
@@ -83,14 +202,15 @@ bool ApplyPatch( const std::string& data, const std::string& patchData, std::str
 		return false;
 	}
 	bspatch_stream stream;
-	uint64_t targetLength = *reinterpret_cast<uint64_t*>( const_cast<char*>( patchData.c_str() + BSDIFF_HEADER_TEXT_SIZE ) );
+	uint64_t targetLength;
+	memcpy( &targetLength, patchData.data() + BSDIFF_HEADER_TEXT_SIZE, sizeof( targetLength ) );
 	out.resize( targetLength );
 
-	auto readString = std::string( patchData.c_str() + BSDIFF_HEADER_SIZE, patchData.size() - BSDIFF_HEADER_SIZE );
-	stream.opaque = &readString;
+	std::string_view cursor = patchData.substr( BSDIFF_HEADER_SIZE );
+	stream.opaque = &cursor;
 	stream.read = bs_read;
 
-	int result = bspatch( reinterpret_cast<const uint8_t*>( data.c_str() ), data.size(), reinterpret_cast<uint8_t*>( const_cast<char*>( out.c_str() ) ), targetLength, &stream );
+	int result = bspatch( reinterpret_cast<const uint8_t*>( data.data() ), data.size(), reinterpret_cast<uint8_t*>( out.data() ), targetLength, &stream );
 	if( result != 0 )
 	{
 		return false;
@@ -133,6 +253,13 @@ bool ApplyPatchChunked( const std::string& data, ResourceTools::BundleStreamIn&
 
 bool CreatePatch( const std::string& previousData, const std::string& latestData, std::string& patchData )
 {
+	// Header is written first and bsdiff appends the body, so the patch is not copied to prepend it
+	char sizeEncodedInHeader[BSDIFF_SIZE_ENCODING_SIZE];
+	uint64_t size = latestData.size();
+	memcpy( sizeEncodedInHeader, &size, sizeof size );
+	patchData.assign( BSDIFF_HEADER_STR, BSDIFF_HEADER_TEXT_SIZE );
+	patchData.append( sizeEncodedInHeader, BSDIFF_SIZE_ENCODING_SIZE );
+
 	bsdiff_stream stream;
 	stream.opaque = &patchData;
 	stream.malloc = bs_alloc;
@@ -143,10 +270,6 @@ bool CreatePatch( const std::string& previousData, const std::string& latestData
 	{
 		return false;
 	}
-	char sizeEncodedInHeader[8];
-	uint64_t size = latestData.size();
-	memcpy( sizeEncodedInHeader, &size, sizeof size );
-	patchData = std::string( BSDIFF_HEADER_STR, 16 ) + std::string( sizeEncodedInHeader, 8 ) + patchData;
 
 	return true;
 }
@@ -195,6 +318,47 @@ bool ApplyPatchFileChunked( std::filesystem::path target, BundleStreamIn& patch
 	return true;
 }
 
+bool ApplyPatchFileStreamed( std::filesystem::path target, std::filesystem::path patch, size_t outputBufferSize /* = DEFAULT_PATCH_OUTPUT_BUFFER_SIZE */ )
+{
+	MemoryMappedFile patchFile;
+	if( !patchFile.Open( patch ) )
+	{
+		return false;
+	}
+	std::string_view patchData( patchFile.GetData(), patchFile.GetSize() );
+	if( patchData.size() < BSDIFF_HEADER_SIZE || memcmp( patchData.data(), BSDIFF_HEADER_STR, BSDIFF_HEADER_TEXT_SIZE ) != 0 )
+	{
+		return false;
+	}
+	uint64_t targetLength;
+	memcpy( &targetLength, patchData.data() + BSDIFF_HEADER_TEXT_SIZE, sizeof( targetLength ) );
+
+	bspatch_stream stream;
+	std::string_view cursor = patchData.substr( BSDIFF_HEADER_SIZE );
+	stream.opaque = &cursor;
+	stream.read = bs_read;
+
+	return StreamPatchToFile( target, targetLength, stream, outputBufferSize );
+}
+
+bool ApplyPatchFileChunkedStreamed( std::filesystem::path target, BundleStreamIn& patch, size_t outputBufferSize /* = DEFAULT_PATCH_OUTPUT_BUFFER_SIZE */ )
+{
+	std::string_view header;
+	if( !patch.ReadView( BSDIFF_HEADER_SIZE, header ) || memcmp( header.data(), BSDIFF_HEADER_STR, BSDIFF_HEADER_TEXT_SIZE ) != 0 )
+	{
+		return false;
+	}
+	uint64_t targetLength;
+	memcpy( &targetLength, header.data() + BSDIFF_HEADER_TEXT_SIZE, sizeof( targetLength ) );
+
+	// Output is not held in memory so the buffer fields are unused
+	PatchData spd( &patch, nullptr, targetLength );
+	bspatch_stream stream;
+	stream.opaque = &spd;
+	stream.read = bs_read_chunked;
+
+	return StreamPatchToFile( target, targetLength, stream, outputBufferSize );
+}
 
 bool CreatePatchFile( std::filesystem::path before, std::filesystem::path after, std::filesystem::path patch )
 {
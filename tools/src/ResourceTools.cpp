@@ -8,13 +8,19 @@
 #if __APPLE__
 #include <sys/stat.h> // for lstat
 #endif
+#if WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include <filesystem>
 #include <fstream>
 
 #include <curl/curl.h>
 #include <zlib.h>
 
-#include "Md5ChecksumStream.h"
+#include "ChecksumStream.h"
 #include "FileDataStreamIn.h"
 #include "FileDataStreamOut.h"
 #include "RollingChecksum.h"
@@ -25,7 +31,27 @@ namespace ResourceTools
 
 bool GenerateMd5Checksum( const std::filesystem::path& path, std::string& checksum )
 {
-	ResourceTools::Md5ChecksumStream md5Stream;
+	return GenerateChecksum( path, ChecksumAlgorithm::MD5, checksum );
+}
+
+bool Md5ChecksumMatches( const std::filesystem::path& path, std::string& checksum )
+{
+	return ChecksumMatches( path, ChecksumAlgorithm::MD5, checksum );
+}
+
+bool GenerateMd5Checksum( const std::string& data, std::string& checksum )
+{
+	return GenerateChecksum( std::string_view( data ), ChecksumAlgorithm::MD5, checksum );
+}
+
+bool GenerateMd5Checksum( std::string_view data, std::string& checksum )
+{
+	return GenerateChecksum( data, ChecksumAlgorithm::MD5, checksum );
+}
+
+bool GenerateChecksum( const std::filesystem::path& path, ChecksumAlgorithm algorithm, Digest128& checksum )
+{
+	ResourceTools::ChecksumStream checksumStream( algorithm );
 	ResourceTools::FileDataStreamIn fileDataIn;
 	if( !fileDataIn.StartRead( path ) )
 	{
@@ -34,39 +60,74 @@ bool GenerateMd5Checksum( const std::filesystem::path& path, std::string& checks
 	std::string temp;
 	while( fileDataIn >> temp )
 	{
-		md5Stream << temp;
+		checksumStream << temp;
 	}
-	md5Stream.FinishAndRetrieve( checksum );
-	return true;
+	return checksumStream.FinishAndRetrieve( checksum );
 }
 
-bool Md5ChecksumMatches( const std::filesystem::path& path, std::string& checksum )
+bool GenerateChecksum( const std::filesystem::path& path, ChecksumAlgorithm algorithm, std::string& checksum )
 {
-	std::string otherChecksum;
-	if( !GenerateMd5Checksum( path, otherChecksum ) )
+	Digest128 digest;
+
+	if( !GenerateChecksum( path, algorithm, digest ) )
 	{
 		return false;
 	}
-	return otherChecksum == checksum;
+
+	checksum = digest.ToHexString();
+
+	return true;
 }
 
-bool GenerateMd5Checksum( const std::string& data, std::string& checksum )
+bool GenerateChecksum( const std::string& data, ChecksumAlgorithm algorithm, Digest128& checksum )
+{
+	return GenerateChecksum( std::string_view( data ), algorithm, checksum );
+}
+
+bool GenerateChecksum( std::string_view data, ChecksumAlgorithm algorithm, Digest128& checksum )
 {
-	Md5ChecksumStream md5ChecksumStream;
+	ChecksumStream checksumStream( algorithm );
 
-	md5ChecksumStream << data;
+	checksumStream << data;
 
-	if( md5ChecksumStream.FinishAndRetrieve( checksum ) )
+	return checksumStream.FinishAndRetrieve( checksum );
+}
+
+bool GenerateChecksum( const std::string& data, ChecksumAlgorithm algorithm, std::string& checksum )
+{
+	return GenerateChecksum( std::string_view( data ), algorithm, checksum );
+}
+
+bool GenerateChecksum( std::string_view data, ChecksumAlgorithm algorithm, std::string& checksum )
+{
+	ChecksumStream checksumStream( algorithm );
+
+	checksumStream << data;
+
+	return checksumStream.FinishAndRetrieve( checksum );
+}
+
+bool ChecksumMatches( const std::filesystem::path& path, ChecksumAlgorithm algorithm, const Digest128& checksum )
+{
+	Digest128 otherChecksum;
+	if( !GenerateChecksum( path, algorithm, otherChecksum ) )
 	{
-		return true;
+		return false;
 	}
-	else
+	return otherChecksum == checksum;
+}
+
+bool ChecksumMatches( const std::filesystem::path& path, ChecksumAlgorithm algorithm, const std::string& checksum )
+{
+	Digest128 expectedChecksum;
+	if( !expectedChecksum.FromHexString( checksum ) )
 	{
 		return false;
 	}
+	return ChecksumMatches( path, algorithm, expectedChecksum );
 }
 
-bool GenerateFowlerNollVoChecksum( const std::string& input, std::string& checksum )
+bool GenerateFowlerNollVoChecksum( std::string_view input, std::string& checksum )
 {
 	unsigned long long offset_bias = 14695981039346656037U;
 
@@ -198,7 +259,7 @@ std::list<ChunkMatch> FindMatchingChunks( const std::string& source, std::string
 	return result;
 }
 
-bool FindMatchingChunk( const std::string& chunk, std::filesystem::path filePath, size_t& chunkOffset )
+bool FindMatchingChunk( std::string_view chunk, std::filesystem::path filePath, size_t& chunkOffset )
 {
 	if( chunk.size() > std::numeric_limits<uint32_t>::max() )
 	{
@@ -210,34 +271,27 @@ bool FindMatchingChunk( const std::string& chunk, std::filesystem::path filePath
 	std::string backlog;
 	std::string fileData;
 	RollingChecksum chunkChecksum = GenerateRollingAdlerChecksum( chunk, 0, chunkSize );
-	RollingChecksum lastChecksum;
+	std::vector<uint32_t> checksums;
 	uint64_t fileOffset{ 0 };
 	uint32_t backlogOffset{ 0 };
 	while( stream >> fileData )
 	{
 		backlog += fileData;
-		while( backlogOffset + chunkSize <= backlog.size() )
+		GenerateRollingAdlerChecksums( backlog, backlogOffset, static_cast<uint32_t>( backlog.size() ), chunkSize, checksums );
+		for( uint32_t checksum : checksums )
 		{
-			if( backlogOffset == 0 )
-			{
-				lastChecksum = GenerateRollingAdlerChecksum( backlog, 0, chunkSize );
-			}
-			else
-			{
-				lastChecksum = GenerateRollingAdlerChecksum( backlog, backlogOffset, backlogOffset + chunkSize, lastChecksum );
-			}
-			if( lastChecksum.checksum == chunkChecksum.checksum )
+			if( checksum == chunkChecksum.checksum )
 			{
 				// We have a potential match. Time to verify
-				std::string sourceMD5;
-				if( !ResourceTools::GenerateMd5Checksum( chunk, sourceMD5 ) )
+				Digest128 sourceMD5;
+				if( !ResourceTools::GenerateChecksum( chunk, ChecksumAlgorithm::MD5, sourceMD5 ) )
 				{
 					++backlogOffset;
 					continue;
 				}
-				std::string matchingChunkMD5;
-				std::string matchStr = backlog.substr( backlogOffset, chunkSize );
-				if( !ResourceTools::GenerateMd5Checksum( matchStr, matchingChunkMD5 ) )
+				Digest128 matchingChunkMD5;
+				std::string_view matchStr = std::string_view( backlog ).substr( backlogOffset, chunkSize );
+				if( !ResourceTools::GenerateChecksum( matchStr, ChecksumAlgorithm::MD5, matchingChunkMD5 ) )
 				{
 					++backlogOffset;
 					continue;
@@ -252,12 +306,12 @@ bool FindMatchingChunk( const std::string& chunk, std::filesystem::path filePath
 			++backlogOffset;
 		}
 
-		// Shrink fileData every now and then, but beware, we need to access start-1 for the rolling checksum.
+		// Shrink fileData every now and then, windows before backlogOffset have already been checked.
 		if( backlogOffset > chunkSize + 1 )
 		{
 			backlogOffset -= chunkSize;
 			fileOffset += chunkSize;
-			backlog = backlog.substr( chunkSize );
+			backlog.erase( 0, chunkSize );
 		}
 	}
 	return false;
@@ -283,8 +337,8 @@ size_t CountMatchingChunks( const std::filesystem::path& fileA, size_t offsetA,
 	std::string chunkA;
 	std::string chunkB;
 
-	std::string checksumA;
-	std::string checksumB;
+	Digest128 checksumA;
+	Digest128 checksumB;
 
 	while( true )
 	{
@@ -292,11 +346,11 @@ size_t CountMatchingChunks( const std::filesystem::path& fileA, size_t offsetA,
 		{
 			return result;
 		}
-		if( !ResourceTools::GenerateMd5Checksum( chunkA, checksumA ) )
+		if( !ResourceTools::GenerateChecksum( chunkA, ChecksumAlgorithm::MD5, checksumA ) )
 		{
 			return result;
 		}
-		if( !ResourceTools::GenerateMd5Checksum( chunkB, checksumB ) )
+		if( !ResourceTools::GenerateChecksum( chunkB, ChecksumAlgorithm::MD5, checksumB ) )
 		{
 			return result;
 		}
@@ -425,6 +479,41 @@ bool SaveFile( const std::filesystem::path& path, const std::string& data )
 	}
 }
 
+#if WIN32
+bool SyncFile( const std::filesystem::path& path )
+{
+	HANDLE hFile = CreateFileW( path.wstring().c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+	if( hFile == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+
+	bool result = FlushFileBuffers( hFile );
+	CloseHandle( hFile );
+	return result;
+}
+#else
+bool SyncFile( const std::filesystem::path& path )
+{
+	int fileDescriptor = open( path.c_str(), O_RDONLY );
+
+	if( fileDescriptor < 0 )
+	{
+		return false;
+	}
+
+#if __APPLE__
+	// fsync only reaches the drive cache on macOS, fall back to it where a full flush is not supported
+	bool result = fcntl( fileDescriptor, F_FULLFSYNC ) == 0 || fsync( fileDescriptor ) == 0;
+#else
+	bool result = fsync( fileDescriptor ) == 0;
+#endif
+	close( fileDescriptor );
+	return result;
+}
+#endif
+
 #if __APPLE__
 unsigned int CalculateBinaryOperation( const std::filesystem::path& path )
 {
@@ -499,4 +588,63 @@ unsigned int CalculateBinaryOperation( const std::filesystem::path& path )
 }
 #endif
 
+#if __APPLE__
+bool GetFileId( const std::filesystem::path& path, uint64_t& fileId )
+{
+	struct stat s;
+	int err = stat( path.c_str(), &s );
+	if( err )
+	{
+		return false;
+	}
+	fileId = static_cast<uint64_t>( s.st_ino );
+	return true;
+}
+#elif WIN32
+bool GetFileId( const std::filesystem::path& path, uint64_t& fileId )
+{
+	BY_HANDLE_FILE_INFORMATION fileInfo;
+	HANDLE hFile = CreateFileW( path.wstring().c_str(), FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr );
+
+	if( hFile == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+
+	bool result = GetFileInformationByHandle( hFile, &fileInfo );
+	CloseHandle( hFile );
+
+	if( !result )
+	{
+		return false;
+	}
+
+	fileId = ( static_cast<uint64_t>( fileInfo.nFileIndexHigh ) << 32 ) | fileInfo.nFileIndexLow;
+	return true;
+}
+#endif
+
+bool GetFileFingerprint( const std::filesystem::path& path, FileFingerprint& fingerprint )
+{
+	std::error_code ec;
+
+	fingerprint.size = std::filesystem::file_size( path, ec );
+
+	if( ec )
+	{
+		return false;
+	}
+
+	std::filesystem::file_time_type modificationTime = std::filesystem::last_write_time( path, ec );
+
+	if( ec )
+	{
+		return false;
+	}
+
+	fingerprint.modificationTime = static_cast<int64_t>( modificationTime.time_since_epoch().count() );
+
+	return GetFileId( path, fingerprint.fileId );
+}
+
 }
\ No newline at end of file
@@ -2,25 +2,238 @@
 
 #include "RollingChecksum.h"
 
+#include <type_traits>
+
+#if defined( _M_X64 ) || defined( __x86_64__ )
+#define ROLLING_CHECKSUM_X86 1
+#include <immintrin.h>
+#if defined( _MSC_VER )
+#include <intrin.h>
+#define ROLLING_CHECKSUM_TARGET( name )
+#else
+#define ROLLING_CHECKSUM_TARGET( name ) __attribute__( ( target( name ) ) )
+#endif
+#endif
+
 constexpr uint32_t ROLLING_CHECKSUM_MODULO{ 2 << 15 };
 
 namespace ResourceTools
 {
-RollingChecksum GenerateRollingAdlerChecksum( const std::string& input, uint32_t start, uint32_t end )
+
+// Sums a window of data where alpha is the sum of all bytes and beta is the sum of each byte
+// weighted by its distance from the end of the window.
+// Sums are left unreduced, all arithmetic is modulo 2^32 which is a multiple of ROLLING_CHECKSUM_MODULO
+// so reducing afterwards gives the same result as the original per byte implementation.
+// Bytes are interpreted as char, matching the original implementation.
+using WindowSumFunction = void ( * )( const char* data, uint32_t size, uint32_t& alpha, uint32_t& beta );
+
+static void SumWindowScalar( const char* data, uint32_t size, uint32_t& alpha, uint32_t& beta )
 {
-	uint32_t alpha = 0;
-	auto substring = input.substr( start, end - start );
-	for( auto c : substring )
+	// Equivalent to beta += alpha after each byte, kept as independent sums so the loops have no serial dependency
+	// Accumulated locally as data may alias alpha and beta
+	uint32_t dataAlpha = 0;
+	uint32_t dataBeta = 0;
+
+	for( uint32_t i = 0; i < size; ++i )
 	{
-		alpha += c;
+		dataAlpha += data[i];
 	}
-	alpha %= ROLLING_CHECKSUM_MODULO;
 
-	uint32_t beta = 0;
-	for( uint32_t i = start; i < end; ++i )
+	for( uint32_t i = 0; i < size; ++i )
+	{
+		dataBeta += ( size - i ) * data[i];
+	}
+
+	beta += alpha * size + dataBeta;
+	alpha += dataAlpha;
+}
+
+#if ROLLING_CHECKSUM_X86
+
+// Blocks are processed as 16 bit lanes with weights counting down to 1 at the end of the block
+// beta gains the block weighted sum plus the block size multiplied by alpha prior to the block
+// alpha prior to each block is accumulated per lane and multiplied out at the end
+
+ROLLING_CHECKSUM_TARGET( "sse4.1" )
+static void SumWindowSse41( const char* data, uint32_t size, uint32_t& alpha, uint32_t& beta )
+{
+	constexpr uint32_t BLOCK_SIZE = 16;
+
+	const __m128i ones = _mm_set1_epi16( 1 );
+	const __m128i weightsLow = _mm_setr_epi16( 16, 15, 14, 13, 12, 11, 10, 9 );
+	const __m128i weightsHigh = _mm_setr_epi16( 8, 7, 6, 5, 4, 3, 2, 1 );
+
+	__m128i alphaLanes = _mm_setzero_si128();
+	__m128i previousAlphaLanes = _mm_setzero_si128();
+	__m128i betaLanes = _mm_setzero_si128();
+
+	uint32_t blocks = size / BLOCK_SIZE;
+
+	for( uint32_t block = 0; block < blocks; ++block )
+	{
+		__m128i bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + block * BLOCK_SIZE ) );
+
+		__m128i low = _mm_cvtepi8_epi16( bytes );
+		__m128i high = _mm_cvtepi8_epi16( _mm_srli_si128( bytes, 8 ) );
+
+		previousAlphaLanes = _mm_add_epi32( previousAlphaLanes, alphaLanes );
+
+		alphaLanes = _mm_add_epi32( alphaLanes, _mm_add_epi32( _mm_madd_epi16( low, ones ), _mm_madd_epi16( high, ones ) ) );
+
+		betaLanes = _mm_add_epi32( betaLanes, _mm_add_epi32( _mm_madd_epi16( low, weightsLow ), _mm_madd_epi16( high, weightsHigh ) ) );
+	}
+
+	uint32_t alphaValues[4];
+	uint32_t previousAlphaValues[4];
+	uint32_t betaValues[4];
+
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( alphaValues ), alphaLanes );
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( previousAlphaValues ), previousAlphaLanes );
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( betaValues ), betaLanes );
+
+	uint32_t blockAlpha = 0;
+	uint32_t blockPreviousAlpha = 0;
+	uint32_t blockBeta = 0;
+
+	for( int lane = 0; lane < 4; ++lane )
+	{
+		blockAlpha += alphaValues[lane];
+		blockPreviousAlpha += previousAlphaValues[lane];
+		blockBeta += betaValues[lane];
+	}
+
+	// Incoming state is carried through the blocks in the same way as a single byte
+	beta += alpha * blocks * BLOCK_SIZE + blockPreviousAlpha * BLOCK_SIZE + blockBeta;
+	alpha += blockAlpha;
+
+	SumWindowScalar( data + blocks * BLOCK_SIZE, size - blocks * BLOCK_SIZE, alpha, beta );
+}
+
+ROLLING_CHECKSUM_TARGET( "avx2" )
+static void SumWindowAvx2( const char* data, uint32_t size, uint32_t& alpha, uint32_t& beta )
+{
+	constexpr uint32_t BLOCK_SIZE = 32;
+
+	const __m256i ones = _mm256_set1_epi16( 1 );
+	const __m256i weightsLow = _mm256_setr_epi16( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	const __m256i weightsHigh = _mm256_setr_epi16( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+
+	__m256i alphaLanes = _mm256_setzero_si256();
+	__m256i previousAlphaLanes = _mm256_setzero_si256();
+	__m256i betaLanes = _mm256_setzero_si256();
+
+	uint32_t blocks = size / BLOCK_SIZE;
+
+	for( uint32_t block = 0; block < blocks; ++block )
+	{
+		const char* blockData = data + block * BLOCK_SIZE;
+
+		__m256i low = _mm256_cvtepi8_epi16( _mm_loadu_si128( reinterpret_cast<const __m128i*>( blockData ) ) );
+		__m256i high = _mm256_cvtepi8_epi16( _mm_loadu_si128( reinterpret_cast<const __m128i*>( blockData + 16 ) ) );
+
+		previousAlphaLanes = _mm256_add_epi32( previousAlphaLanes, alphaLanes );
+
+		alphaLanes = _mm256_add_epi32( alphaLanes, _mm256_add_epi32( _mm256_madd_epi16( low, ones ), _mm256_madd_epi16( high, ones ) ) );
+
+		betaLanes = _mm256_add_epi32( betaLanes, _mm256_add_epi32( _mm256_madd_epi16( low, weightsLow ), _mm256_madd_epi16( high, weightsHigh ) ) );
+	}
+
+	uint32_t alphaValues[8];
+	uint32_t previousAlphaValues[8];
+	uint32_t betaValues[8];
+
+	_mm256_storeu_si256( reinterpret_cast<__m256i*>( alphaValues ), alphaLanes );
+	_mm256_storeu_si256( reinterpret_cast<__m256i*>( previousAlphaValues ), previousAlphaLanes );
+	_mm256_storeu_si256( reinterpret_cast<__m256i*>( betaValues ), betaLanes );
+
+	uint32_t blockAlpha = 0;
+	uint32_t blockPreviousAlpha = 0;
+	uint32_t blockBeta = 0;
+
+	for( int lane = 0; lane < 8; ++lane )
+	{
+		blockAlpha += alphaValues[lane];
+		blockPreviousAlpha += previousAlphaValues[lane];
+		blockBeta += betaValues[lane];
+	}
+
+	beta += alpha * blocks * BLOCK_SIZE + blockPreviousAlpha * BLOCK_SIZE + blockBeta;
+	alpha += blockAlpha;
+
+	SumWindowScalar( data + blocks * BLOCK_SIZE, size - blocks * BLOCK_SIZE, alpha, beta );
+}
+
+static bool CpuSupportsAvx2()
+{
+#if defined( _MSC_VER )
+	int info[4];
+	__cpuid( info, 0 );
+	if( info[0] < 7 )
+	{
+		return false;
+	}
+	__cpuid( info, 1 );
+	bool osxsave = ( info[2] & ( 1 << 27 ) ) != 0;
+	bool avx = ( info[2] & ( 1 << 28 ) ) != 0;
+	if( !osxsave || !avx || ( _xgetbv( 0 ) & 0x6 ) != 0x6 )
+	{
+		return false;
+	}
+	__cpuidex( info, 7, 0 );
+	return ( info[1] & ( 1 << 5 ) ) != 0;
+#else
+	return __builtin_cpu_supports( "avx2" );
+#endif
+}
+
+static bool CpuSupportsSse41()
+{
+#if defined( _MSC_VER )
+	int info[4];
+	__cpuid( info, 1 );
+	return ( info[2] & ( 1 << 19 ) ) != 0;
+#else
+	return __builtin_cpu_supports( "sse4.1" );
+#endif
+}
+
+#endif
+
+static WindowSumFunction SelectWindowSumFunction()
+{
+#if ROLLING_CHECKSUM_X86
+	// Vector kernels sign extend bytes so are only equivalent when char is signed
+	if constexpr( std::is_signed_v<char> )
 	{
-		beta += ( end - i ) * substring[i - start];
+		if( CpuSupportsAvx2() )
+		{
+			return SumWindowAvx2;
+		}
+
+		if( CpuSupportsSse41() )
+		{
+			return SumWindowSse41;
+		}
 	}
+#endif
+	return SumWindowScalar;
+}
+
+static void SumWindow( const char* data, uint32_t size, uint32_t& alpha, uint32_t& beta )
+{
+	static const WindowSumFunction windowSumFunction = SelectWindowSumFunction();
+
+	windowSumFunction( data, size, alpha, beta );
+}
+
+RollingChecksum GenerateRollingAdlerChecksum( std::string_view input, uint32_t start, uint32_t end )
+{
+	uint32_t alpha = 0;
+	uint32_t beta = 0;
+
+	SumWindow( input.data() + start, end - start, alpha, beta );
+
+	alpha %= ROLLING_CHECKSUM_MODULO;
 	beta %= ROLLING_CHECKSUM_MODULO;
 
 	RollingChecksum rc;
@@ -31,7 +244,7 @@ RollingChecksum GenerateRollingAdlerChecksum( const std::string& input, uint32_t
 	return rc;
 }
 
-RollingChecksum GenerateRollingAdlerChecksum( const std::string& input, uint32_t start, uint32_t end, RollingChecksum previous )
+RollingChecksum GenerateRollingAdlerChecksum( std::string_view input, uint32_t start, uint32_t end, RollingChecksum previous )
 {
 	uint32_t alpha = previous.alpha - input[start - 1] + input[end - 1];
 	alpha %= ROLLING_CHECKSUM_MODULO;
@@ -47,5 +260,44 @@ RollingChecksum GenerateRollingAdlerChecksum( const std::string& input, uint32_t
 	return rc;
 }
 
+RollingChecksum GenerateRollingAdlerChecksums( std::string_view input, uint32_t start, uint32_t end, uint32_t windowSize, std::vector<uint32_t>& checksums )
+{
+	checksums.clear();
+
+	if( windowSize == 0 || end > input.size() || start > end || end - start < windowSize )
+	{
+		return RollingChecksum{ 0, 0, 0 };
+	}
+
+	RollingChecksum rc = GenerateRollingAdlerChecksum( input, start, start + windowSize );
+
+	uint32_t windowCount = end - start - windowSize + 1;
+
+	checksums.resize( windowCount );
+
+	checksums[0] = rc.checksum;
+
+	// Same arithmetic as the rolling function above without the per call overhead
+	const char* outgoing = input.data() + start;
+	const char* incoming = outgoing + windowSize;
 
-}
\ No newline at end of file
+	uint32_t alpha = rc.alpha;
+	uint32_t beta = rc.beta;
+
+	for( uint32_t i = 1; i < windowCount; ++i )
+	{
+		alpha = ( alpha - outgoing[i - 1] + incoming[i - 1] ) % ROLLING_CHECKSUM_MODULO;
+
+		beta = ( beta + alpha - windowSize * outgoing[i - 1] ) % ROLLING_CHECKSUM_MODULO;
+
+		checksums[i] = alpha + ( beta * ROLLING_CHECKSUM_MODULO );
+	}
+
+	rc.alpha = alpha;
+	rc.beta = beta;
+	rc.checksum = checksums[windowCount - 1];
+
+	return rc;
+}
+
+}